@@ -1,13 +1,13 @@
-/*//////////////////////////////////////////////////////////////////////////////
-
- File:         6R4V3 D1663R.h
-
- Description:   The header file for the most badass robot out there.
-
- Author:        OCdt Greaves
- Skeleton from Capt Lesauvage
-
- Created:       04 Apr 2009
- */ //////////////////////////////////////////////////////////////////////////////
-void GraveDiggerActions(int timePassed);
-void GraveDiggerSkillz(void);
+/*//////////////////////////////////////////////////////////////////////////////
+
+ File:         6R4V3 D1663R.h
+
+ Description:   The header file for the most badass robot out there.
+
+ Author:        OCdt Greaves
+ Skeleton from Capt Lesauvage
+
+ Created:       04 Apr 2009
+ */ //////////////////////////////////////////////////////////////////////////////
+void GraveDiggerActions(int timePassed);
+void GraveDiggerSkillz(void);
@@ -1,13 +1,13 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: JR.h
-//
-// Description: Header for JR.c
-//
-// Author: OCdt Kuzmich and OCdt Best
-//
-// Revision History: 5 Apr 2009 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-void JRActions(int timePassed);
-void KitOut(void);
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: JR.h
+//
+// Description: Header for JR.c
+//
+// Author: OCdt Kuzmich and OCdt Best
+//
+// Revision History: 5 Apr 2009 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+void JRActions(int timePassed);
+void KitOut(void);
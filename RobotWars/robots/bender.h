@@ -1,13 +1,13 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: bender.h
-//
-// Description: The example header for the Bender robot.
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 6 Mar 2006 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-void BenderActions(int timePassed);
-void PimpOutBender(void);
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: bender.h
+//
+// Description: The example header for the Bender robot.
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 6 Mar 2006 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+void BenderActions(int timePassed);
+void PimpOutBender(void);
@@ -1,13 +1,13 @@
-///////////////////////////////////////////////
-//
-//  FileName:       <name>
-//
-//  Version:        <ver #>
-//
-//  Author:         pyrometal
-//
-//  Description:    <describe>
-//
-///////////////////////////////////////////////
-void capsule1337_AI(int timePassed);
-void capsule1337_SETUP(void);
+///////////////////////////////////////////////
+//
+//  FileName:       <name>
+//
+//  Version:        <ver #>
+//
+//  Author:         pyrometal
+//
+//  Description:    <describe>
+//
+///////////////////////////////////////////////
+void capsule1337_AI(int timePassed);
+void capsule1337_SETUP(void);
@@ -1,13 +1,13 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: maximilian.h
-//
-// Description: The example header for Maximilian.
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 11 Mar 2006 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-void MaxWillCrushYou(int timePassed);
-void EquipMax(void);
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: maximilian.h
+//
+// Description: The example header for Maximilian.
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 11 Mar 2006 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+void MaxWillCrushYou(int timePassed);
+void EquipMax(void);
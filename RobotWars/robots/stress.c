@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: stress.c
+//
+// Description: The stress robots.  These don't try to win; each one works a
+//              different part of the engine as hard as its intensity allows,
+//              through the same robot API as any other robot, so matches
+//              between them are loads for the benchmarks:
+//
+//                  Stress Laser  Charges lasers flat out and fires one at a
+//                                random heading every order it has the
+//                                energy, filling the arena with weapons
+//                                (MoveWeapons(), CheckWeaponCollisions()).
+//                  Stress Spin   Spins on the spot with four radars covering
+//                                every direction, always on and read every
+//                                order (DrawSensorBitmaps(),
+//                                UpdateSensorData()).
+//                  Stress Ram    Turbo boosts at anything its radar sees and
+//                                turns to look for more otherwise
+//                                (CheckRobotCollisions(), ApplyDamage()).
+//                  Stress Mail   Sends messages to every stress robot, itself
+//                                included, and reads all of its own (the
+//                                orders and mailboxes).  The mailboxes of
+//                                robots that don't read them keep growing.
+//
+//              The intensity of each kind is a percentage (100 unless set
+//              with SetStressIntensity()): the chance of firing or boosting
+//              each order, the speed of the spin, the share of
+//              MAX_STRESS_MESSAGES sent.  Every robot of a kind has the same
+//              intensity.  The robots keep no statics, so they can be saved
+//              and restored with the match, and use GetRandomNumber() so
+//              matches play back the same.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "..\src\competition.h"
+#include "stress.h"
+
+//Robot API functions that aren't in competition.h.
+int SendMessage(char *robotName, INT_32 data);
+int GetMessage(INT_32 *data);
+
+#define MAX_STRESS_MESSAGES  200   //Sent an order at full intensity.  It
+                                   //stays inside SANDBOX_MESSAGES.
+#define RAM_RADAR            0     //Stress Ram's ports.
+#define RAM_RANGE            1
+#define RAM_SEARCH_SPEED     40    //Tread speed while turning to look.
+
+static int intensity[NUM_STRESS_ROBOTS] = { 100, 100, 100, 100 };
+static char *stressNames[NUM_STRESS_ROBOTS] = { "Stress Laser", "Stress Spin",
+		"Stress Ram", "Stress Mail" };
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Function: SetStressIntensity
+//
+//  Description: This function sets how hard a kind of stress robot works.
+//               Call it before the match starts.
+//
+//  Parameters: STRESS_ROBOT robot - The kind of robot.
+//              int percent - The intensity, from 0 to 100.
+//
+//  Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetStressIntensity(STRESS_ROBOT robot, int percent) {
+	if (percent < 0)
+		percent = 0;
+	else if (percent > 100)
+		percent = 100;
+	intensity[robot] = percent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Function: StressLaserActions / EquipStressLaser
+//
+//  Description: Stress Laser's orders and configuration.  It has no sensors
+//               and puts everything into its lasers.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StressLaserActions(int timePassed) {
+	SYSTEM prios[NUM_ENERGY_SYSTEMS] = { SYSTEM_LASERS, SYSTEM_SHIELDS,
+			SYSTEM_MISSILES, SYSTEM_SENSORS };
+
+	SetSystemChargePriorites(prios);
+	SetSystemChargeRate(SYSTEM_LASERS, MAX_LASER_CHARGE_RATE);
+	SetMotorSpeeds(20, 25);                      //A slow circle.
+	if (GetSystemEnergy(SYSTEM_LASERS) >= MIN_LASER_ENERGY     //Firing early
+			&& GetRandomNumber(100) < intensity[STRESS_LASER])  //wastes it.
+		FireWeapon(WEAPON_LASER, (int) GetRandomNumber(360));
+}
+
+void EquipStressLaser(void) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Function: StressSpinActions / EquipStressSpin
+//
+//  Description: Stress Spin's orders and configuration.  Its radars are as
+//               wide and long as they can be, centred on each quarter.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StressSpinActions(int timePassed) {
+	int port, speed = intensity[STRESS_SPIN];
+
+	SetSystemChargeRate(SYSTEM_SHIELDS, MAX_SHIELD_CHARGE_RATE);
+	SetMotorSpeeds(speed, -speed);
+	for (port = 0; port < MAX_SENSORS; port++) {
+		SetSensorStatus(port, 1);
+		GetSensorData(port);
+	}
+}
+
+void EquipStressSpin(void) {
+	int port;
+
+	for (port = 0; port < MAX_SENSORS; port++)
+		AddSensor(port, SENSOR_RADAR, port * 360 / MAX_SENSORS
+				- MAX_RADAR_ARC / 2, MAX_RADAR_ARC, RADAR_MAX_RANGE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Function: StressRamActions / EquipStressRam
+//
+//  Description: Stress Ram's orders and configuration.  A radar and a range
+//               sensor look straight ahead.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StressRamActions(int timePassed) {
+	SetSystemChargeRate(SYSTEM_SHIELDS, MAX_SHIELD_CHARGE_RATE);
+	if (GetSensorData(RAM_RADAR) > 0) {
+		SetMotorSpeeds(100, 100);
+		if (!IsTurboOn() && GetRandomNumber(100) < intensity[STRESS_RAM])
+			TurboBoost();
+	} else if (GetSensorData(RAM_RANGE) < RANGE_MAX_RANGE / 4)
+		SetMotorSpeeds(-RAM_SEARCH_SPEED, RAM_SEARCH_SPEED); //Off the wall.
+	else
+		SetMotorSpeeds(RAM_SEARCH_SPEED, 100);
+}
+
+void EquipStressRam(void) {
+	AddSensor(RAM_RADAR, SENSOR_RADAR, -MAX_RADAR_ARC / 2, MAX_RADAR_ARC,
+			RADAR_MAX_RANGE);
+	AddSensor(RAM_RANGE, SENSOR_RANGE, 0, 0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Function: StressMailActions / EquipStressMail
+//
+//  Description: Stress Mail's orders and configuration.  Messages go to the
+//               stress robots in turn; those not in the match are looked up
+//               and not found.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StressMailActions(int timePassed) {
+	int i, count = MAX_STRESS_MESSAGES * intensity[STRESS_MAIL] / 100;
+	INT_32 data;
+
+	while (GetMessage(&data))
+		;                                        //Empty the mailbox.
+	for (i = 0; i < count; i++)
+		SendMessage(stressNames[i % NUM_STRESS_ROBOTS],
+				(INT_32) GetRandomNumber(1000000));
+}
+
+void EquipStressMail(void) {
+}
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: stress.h
+//
+// Description: The header for the stress robots, which load the engine
+//              rather than play well.  See stress.c.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef STRESS_HEADER
+#define STRESS_HEADER 1
+
+typedef enum {
+	STRESS_LASER,                //Fires lasers every order.
+	STRESS_SPIN,                 //Spins with four radars always on.
+	STRESS_RAM,                  //Turbo boosts into whatever it sees.
+	STRESS_MAIL,                 //Floods the other robots' mailboxes.
+	NUM_STRESS_ROBOTS
+} STRESS_ROBOT;
+
+void SetStressIntensity(STRESS_ROBOT robot, int percent);
+
+void StressLaserActions(int timePassed);
+void EquipStressLaser(void);
+void StressSpinActions(int timePassed);
+void EquipStressSpin(void);
+void StressRamActions(int timePassed);
+void EquipStressRam(void);
+void StressMailActions(int timePassed);
+void EquipStressMail(void);
+
+#endif
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: checksum.c
+//
+// Description: This file implements the state checksums described in
+//              checksum.h.
+//
+//              Each value is hashed on its own, rather than whole structs,
+//              so padding and pointers (bitmaps, the owner of a weapon) never
+//              get into a hash.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "competition.h"
+#include "checksum.h"
+
+#define FNV_OFFSET  14695981039346656037ULL     //64-bit FNV-1a.
+#define FNV_PRIME   1099511628211ULL
+
+#define Hash_M(hash, value)  HashBytes((hash), &(value), sizeof(value))
+
+struct CHECKSUM_FILE_TAG {
+	FILE *file;
+	int numRobots;
+	uint64_t fields[CHECKSUM_FIELDS(MAX_ROBOTS)];
+};
+
+//Internal helper prototypes
+static uint64_t HashBytes(uint64_t hash, const void *data, int length);
+static void HashRobot(ROBOT *robot, int alive, uint64_t *fields);
+static uint64_t HashWeapons(t_LL weapons);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ChecksumState
+//
+// Description: This function hashes the state of the match.
+//
+// Parameters: t_LL robots - The robots still fighting.
+//             t_LL deadRobots - The destroyed robots.
+//             t_LL weapons - The weapons in flight.
+//             unsigned int randomState - The game's random number stream.
+//             uint64_t *fields - Filled with the hash of each part (see
+//                                CHECKSUM_FIELDS()), or NULL.
+//
+// Returns: uint64_t - The hash of the whole state.
+//
+////////////////////////////////////////////////////////////////////////////////
+uint64_t ChecksumState(t_LL robots, t_LL deadRobots, t_LL weapons,
+		unsigned int randomState, uint64_t *fields) {
+	uint64_t parts[CHECKSUM_FIELDS(MAX_ROBOTS)], *game;
+	int numRobots = SizeLL(robots) + SizeLL(deadRobots);
+	ROBOT *robot;
+
+	if (fields == NULL)
+		fields = parts;
+	ForeachLL_M(robots, robot)
+		HashRobot(robot, 1, fields + robot->number * CHECKSUM_ROBOT_FIELDS);
+	ForeachLL_M(deadRobots, robot)
+		HashRobot(robot, 0, fields + robot->number * CHECKSUM_ROBOT_FIELDS);
+
+	game = fields + numRobots * CHECKSUM_ROBOT_FIELDS;
+	game[CS_WEAPONS] = HashWeapons(weapons);
+	game[CS_RANDOM] = Hash_M(FNV_OFFSET, randomState);
+
+	return HashBytes(FNV_OFFSET, fields,
+			CHECKSUM_FIELDS(numRobots) * sizeof(uint64_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: OpenChecksumFile
+//
+// Description: This function creates a checksum file and writes its header
+//              and the robots' names.
+//
+// Parameters: char *fileName - The file to write.  It is replaced.
+//             t_LL robots - The robots still fighting.
+//             t_LL deadRobots - The destroyed robots.
+//
+// Returns: CHECKSUM_FILE* - The file, or NULL if it can't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+CHECKSUM_FILE *OpenChecksumFile(char *fileName, t_LL robots,
+		t_LL deadRobots) {
+	CHECKSUM_FILE *file;
+	CHECKSUM_FILE_HEADER header;
+	char names[MAX_ROBOTS][CHECKSUM_NAME_LEN];
+	ROBOT *robot;
+
+	file = calloc(1, sizeof(CHECKSUM_FILE));
+	if (file == NULL)
+		AbortOnError("OpenChecksumFile() could not allocate a checksum "
+				"file.\nProgram will end.");
+	file->file = fopen(fileName, "wb");
+	if (file->file == NULL) {
+		free(file);
+		return NULL;
+	}
+
+	file->numRobots = SizeLL(robots) + SizeLL(deadRobots);
+	header.magic = CHECKSUM_MAGIC;
+	header.version = CHECKSUM_VERSION;
+	header.numRobots = file->numRobots;
+	header.numFields = CHECKSUM_FIELDS(file->numRobots);
+	memset(names, 0, sizeof(names));
+	ForeachLL_M(robots, robot)
+		strncpy(names[robot->number], robot->name, CHECKSUM_NAME_LEN - 1);
+	ForeachLL_M(deadRobots, robot)
+		strncpy(names[robot->number], robot->name, CHECKSUM_NAME_LEN - 1);
+	fwrite(&header, sizeof(header), 1, file->file);
+	fwrite(names, CHECKSUM_NAME_LEN, file->numRobots, file->file);
+	return file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: WriteChecksum
+//
+// Description: This function hashes the state of the match after a
+//              calculation and writes it to a checksum file.
+//
+// Parameters: CHECKSUM_FILE *file - The file.
+//             int tick - The calculation just done.
+//             The rest are as for ChecksumState().
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void WriteChecksum(CHECKSUM_FILE *file, int tick, t_LL robots,
+		t_LL deadRobots, t_LL weapons, unsigned int randomState) {
+	CHECKSUM_RECORD record;
+
+	record.tick = tick;
+	record.reserved = 0;
+	record.hash = ChecksumState(robots, deadRobots, weapons, randomState,
+			file->fields);
+	fwrite(&record, sizeof(record), 1, file->file);
+	fwrite(file->fields, sizeof(uint64_t), CHECKSUM_FIELDS(file->numRobots),
+			file->file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CloseChecksumFile
+//
+// Description: This function closes a checksum file and frees it.
+//
+// Parameters: CHECKSUM_FILE *file - The file.
+//
+// Returns: int - 1 if everything was written, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int CloseChecksumFile(CHECKSUM_FILE *file) {
+	int success = !ferror(file->file);
+
+	success = fclose(file->file) == 0 && success;
+	free(file);
+	return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: HashBytes
+//
+// Description: This function adds bytes to an FNV-1a hash.
+//
+// Parameters: uint64_t hash - The hash so far, or FNV_OFFSET to start one.
+//             const void *data - The bytes.
+//             int length - How many.
+//
+// Returns: uint64_t - The hash.
+//
+////////////////////////////////////////////////////////////////////////////////
+static uint64_t HashBytes(uint64_t hash, const void *data, int length) {
+	const unsigned char *bytes = data;
+	int i;
+
+	for (i = 0; i < length; i++) {
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: HashRobot
+//
+// Description: This function hashes each part of a robot.
+//
+// Parameters: ROBOT *robot - The robot.
+//             int alive - 1 if it is still fighting.
+//             uint64_t *fields - Filled with its CHECKSUM_ROBOT_FIELDS
+//                                hashes.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void HashRobot(ROBOT *robot, int alive, uint64_t *fields) {
+	uint64_t hash;
+	int i;
+
+	hash = Hash_M(FNV_OFFSET, robot->x);
+	hash = Hash_M(hash, robot->y);
+	fields[CS_POSE] = Hash_M(hash, robot->heading);
+
+	hash = Hash_M(FNV_OFFSET, robot->leftTreadSpeed);
+	hash = Hash_M(hash, robot->rightTreadSpeed);
+	hash = Hash_M(hash, robot->turboTime);
+	hash = Hash_M(hash, robot->impulseHeading);
+	fields[CS_MOTION] = Hash_M(hash, robot->impulseSpeed);
+
+	hash = Hash_M(FNV_OFFSET, robot->shields);
+	hash = Hash_M(hash, robot->shieldChargeRate);
+	hash = Hash_M(hash, robot->energyPriorities);
+	for (i = 0; i < MAX_WEAPONS; i++) {
+		hash = Hash_M(hash, robot->weaponArray[i].chargeRate);
+		hash = Hash_M(hash, robot->weaponArray[i].chargeEnergy);
+	}
+	fields[CS_ENERGY] = hash;
+
+	hash = Hash_M(FNV_OFFSET, alive);
+	hash = Hash_M(hash, robot->generatorStructure);
+	fields[CS_DAMAGE] = Hash_M(hash, robot->damageBank);
+
+	hash = Hash_M(FNV_OFFSET, robot->bumped);
+	for (i = 0; i < MAX_SENSORS; i++) {
+		hash = Hash_M(hash, robot->sensorArray[i].type);
+		hash = Hash_M(hash, robot->sensorArray[i].on);
+		hash = Hash_M(hash, robot->sensorArray[i].powered);
+		hash = Hash_M(hash, robot->sensorArray[i].data);
+	}
+	fields[CS_SENSORS] = hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: HashWeapons
+//
+// Description: This function hashes every weapon in flight, in the order
+//              they were fired.
+//
+// Parameters: t_LL weapons - The weapons.
+//
+// Returns: uint64_t - The hash.
+//
+////////////////////////////////////////////////////////////////////////////////
+static uint64_t HashWeapons(t_LL weapons) {
+	uint64_t hash = FNV_OFFSET;
+	WEAPON *weapon;
+
+	ForeachLL_M(weapons, weapon)
+	{
+		hash = Hash_M(hash, weapon->id);
+		hash = Hash_M(hash, weapon->type);
+		hash = Hash_M(hash, weapon->owner->number);
+		hash = Hash_M(hash, weapon->x);
+		hash = Hash_M(hash, weapon->y);
+		hash = Hash_M(hash, weapon->heading);
+		hash = Hash_M(hash, weapon->speed);
+		hash = Hash_M(hash, weapon->energy);
+	}
+	return hash;
+}
@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: checksum.h
+//
+// Description: This file contains the state checksums, a 64-bit hash of the
+//              simulation after every calculation.  ChecksumMatch() in
+//              competition.c writes them to a side file, and two runs of the
+//              same match (eg: before and after an optimization, or a
+//              ResimulateMatch() of a logged match) are compared with
+//              tools/hashdiff, which reports the first calculation and the
+//              part of the state where they went different ways.
+//
+//              Each robot is hashed in CHECKSUM_ROBOT_FIELDS parts and the
+//              rest of the match in CHECKSUM_GAME_FIELDS parts, so a
+//              difference can be put down to, say, robot 2's pose rather
+//              than just "the state".  The hash of a tick is the hash of
+//              its parts.  Values are hashed bit for bit (FNV-1a), so any
+//              change at all, even in the last bit of a float, shows.
+//
+//              A checksum file is, in host byte order:
+//
+//                  CHECKSUM_FILE_HEADER
+//                  the robots' names, CHECKSUM_NAME_LEN bytes each
+//                  for each calculation:
+//                      CHECKSUM_RECORD
+//                      CHECKSUM_FIELDS(numRobots) part hashes
+//
+//              This file does not need Allegro, so tools can include it.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef CHECKSUM_HEADER
+#define CHECKSUM_HEADER 1
+
+#include <stdint.h>
+#include "ll.h"
+
+#define CHECKSUM_MAGIC     0x53435752   //"RWCS"
+#define CHECKSUM_VERSION   1
+#define CHECKSUM_NAME_LEN  32           //At least MAX_NAME_LEN + 1.
+
+typedef enum {                   //Parts of each robot.
+	CS_POSE,                     //Position and heading.
+	CS_MOTION,                   //Tread speeds, turbo and impulse.
+	CS_ENERGY,                   //Shields, weapon charges, rates, priorities.
+	CS_DAMAGE,                   //Alive, generator structure, damage bank.
+	CS_SENSORS,                  //Sensors, their data, and bumps.
+	CHECKSUM_ROBOT_FIELDS
+} CHECKSUM_ROBOT_FIELD;
+
+typedef enum {                   //Parts of the rest of the match.
+	CS_WEAPONS,                  //Every weapon in flight.
+	CS_RANDOM,                   //The game's random number stream.
+	CHECKSUM_GAME_FIELDS
+} CHECKSUM_GAME_FIELD;
+
+//Part hashes in a record: robot r's part f is at r * CHECKSUM_ROBOT_FIELDS
+//+ f, and game part f at numRobots * CHECKSUM_ROBOT_FIELDS + f.
+#define CHECKSUM_FIELDS(numRobots) \
+	((numRobots) * CHECKSUM_ROBOT_FIELDS + CHECKSUM_GAME_FIELDS)
+
+typedef struct {
+	int magic;
+	int version;
+	int numRobots;
+	int numFields;               //CHECKSUM_FIELDS(numRobots).
+} CHECKSUM_FILE_HEADER;
+
+typedef struct {
+	int tick;
+	int reserved;
+	uint64_t hash;               //Of the whole state.
+} CHECKSUM_RECORD;
+
+typedef struct CHECKSUM_FILE_TAG CHECKSUM_FILE;
+
+uint64_t ChecksumState(t_LL robots, t_LL deadRobots, t_LL weapons,
+		unsigned int randomState, uint64_t *fields);
+CHECKSUM_FILE *OpenChecksumFile(char *fileName, t_LL robots,
+		t_LL deadRobots);
+void WriteChecksum(CHECKSUM_FILE *file, int tick, t_LL robots,
+		t_LL deadRobots, t_LL weapons, unsigned int randomState);
+int CloseChecksumFile(CHECKSUM_FILE *file);
+
+#endif
@@ -0,0 +1,511 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: cmdlog.c
+//
+// Description: This file implements the command log described in cmdlog.h.
+//
+//              Logs are small, so a log being written goes straight through
+//              stdio, and a log being read is read into memory whole.  It is
+//              checked right through when it is opened, so every command
+//              read back afterwards is one ApplyRobotOrders() can safely
+//              carry out.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Messages sent are read into the orders'
+//                                store, and aren't limited to MAX_COMMANDS.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cmdlog.h"
+
+typedef struct {
+	const unsigned char *at;
+	const unsigned char *end;
+	int bad;                     //Set if a read ran past the end or found
+} LOG_READER;                    //something that can't be in a log.
+
+struct COMMAND_LOG_TAG {
+	FILE *file;                  //Being written, or NULL.
+	int tick;                    //Of the record being written or read.
+	int inRecord;                //1 until the record's 0 is written or read.
+	unsigned char *data;         //Being read: the whole file.
+	COMMAND_LOG_HEADER *header;
+	LOG_READER in;               //The next thing to read.
+	const unsigned char *end;    //Just after the last record.
+	int ended;                   //1 if the log gives the match result.
+	MATCH_RESULT result;
+	COMMAND_BUFFER skipped;      //Orders read only to pass over them.
+};
+
+//Arguments of each COMMANDTYPE.  CMD_STATUS_MESSAGE has its text instead.
+static const int argCounts[] = { 2, 0, 2, 2, 2, NUM_ENERGY_SYSTEMS, 1, 0, 0,
+		2, 0 };
+
+//Internal helper prototypes
+static void PutNumber(COMMAND_LOG *log, unsigned int value);
+static void PutSigned(COMMAND_LOG *log, int value);
+static unsigned int GetNumber(LOG_READER *in);
+static int GetSigned(LOG_READER *in);
+static void GetOrders(LOG_READER *in, COMMAND_BUFFER *orders,
+		char *statusMessage, int numRobots);
+static int CheckLog(COMMAND_LOG *log);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartCommandLog
+//
+// Description: This function creates a log and writes its header.
+//
+// Parameters: char *fileName - The file to log to.  It is replaced.
+//             COMMAND_LOG_HEADER *header - The match setup.  Magic, version and
+//                                     orderFreq are filled in.
+//
+// Returns: COMMAND_LOG* - The log, or NULL if the file can't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+COMMAND_LOG *StartCommandLog(char *fileName, COMMAND_LOG_HEADER *header) {
+	COMMAND_LOG *log = calloc(1, sizeof(COMMAND_LOG));
+
+	if (log == NULL)
+		AbortOnError("StartCommandLog() could not allocate a log.\n"
+				"Program will end.");
+	log->file = fopen(fileName, "wb");
+	if (log->file == NULL) {
+		free(log);
+		return NULL;
+	}
+
+	header->magic = CMDLOG_MAGIC;
+	header->version = CMDLOG_VERSION;
+	header->orderFreq = ORDER_FREQ;
+	fwrite(header, sizeof(COMMAND_LOG_HEADER), 1, log->file);
+	log->tick = -1;
+	return log;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LogOrders
+//
+// Description: This function logs the orders applied to one robot.  Calls
+//              must come in the order the orders are applied, calculation by
+//              calculation.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//             int tick - The calculation, 0 for configuration orders.
+//             int number - The robot's number.
+//             COMMAND_BUFFER *orders - The robot's commands.
+//             char *statusMessage - The text for CMD_STATUS_MESSAGE.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void LogOrders(COMMAND_LOG *log, int tick, int number, COMMAND_BUFFER *orders,
+		char *statusMessage) {
+	COMMAND *command;
+	SENT_MESSAGE *message;
+	int i, j, length;
+
+	if (orders->count == 0 && orders->messageCount == 0)
+		return;
+	if (tick != log->tick) {
+		if (log->inRecord)
+			PutNumber(log, 0);
+		PutNumber(log, tick - log->tick);
+		log->tick = tick;
+		log->inRecord = 1;
+	}
+
+	PutNumber(log, number + 1);
+	PutNumber(log, orders->count + orders->messageCount);
+	for (i = 0; i < orders->count; i++) {
+		command = &orders->commands[i];
+		PutNumber(log, command->type);
+		if (command->type == CMD_STATUS_MESSAGE) {
+			length = strlen(statusMessage);
+			PutNumber(log, length);
+			fwrite(statusMessage, 1, length, log->file);
+		} else
+			for (j = 0; j < argCounts[command->type]; j++)
+				PutSigned(log, command->args[j]);
+	}
+	for (i = 0; i < orders->messageCount; i++) {
+		message = &orders->messages[i];
+		PutNumber(log, CMD_SEND_MESSAGE);
+		PutSigned(log, message->to);
+		PutSigned(log, message->data);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopCommandLog
+//
+// Description: This function ends a log, with the match result if there is
+//              one, and frees it.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//             MATCH_RESULT *result - How the match ended, or NULL if it
+//                                    didn't.
+//
+// Returns: int - 1 if the whole log was written, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int StopCommandLog(COMMAND_LOG *log, MATCH_RESULT *result) {
+	int success;
+
+	if (log->inRecord)
+		PutNumber(log, 0);
+	if (result != NULL) {
+		PutNumber(log, 0);
+		fwrite(result, sizeof(MATCH_RESULT), 1, log->file);
+	}
+	success = !ferror(log->file);
+	success = fclose(log->file) == 0 && success;
+	free(log);
+	return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: OpenCommandLog
+//
+// Description: This function reads a log and checks it, ready for
+//              ReadLoggedOrders() to give back the first record.
+//
+// Parameters: char *fileName - The log.
+//
+// Returns: COMMAND_LOG* - The log, or NULL if the file can't be read, isn't
+//                         a log from this build or is damaged.  A log cut
+//                         short before the end of a record is damaged; one
+//                         cut short between records just has no result.
+//
+////////////////////////////////////////////////////////////////////////////////
+COMMAND_LOG *OpenCommandLog(char *fileName) {
+	COMMAND_LOG *log;
+	FILE *file;
+	long size;
+
+	file = fopen(fileName, "rb");
+	if (file == NULL)
+		return NULL;
+	log = calloc(1, sizeof(COMMAND_LOG));
+	if (log == NULL)
+		AbortOnError("OpenCommandLog() could not allocate a log.\n"
+				"Program will end.");
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0
+			|| fseek(file, 0, SEEK_SET) != 0
+			|| (log->data = malloc(size + 1)) == NULL
+			|| fread(log->data, 1, size, file) != (size_t) size) {
+		fclose(file);
+		free(log->data);
+		free(log);
+		return NULL;
+	}
+	fclose(file);
+
+	log->header = (COMMAND_LOG_HEADER *) log->data;
+	log->in.at = log->data + sizeof(COMMAND_LOG_HEADER);
+	log->in.end = log->data + size;
+	if (size < (long) sizeof(COMMAND_LOG_HEADER)
+			|| log->header->magic != CMDLOG_MAGIC
+			|| log->header->version != CMDLOG_VERSION
+			|| log->header->orderFreq != ORDER_FREQ
+			|| log->header->numRobots < 1
+			|| log->header->numRobots > MAX_ROBOTS || !CheckLog(log)) {
+		CloseCommandLog(log);
+		return NULL;
+	}
+	RewindCommandLog(log);
+	return log;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetLoggedHeader / GetLoggedResult
+//
+// Description: These functions give the match setup and result from a log
+//              being read.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//             MATCH_RESULT *result - Filled with the result.
+//
+// Returns: COMMAND_LOG_HEADER* - The header, part of the log.
+//          int - 1 if the log gives the result, 0 if the match didn't end.
+//
+////////////////////////////////////////////////////////////////////////////////
+COMMAND_LOG_HEADER *GetLoggedHeader(COMMAND_LOG *log) {
+	return log->header;
+}
+
+int GetLoggedResult(COMMAND_LOG *log, MATCH_RESULT *result) {
+	if (!log->ended)
+		return 0;
+	*result = log->result;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadLoggedOrders
+//
+// Description: This function gives back the orders a robot had applied at
+//              a calculation.  Calls must come in the order the orders are
+//              to be applied.  Orders logged for earlier calculations that
+//              were never asked for are passed over, so a simulation that
+//              has gone its own way (or had a snapshot restored after a
+//              rewind) keeps in step with the log's calculations.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//             int tick - The calculation, 0 for configuration orders.
+//             int number - The robot's number.
+//             COMMAND_BUFFER *orders - Filled with the commands, or emptied.
+//             char *statusMessage - Filled with the text of a
+//                                   CMD_STATUS_MESSAGE.
+//
+// Returns: int - 1 if the robot had orders, 0 if it had none.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ReadLoggedOrders(COMMAND_LOG *log, int tick, int number,
+		COMMAND_BUFFER *orders, char *statusMessage) {
+	static char skippedMessage[STATUS_MSG_LEN];  //Only written, never read.
+	LOG_READER in;
+	unsigned int value;
+
+	ClearOrders(orders);
+	for (;;) {
+		if (log->in.at >= log->end)
+			return 0;
+		in = log->in;                        //Look before taking anything.
+		value = GetNumber(&in);
+		if (!log->inRecord) {                //A new record: is it due?
+			if (log->tick + (int) value > tick)
+				return 0;
+			log->tick += value;
+			log->inRecord = 1;
+		} else if (value == 0)               //End of the record.
+			log->inRecord = 0;
+		else if (log->tick < tick)           //Never asked for.
+			GetOrders(&in, &log->skipped, skippedMessage,
+					log->header->numRobots);
+		else if ((int) value - 1 == number) {
+			GetOrders(&in, orders, statusMessage, log->header->numRobots);
+			log->in = in;
+			return 1;
+		} else                               //Someone else's, later on.
+			return 0;
+		log->in = in;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RewindCommandLog
+//
+// Description: This function goes back to the first record of a log being
+//              read.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RewindCommandLog(COMMAND_LOG *log) {
+	log->in.at = log->data + sizeof(COMMAND_LOG_HEADER);
+	log->in.bad = 0;
+	log->tick = -1;
+	log->inRecord = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CloseCommandLog
+//
+// Description: This function frees a log being read.
+//
+// Parameters: COMMAND_LOG *log - The log.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void CloseCommandLog(COMMAND_LOG *log) {
+	FreeOrders(&log->skipped);
+	free(log->data);
+	free(log);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PutNumber / PutSigned
+//
+// Description: These functions write a varint, unsigned or zigzag coded.
+//
+// Parameters: COMMAND_LOG *log - The log being written.
+//             value - The number.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PutNumber(COMMAND_LOG *log, unsigned int value) {
+	while (value >= 0x80) {
+		putc((value & 0x7f) | 0x80, log->file);
+		value >>= 7;
+	}
+	putc(value, log->file);
+}
+
+static void PutSigned(COMMAND_LOG *log, int value) {
+	PutNumber(log, value < 0 ? ~((unsigned int) value << 1)
+			: (unsigned int) value << 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetNumber / GetSigned
+//
+// Description: These functions read a varint, unsigned or zigzag coded.
+//
+// Parameters: LOG_READER *in - Where to read.  in->bad is set, and 0
+//                              returned, if it runs out.
+//
+// Returns: The number.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned int GetNumber(LOG_READER *in) {
+	unsigned int value = 0;
+	int shift;
+
+	for (shift = 0; shift < 35; shift += 7) {
+		if (in->at >= in->end) {
+			in->bad = 1;
+			return 0;
+		}
+		value |= (unsigned int) (*in->at & 0x7f) << shift;
+		if (!(*in->at++ & 0x80))
+			return value;
+	}
+	in->bad = 1;
+	return 0;
+}
+
+static int GetSigned(LOG_READER *in) {
+	unsigned int value = GetNumber(in);
+
+	return value & 1 ? (int) ~(value >> 1) : (int) (value >> 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetOrders
+//
+// Description: This function reads one robot's commands.  Anything
+//              ApplyRobotOrders() couldn't carry out safely (a sensor port,
+//              system or message length out of range, or more than
+//              MAX_COMMANDS commands besides messages) marks the log bad.
+//
+// Parameters: LOG_READER *in - Just after the robot number.
+//             COMMAND_BUFFER *orders - Filled with the commands.
+//             char *statusMessage - Filled with any status message text.
+//             int numRobots - Robots in the match.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GetOrders(LOG_READER *in, COMMAND_BUFFER *orders,
+		char *statusMessage, int numRobots) {
+	COMMAND *command;
+	unsigned int i, count, type, length;
+	int j, to, data;
+
+	count = GetNumber(in);
+	ClearOrders(orders);
+	for (i = 0; i < count && !in->bad; i++) {
+		type = GetNumber(in);
+		if (type > CMD_READ_MESSAGE) {
+			in->bad = 1;
+			break;
+		}
+		if (type == CMD_SEND_MESSAGE) {
+			to = GetSigned(in);
+			data = GetSigned(in);
+			in->bad |= to < 0 || to >= numRobots;
+			if (!AddSentMessage(orders, to, data))
+				orders->dropped++;
+			continue;
+		}
+		if (orders->count == MAX_COMMANDS) {
+			in->bad = 1;
+			break;
+		}
+		command = &orders->commands[orders->count++];
+		command->type = type;
+		if (command->type == CMD_STATUS_MESSAGE) {
+			length = GetNumber(in);
+			if (length >= STATUS_MSG_LEN || length > in->end - in->at) {
+				in->bad = 1;
+				break;
+			}
+			memcpy(statusMessage, in->at, length);
+			statusMessage[length] = '\0';
+			in->at += length;
+			continue;
+		}
+		for (j = 0; j < argCounts[command->type]; j++)
+			command->args[j] = GetSigned(in);
+
+		if (command->type == CMD_SENSOR_STATUS)
+			in->bad |= command->args[0] < 0 || command->args[0] >= MAX_SENSORS;
+		else if (command->type == CMD_CHARGE_RATE)
+			in->bad |= command->args[0] < 0
+					|| command->args[0] >= NUM_ENERGY_SYSTEMS;
+		else if (command->type == CMD_CHARGE_PRIORITIES)
+			for (j = 0; j < NUM_ENERGY_SYSTEMS; j++)
+				in->bad |= command->args[j] < 0
+						|| command->args[j] >= NUM_ENERGY_SYSTEMS;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckLog
+//
+// Description: This function reads a log right through, checking every
+//              record, and finds where the records end and the result.
+//
+// Parameters: COMMAND_LOG *log - The log, with its header checked.
+//
+// Returns: int - 1 if the log can be used, 0 if it is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckLog(COMMAND_LOG *log) {
+	char statusMessage[STATUS_MSG_LEN];
+	LOG_READER *in = &log->in;
+	unsigned int number;
+	int i;
+
+	for (i = 0; i < log->header->numRobots; i++)
+		log->header->robots[i].name[MAX_NAME_LEN] = '\0';
+
+	while (in->at < in->end) {
+		log->end = in->at;
+		if (GetNumber(in) == 0) {            //The result.
+			if (in->end - in->at != sizeof(MATCH_RESULT))
+				return 0;
+			memcpy(&log->result, in->at, sizeof(MATCH_RESULT));
+			log->ended = 1;
+			return !in->bad;
+		}
+		while (!in->bad && (number = GetNumber(in)) != 0) {
+			if (number > (unsigned int) log->header->numRobots)
+				return 0;
+			GetOrders(in, &log->skipped, statusMessage,
+					log->header->numRobots);
+		}
+		if (in->bad)
+			return 0;
+	}
+	log->end = in->at;
+	return 1;
+}
@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: cmdlog.h
+//
+// Description: This file contains the command log, which records only what
+//              goes into a match: the robots and where they start, the
+//              game's random number stream and the commands each robot had
+//              applied.  Everything else follows from those, so the match
+//              can be simulated again exactly without any robot code (see
+//              LogMatchCommands() and ResimulateMatch() in competition.c).
+//              Logs are a few bytes an order tick, and make real matches
+//              into physics-only benchmarks.
+//
+//              A log is, in host byte order:
+//
+//                  COMMAND_LOG_HEADER
+//                  records...
+//                  0, then the MATCH_RESULT, if the match ended
+//
+//              A record holds the orders applied at one calculation; the
+//              configuration orders are the record for calculation 0.
+//              Numbers are varints as in recorder.h.  A record is:
+//
+//                  calculations since the last record (since -1 for the
+//                      first)
+//                  for each robot with orders, in the order applied:
+//                      robot number + 1
+//                      number of commands
+//                      for each command, its type and its arguments (signed,
+//                          as many as the type has), or for
+//                          CMD_STATUS_MESSAGE the message length and text.
+//                          Messages sent come last, and don't count
+//                          towards MAX_COMMANDS.
+//                  0
+//
+//              The simulation must be built the same way (ORDER_FREQ and
+//              floating point) for the log to play back the same.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef CMDLOG_HEADER
+#define CMDLOG_HEADER 1
+
+#include "competition.h"
+
+#define CMDLOG_MAGIC    0x434c5752   //"RWLC"
+#define CMDLOG_VERSION  1
+
+typedef struct {
+	SENSORTYPE type;
+	int angle;
+	int width;
+	int range;
+} COMMAND_LOG_SENSOR;
+
+typedef struct {                 //A robot as it was set up.
+	char name[MAX_NAME_LEN + 1];
+	int color;
+	float x;
+	float y;
+	float heading;
+	COMMAND_LOG_SENSOR sensors[MAX_SENSORS];
+} COMMAND_LOG_ROBOT;
+
+typedef struct {
+	int magic;
+	int version;
+	int orderFreq;
+	int numRobots;
+	unsigned int randomState;    //The game's stream once the robots are set up.
+	int matchCalcLimit;          //See SetMatchLimits().
+	int stalemateLimit;
+	COMMAND_LOG_ROBOT robots[MAX_ROBOTS];                //By robot number.
+} COMMAND_LOG_HEADER;
+
+typedef struct COMMAND_LOG_TAG COMMAND_LOG;
+
+COMMAND_LOG *StartCommandLog(char *fileName, COMMAND_LOG_HEADER *header);
+void LogOrders(COMMAND_LOG *log, int tick, int number, COMMAND_BUFFER *orders,
+		char *statusMessage);
+int StopCommandLog(COMMAND_LOG *log, MATCH_RESULT *result);
+
+COMMAND_LOG *OpenCommandLog(char *fileName);
+COMMAND_LOG_HEADER *GetLoggedHeader(COMMAND_LOG *log);
+int GetLoggedResult(COMMAND_LOG *log, MATCH_RESULT *result);
+int ReadLoggedOrders(COMMAND_LOG *log, int tick, int number,
+		COMMAND_BUFFER *orders, char *statusMessage);
+void RewindCommandLog(COMMAND_LOG *log);
+void CloseCommandLog(COMMAND_LOG *log);
+
+#endif
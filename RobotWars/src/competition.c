@@ -1,1270 +1,3833 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: competition.c
-//
-// Description:
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 6 Mar 2006 - Created
-//                  18 Apr 2006 - Bugs fixed in RegisterRobot().
-//                  19 Jul 2006 - Bug fixed in SetStatusMessage().
-//                  19 Jul 2006 - Major rework to change robot data from array
-//                                to linked list.  LL docs found at:
-//                                http://cmp.felk.cvut.cz/~matas/surrey/
-//                                                             software/LL.html
-//                  20 Jul 2006 - Added gamestate GS_SETUP and added checks in
-//                                RegisterRobot() and AddSensor() to ensure
-//                                they are called only during game setup.
-//                                Note that through a couple of tricks it is
-//                                still possible for a robot to add another
-//                                robot during its own setup, but it's not
-//                                worth coding the code to stop it as this
-//                                cheat would be plainly evident.
-//                  23 Jul 2006 - Changed the way weapons function to have them
-//                                exist as systems in the robot before firing,
-//                                but create a weapon in a linked list after
-//                                firing.  This greatly simplifies iterating
-//                                through weapons in other files.  Changes here
-//                                include some in InitCompetition() and
-//                                Fight(), but more in FireWeapon(), and
-//                                EndCompetition().  As part of these changes,
-//                                weapons were also standardized.  For example,
-//                                lasers now have a splash damage that is
-//                                treated the same as missiles, but it happens
-//                                to be for 0 range and 0 damage.
-//                   1 Aug 2006 - Added a range of new functions:
-//                                   - SendMessage()
-//                                   - GetMessage()
-//                                   - HasNullCharacter()
-//                                   - LookupRobotByName()
-//                                Also changed all "internal" functions to
-//                                static to protect newer functions such as
-//                                LookupRobotByName(), which could have easily
-//                                broken the internal game "secrets".
-//                   6 Sep 2006 - Changed RegisterRobot() to allow for custom
-//                                robot graphics and start locations.
-//                              - Changed ChooseRandomLocation() so that robots
-//                                are placed anywhere on the screen but keep at
-//                                least MIN_RANDOM_DIST cm from each other.
-//                  10 Apr 2007 - New functions TurboBoost() and IsTurboOn().
-//                                New sound in global sound file array.
-//
-// TODO: 1) Add a detector for an infinite loop on a robot's turn.
-//
-//
-////////////////////////////////////////////////////////////////////////////////
-#include <stdio.h>                       //For sprintf(), srand, and rand
-#include <time.h>                        //For system time.
-#include <string.h>
-#include <math.h>
-#include "competition.h"
-#include "physics.h"
-#include "graphics.h"
-#include "particles.h"
-
-static GAME theGame;
-static t_LL robotList;        //Holds list of all robots.
-static t_LL deadRobotList;    //Holds list of destroyed robots.
-static ROBOT *curRobot = NULL;   //Used when robots are giving orders.
-static t_LL weaponList;       //Weapons that have been fired.
-
-volatile int calcCounter = 0;
-volatile int calcsCompleted = 0, cps = 0;
-volatile int frameCounter = 0, fps = 0;
-
-static char *soundFileNames[NUM_SOUNDS] = { "..\\resources\\sounds\\laser.wav",
-		"..\\resources\\sounds\\laserhit.wav",
-		"..\\resources\\sounds\\missile.wav",
-		"..\\resources\\sounds\\missilehit.wav",
-		"..\\resources\\sounds\\fight.wav",
-		"..\\resources\\sounds\\robotscollide.wav",
-		"..\\resources\\sounds\\robotexplode.wav",
-		"..\\resources\\sounds\\turboboost.wav" };
-
-//Internal Helper Prototypes.  These are static
-//to protect them from being called by a robot.
-static int HasNullCharacter(char *string, int numChars);
-static ROBOT *LookupRobotByName(char *name);
-static int BoundAngle(int angle);
-static void ChooseRandomLocation(ROBOT *robot);
-static void PlaySounds(GAME *game);
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Name: AddCalc
-//
-// Description: This is the timer interrupt handler for calculation counts.
-//              It should be called CALCS_PER_SEC times each second.  All that
-//              is performed is a record of the number of calculations to
-//              perform the next time a game loop runs.  This way the robots
-//              will move at the same speed irrespective of the refresh rate
-//              of the monitor.
-//
-//              Because timers are actually implemented as threads, the
-//              following rules must be followed for proper Allegro timer ops:
-//                - Globals accessed here must be declared volatile AND must be
-//                  locked in the initialization code.
-//                - The function itself must be locked in the initialization.
-//                - Function must end with the macro END_OF_FUNCTION(AddCalc)
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void AddCalc(void) {
-	calcCounter++;
-}
-END_OF_FUNCTION(AddCalc)
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Name: SecondTimer
-//
-// Description: This is the timer interrupt handler that increments once per
-//              second.  This is used to calculate the frames per second.
-//              and calculations performed per second.  This function and the
-//              variables frameCounter, fps, calcsCompleted, and cps are
-//              subject to all the same restrictions described in AddCalc().
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void FPSTimer(void) {
-	fps = frameCounter;
-	frameCounter = 0;
-	cps = calcsCompleted;
-	calcsCompleted = 0;
-}
-END_OF_FUNCTION(SecondTimer)
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: Fight
-//
-// Description: This is heart of the Robot Wars competition.  It installs the
-//              required timers (including locking the related variables) and
-//              then enters the main game loop.  In that loop, the robots are
-//              updated based on the number of remaining calculations to
-//              perform.  Only once calcCounter has been reduced to 0 is the
-//              scene drawn.
-//
-// Note: While not a bug per se, if run on a crappy system, or with too many
-//       robots, this system can result in no scenes being rendered for periods
-//       of time, or even the duration of the competition.  I need to add a
-//       sanity check that will still render at least 1 frames/s even if the
-//       overall speed of the simulation drops.
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void Fight(void) {
-	int keyPress, calcsUntilOrders = 0;
-	char systemMessage[255] = "";
-	ROBOT *robot;
-
-	LOCK_VARIABLE(calcCounter);LOCK_VARIABLE(calcsCompleted);LOCK_VARIABLE(cps);LOCK_VARIABLE(frameCounter);LOCK_FUNCTION(fps);LOCK_FUNCTION(AddCalc);
-
-	if (install_int_ex(AddCalc, BPS_TO_TIMER(CALCS_PER_SEC)) != 0)
-		AbortOnError(
-				"Fight() failed to create calcs timer.\nProgram will exit.");
-
-	if (install_int_ex(FPSTimer, SECS_TO_TIMER(1)) != 0)
-		AbortOnError("Fight() failed to create FPS timer.\nProgram will exit.");
-
-	while (!key[KEY_SPACE])
-		;  //Wait for screen to initialize before starting.
-
-	theGame.state = GS_FIGHTING;
-
-	while (!key[KEY_ESC]) {
-
-		if (keypressed())                          //Check for relevant keys.
-		{
-			keyPress = readkey() & 0xff;
-			if (keyPress == 'r' || keyPress == 'R') //User wants re-randomized loc's.
-				ForeachLL_M(robotList, robot)
-				{
-					ChooseRandomLocation(robot);
-					robot->heading = GetRandomNumber(360);
-				}
-		}
-
-		while (calcCounter) {
-			calcCounter--;
-			calcsUntilOrders++;
-
-			UpdateEnergySystems(robotList);           //Do first so we know what
-													  //systems are powered.
-			MoveRobots(robotList);
-			DrawRobotBitmaps(robotList);
-			CheckRobotCollisions(&theGame, robotList);
-
-			MoveWeapons(weaponList);
-			CheckWeaponCollisions(&theGame, robotList, weaponList);
-
-			//Now that collisions are
-			ApplyDamage(&theGame, robotList, deadRobotList); //done and weapons have
-															 //hit, we apply damage.
-
-			DrawSensorBitmaps(robotList);          //Need to draw BEFORE data is
-												   //updated because bimaps are
-												   //used in collision detection.
-			UpdateSensorData(robotList);
-
-			UpdateParticles();
-
-			calcsCompleted++;
-
-			if (calcsUntilOrders == ORDER_FREQ) {
-				calcsUntilOrders = 0;
-				ForeachLL_M(robotList, curRobot)
-					curRobot->ActionsFunction(TURN_TIME);
-			}
-
-			if (theGame.useSounds)
-				PlaySounds(&theGame);
-
-		}
-
-		sprintf(systemMessage, "FPS: %d  CPS: %d", fps, cps);
-		RenderScene(robotList, deadRobotList, weaponList, systemMessage);
-		frameCounter++;
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: InitCompetition
-//
-// Description: This function sets up the robot list, the Allegro library,
-//              sets up and loads in the sounds, and calls the function to
-//              initialize the graphics.
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void InitCompetition() {
-	int i;
-
-	theGame.state = GS_SETUP;    //Record game state.
-	robotList = ConsLL();        //Create the robot linked list.
-	deadRobotList = ConsLL();    //Create the destroyed robots linked list.
-	weaponList = ConsLL();
-
-	srand((unsigned) time(NULL)); //Randomize random numbers with time.
-	allegro_init();              //Initialize the Allegro library and
-	install_timer();             //specifically add the timer, keyboard,
-	install_keyboard();          //and mouse functionality.
-	install_mouse();
-
-	if (!install_sound(DIGI_AUTODETECT, MIDI_NONE, NULL)) {
-		theGame.useSounds = 1;
-		for (i = 0; i < NUM_SOUNDS; i++)   //Set all sounds to NULL so they will
-			theGame.sounds[i] = NULL;    //be properly freed in EndCompetition()
-
-		for (i = 0; i < NUM_SOUNDS; i++) {
-			theGame.playSound[i] = 0;
-			theGame.sounds[i] = load_wav(soundFileNames[i]);
-			if (theGame.sounds[i] == NULL) {
-				theGame.useSounds = 0;
-				char message [40];
-                sprintf(message, "Sounds failed to load %d", i);
-				AbortOnError(message);
-				break;
-			}
-		}
-	} else
-		theGame.useSounds = 0;
-
-	InitGraphics();              //Load graphics particular to the robot
-}                              //competition.
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: RegisterRobot
-//
-// Description: This function adds robots to the game.  Note that the random
-//              starting locations are highly dependent on a maximum number
-//              of robots of 4.  If more are desired, this function will
-//              have to be adjusted.
-//
-// Bug Fixes: 18 Apr 2006 - Found a bug that caused all calls to
-//                          SetSystemChargePriorities() to affect the 0th
-//                          robot when called from the setup function.
-//                          curRobot is now changed before the call to the
-//                          robot configuration function.  This also means that
-//                          all robot functions can be called during
-//                          configuration.
-//                        - The call the the configuration function also moved
-//                          to the end of this function so that any changes the
-//                          player makes to how the robot functions will not be
-//                          overwritten with defaults.
-//
-// Change History: 23 Juy 2006 - Now that weapons are treated the same, there
-//                               is a much larger area as weapons are
-//                               initialized on the robot.  Some of this data
-//                               (eg: impactSound) isn't even used as part of
-//                               the robot, but is simply copied over to the
-//                               weapon when it is fired in FireWeapon() for
-//                               later use.
-//                  6 Sep 2006 - Major change as users can now specify unique
-//                               graphics for their robot, as well as a
-//                               starting location.
-//                 10 Apr 2007 - Added Turbo boost functions to turn on/check
-//                               as well as required constants and sound
-//                               support.
-//
-// Parameters: char *robotName - The string name of the robot.
-//             ROBOTCOLORS color - The color of the robot in the game.
-//             robotActions - A pointer to a function that accepts an int
-//                            to be called by the game every time the robot's
-//                            logic is to be executed.
-//             configureRobot - A pointer to a function so the player can
-//                              configure the robot before the game begins.
-//             customImage - A string giving the path/file name of a bitmap to
-//                           use as the image for this robot.  No size checking
-//                           is performed, so use with caution.
-//             x, y        - Starting location and heading for the robot.  If
-//                           any of these values are <0 then a random location
-//                           will be selected.  Values in cm.
-//             heading     - Starting heading of the robot.  If <0 then a random
-//                           heading will be chosen.  Value in degrees.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void RegisterRobot(char *robotName, ROBOTCOLORS color,
-		void (*robotActions)(int), void (*configureRobot)(void),
-		char *customImage, int x, int y, float heading) {
-	int i, robotNumber;
-	ROBOT newRobot;
-
-	if (theGame.state != GS_SETUP)
-		AbortOnError(
-				"Call made to RegisterRobot() when game is not in setup state."
-						"\nProgram will end.");
-
-	robotNumber = SizeLL(robotList);
-	if (robotNumber == MAX_ROBOTS)
-		AbortOnError("RegisterRobot() Attempted to add too many robots.\n"
-				"Program will end.");
-
-	newRobot.ActionsFunction = robotActions;
-
-	switch (color) {
-	case ROBOT_RED:
-		newRobot.color = makecol(255, 0, 0);
-		break;
-	case ROBOT_GREEN:
-		newRobot.color = makecol(0, 255, 0);
-		break;
-	case ROBOT_BLUE:
-		newRobot.color = makecol(0, 0, 255);
-		break;
-	case ROBOT_YELLOW:
-		newRobot.color = makecol(255, 255, 0);
-		break;
-	case ROBOT_PURPLE:
-		newRobot.color = makecol(255, 0, 240);
-		break;
-	case ROBOT_TURQUOISE:
-		newRobot.color = makecol(0, 255, 255);
-		break;
-	case ROBOT_WHITE:
-	default:
-		newRobot.color = makecol(255, 255, 255);
-	}
-	if (HasNullCharacter(robotName, MAX_NAME_LEN)) {
-		newRobot.name = malloc(sizeof(char) * strlen(robotName));
-		strcpy(newRobot.name, robotName);
-		newRobot.number = robotNumber;
-	} else
-		AbortOnError("RegisterRobot() was passed a robot name exceeding "
-				"MAX_NAME_LEN.\nProgram will end.");
-
-	//Set starting speed values
-	newRobot.leftTreadSpeed = 0;
-	newRobot.rightTreadSpeed = 0;
-	newRobot.impulseHeading = 0;
-	newRobot.impulseSpeed = 0;
-	newRobot.turboTime = 0;
-
-	//Configure the sensors.
-	newRobot.bumped = BUMP_NONE;
-	for (i = 0; i < MAX_SENSORS; i++) {
-		newRobot.sensorArray[i].type = SENSOR_NONE;
-		newRobot.sensorArray[i].image = NULL;
-	}
-
-	//Configure the laser.
-	newRobot.weaponArray[LASER_PORT].type = WEAPON_LASER;
-	newRobot.weaponArray[LASER_PORT].maxAngle = LASER_MAX_ANGLE;
-	newRobot.weaponArray[LASER_PORT].minEnergy = MIN_LASER_ENERGY;
-	newRobot.weaponArray[LASER_PORT].maxEnergy = MAX_LASER_ENERGY;
-	newRobot.weaponArray[LASER_PORT].bonusEnergy = LASER_ENERGY_BONUS;
-	newRobot.weaponArray[LASER_PORT].splashRange = LASER_SPLASH_RANGE;
-	newRobot.weaponArray[LASER_PORT].splashDamage = LASER_SPLASH_DAMAGE;
-	newRobot.weaponArray[LASER_PORT].speed = LASER_SPEED;
-	newRobot.weaponArray[LASER_PORT].bumpValue = BUMP_LASER;
-	newRobot.weaponArray[LASER_PORT].firingSound = SND_LASER_FIRE;
-	newRobot.weaponArray[LASER_PORT].impactSound = SND_LASER_HIT;
-
-	//Configure the missiles.
-	newRobot.weaponArray[MISSILE_PORT].type = WEAPON_MISSILE;
-	newRobot.weaponArray[MISSILE_PORT].maxAngle = MISSILE_MAX_ANGLE;
-	newRobot.weaponArray[MISSILE_PORT].minEnergy = MIN_MISSILE_ENERGY;
-	newRobot.weaponArray[MISSILE_PORT].maxEnergy = MAX_MISSILE_ENERGY;
-	newRobot.weaponArray[MISSILE_PORT].bonusEnergy = MISSILE_ENERGY_BONUS;
-	newRobot.weaponArray[MISSILE_PORT].splashRange = MISSILE_SPLASH_RANGE;
-	newRobot.weaponArray[MISSILE_PORT].splashDamage = MISSILE_SPLASH_DAMAGE;
-	newRobot.weaponArray[MISSILE_PORT].speed = MISSILE_SPEED;
-	newRobot.weaponArray[MISSILE_PORT].bumpValue = BUMP_MISSILE;
-	newRobot.weaponArray[MISSILE_PORT].firingSound = SND_MISSILE_FIRE;
-	newRobot.weaponArray[MISSILE_PORT].impactSound = SND_MISSILE_HIT;
-
-	for (i = 0; i < MAX_WEAPONS; i++) {
-		newRobot.weaponArray[i].chargeRate = 0;
-		newRobot.weaponArray[i].chargeEnergy = 0;
-	}
-
-	//Set starting energy priorites in same order as SYSTEMS declaration.
-	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++)
-		newRobot.energyPriorities[i] = (SYSTEM) i;
-
-	//Set initial energy values.  Weapons were done in the weapons section.
-	newRobot.shields = START_SHIELD_ENERGY;
-	newRobot.shieldChargeRate = 0;
-
-	//Set structure-related values
-	newRobot.generatorStructure = MAX_GENERATOR_STRUCTURE;
-
-	//Robot has no damage to be applied at start.
-	newRobot.damageBank = 0;
-
-	//Load the robot's graphic, if required.  There is no error checking here as
-	//if newRobot.graphic is NULL, the graphics routines will simply use the
-	//default robot graphic to render the robot.
-	newRobot.graphic = NULL;
-	if (customImage != NULL)
-		newRobot.graphic = load_bitmap(customImage, NULL);
-
-	//Create the robot's bitmap.
-	newRobot.image = create_bitmap(SHIELD_BMP_SZ, SHIELD_BMP_SZ);
-	if (newRobot.image == NULL)
-		AbortOnError("RegisterRobot() failed to create robot image.\n"
-				"Program will end.");
-
-	strcpy(newRobot.statusMessage, ""); //No status message at start.
-
-	newRobot.mailBox = ConsLL();        //Create the robot's mailbox.
-
-	InsLastLL(robotList, newRobot);     //Put robot on end of the list.
-	curRobot = LastElmLL(robotList);   //Record current robot for configuration.
-
-	//Set robot starting location.  This is done only after insertion into the
-	//list because ChooseRandomLocation() requires the list to have robots in it.
-	if (x < 0 || y < 0)
-		ChooseRandomLocation(curRobot);
-	else {
-		curRobot->x = x;
-		curRobot->y = y;
-	}
-	if (heading < 0)
-		curRobot->heading = GetRandomNumber(360);
-	else
-		curRobot->heading = heading;
-
-	configureRobot();                   //Call user's configuration function.
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: AddSensor
-//
-// Description: This adds a sensor to the robot.  The provided port must be
-//              an empty port on the robot, and must be in the valid port range,
-//              width range, and distance range.
-//
-// Parameters: int port - The port to put the sensor on.
-//             SENSORTYPE type - The type of sensor to add.
-//             int angle - The angle the sensor points.  This may have different
-//                         meanings for different sensors.
-//             int range - The distance to which the sensor can "look".
-//
-// Returns: int - 0 if sensor install fails.
-//                1 if successful.
-//
-////////////////////////////////////////////////////////////////////////////////
-int AddSensor(int port, SENSORTYPE type, int angle, int width, int range) {
-	if (theGame.state != GS_SETUP)
-		AbortOnError(
-				"Call made to AddSensor() when game is not in setup state.\n"
-						"Program will end.");
-
-	if (port < 0 || port > MAX_SENSORS - 1)
-		return 0;
-
-	if (curRobot->sensorArray[port].type != SENSOR_NONE)
-		return 0;
-
-	angle = BoundAngle(angle);
-
-	if (type == SENSOR_RADAR) {
-		if (width < MIN_RADAR_ARC || width > MAX_RADAR_ARC)
-			return 0;
-
-		if (range < RADAR_MIN_RANGE || range > RADAR_MAX_RANGE)
-			return 0;
-
-		curRobot->sensorArray[port].image = create_bitmap(RADAR_IMAGE_PX,
-		RADAR_IMAGE_PX);
-		if (curRobot->sensorArray[port].image == NULL)
-			AbortOnError("AddSensor() failed to create a radar bitmap.\n"
-					"Program will end.");
-	} else if (type == SENSOR_RANGE) {
-		curRobot->sensorArray[port].image = NULL;
-		range = RANGE_MAX_RANGE;
-	} else
-		return 0;
-
-	curRobot->sensorArray[port].type = type;
-	curRobot->sensorArray[port].angle = angle;
-	curRobot->sensorArray[port].width = width;
-	curRobot->sensorArray[port].range = range;
-	curRobot->sensorArray[port].on = 1;
-	curRobot->sensorArray[port].powered = 0;
-	curRobot->sensorArray[port].data = -1;
-
-	return 1;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: EndCompetition
-//
-// Description: This function cleans up our allocated resources such as the
-//              linked lists, images, sounds, etc... as well as shutting down
-//              the Allegro graphics library.
-//
-// Parameters:  None.
-//
-// Change History: 19-23 July 2006 - When the linked list rework was done, this
-//                                   function changed to perform the cleanup
-//                                   of a) allocated memory for each element
-//                                   in a linked list, b) each element of in
-//                                   that list and finally c) the list.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void EndCompetition() {
-	int i;
-	ROBOT *tempRobot, *nextRobot;
-	WEAPON *tempWeapon, *nextWeapon;
-
-	//Move the dead robots back into the main list for deletion.
-	//deadRobotList should be empty after this loop has finished.
-	while (!IsEmptyLL(deadRobotList))
-		LinkAftLL(LastElmLL(robotList), UnlinkLL(FirstElmLL(deadRobotList)));
-
-	//Now iterate through each robot, cleaning up allocated memory
-	//and, when all memory is cleaned up, remove each one from the list.
-	SafeForeachLL_M(robotList, tempRobot, nextRobot)
-	//Has to be "safe" as
-	{                                                    //list elements will be
-		nextRobot = NextElmLL(tempRobot);                   //deleted during the
-		for (i = 0; i < MAX_SENSORS; i++)                       //iteration.
-			if (tempRobot->sensorArray[i].image != NULL)
-				destroy_bitmap(tempRobot->sensorArray[i].image); //Free sensor images.
-
-		if (tempRobot->graphic != NULL)
-			destroy_bitmap(tempRobot->graphic);        //Free custom images.
-		destroy_bitmap(tempRobot->image);            //Free robot bitmaps.
-		free(tempRobot->name);                       //Free robot name strings.
-
-		DestLL(tempRobot->mailBox);                  //Remove all messages.
-
-		DelElmLL(tempRobot);                   //Delete the robot from the list.
-	}
-
-	//Now clean up the weapon list, deleting each weapon.
-	SafeForeachLL_M(weaponList, tempWeapon, nextWeapon)
-	{
-		nextWeapon = NextElmLL(tempWeapon);
-		if (tempWeapon->image != NULL)
-			destroy_bitmap(tempWeapon->image);           //Free weapon images.
-		DelElmLL(tempWeapon);                          //Delete the weapon.
-	}
-
-	if (IsEmptyLL(robotList) && IsEmptyLL(deadRobotList)
-			&& IsEmptyLL(weaponList)) {
-		DestLL(robotList);
-		DestLL(deadRobotList);
-		DestLL(weaponList);
-	} else {
-		DestLL(robotList);
-		DestLL(deadRobotList);
-		DestLL(weaponList);
-		AbortOnError(
-				"EndCompetition() discovered one of the main linked lists was "
-						"not empty before deletion.\n"
-						"Program will now end.");
-	}
-
-	//Delete the sounds.
-	for (i = 0; i < NUM_SOUNDS; i++)
-		if (theGame.sounds[i] != NULL)
-			destroy_sample(theGame.sounds[i]);
-
-	clear_keybuf();                //Clean up Allegro and our graphics.
-	DeInitGraphics();
-
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SetMotorSpeeds
-//
-// Description: This function sets the robots tread speeds.  Speeds are a % of
-//              maximum, from 0 to 100, -ve to +ve.
-//
-// Parameters: int leftSpd - Left tread speed.
-//             int rightSpd - Right tread speed.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void SetMotorSpeeds(int leftSpd, int rightSpd) {
-	if (leftSpd < -100)
-		leftSpd = -100;
-	else if (leftSpd > 100)
-		leftSpd = 100;
-
-	if (rightSpd < -100)
-		rightSpd = -100;
-	else if (rightSpd > 100)
-		rightSpd = 100;
-
-	curRobot->leftTreadSpeed = leftSpd;
-	curRobot->rightTreadSpeed = rightSpd;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: TurboBoost
-//
-// Description: This function fires the turbo boost, if energy allows.
-//              The new firing "wastes" any time remaining in the previous turbo
-//              boost, if there was any.
-//
-// Parameters: None.
-//
-// Returns: int - 1 if Turbo was turned on, 0 otherwise.
-//
-////////////////////////////////////////////////////////////////////////////////
-int TurboBoost() {
-	if (curRobot->shields > TURBOBOOST_COST) {
-		curRobot->shields -= TURBOBOOST_COST;
-		curRobot->turboTime = TURBOBOOST_TIME * CALCS_PER_SEC;
-		theGame.playSound[SND_TURBOBOOST] = 1;
-		return 1;
-	}
-	return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: IsTurboOn
-//
-// Description: This function check if a turbo boost is currently firing.
-//
-// Parameters: None.
-//
-// Returns: int - 1 if Turbo is firing, 0 otherwise.
-//
-////////////////////////////////////////////////////////////////////////////////
-int IsTurboOn() {
-	if (curRobot->turboTime)
-		return 1;
-
-	return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetGPSInfo
-//
-// Description: This function fills out a GPS_INFO structure for the requesting
-//              robot.  Energy for the GPS use is dedected from the robot's
-//              shield capacitor.  If there in not sufficient energy, the
-//              request fails.
-//
-// Note: The heading is the same as that stored by the robot, so it is in
-//       math coordinates, with 0 being to the right and increasing counter-
-//       clockwise.
-//
-// Parameters: GPS_INFO *gpsData - Pointer to the structure to fill out.
-//
-// Returns: int - 1 if the request succeeds, 0 if it fails.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetGPSInfo(GPS_INFO *gpsData) {
-	if (curRobot->shields > GPS_COST) {
-		curRobot->shields -= GPS_COST;
-		gpsData->x = curRobot->x;
-		gpsData->y = curRobot->y;
-		gpsData->heading = curRobot->heading;
-		return 1;
-	}
-	return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetSensorData
-//
-// Description: This function returns a sensor's data, if the sensor is on
-//              and powered.
-//
-// Parameters: int port - The sensor port to read.
-//
-// Returns: int - The sensor's data.  If the port is invalid, or the sensor is
-//                off or unpowered this returns -1.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetSensorData(int port) {
-	if (port >= 0 && port < MAX_SENSORS)
-		if (curRobot->sensorArray[port].type != SENSOR_NONE)
-			if (curRobot->sensorArray[port].on
-					&& curRobot->sensorArray[port].powered)
-				return curRobot->sensorArray[port].data;
-
-	return -1;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SetSensorStatus
-//
-// Description: This function allows the user to turn a robot's sensor on/off.
-//
-// Parameters: int port - The sensor port to change.
-//             int status - 0 to turn off, non-zero to turn on.
-//
-// Returns: Nothing
-//
-////////////////////////////////////////////////////////////////////////////////
-void SetSensorStatus(int port, int status) {
-	if (status != 0)
-		status = 1;
-	if (port >= 0 && port < MAX_SENSORS)
-		curRobot->sensorArray[port].on = status;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: FireWeapon
-//
-// Description: This function fires the given weapon, if it is sufficiently
-//              powered and it meets firing arc requirements.
-//
-// Parameters: WEAPONTYPE type - The weapon to fire.
-//
-// Returns: int - 0 if weapon firing fails, 1 if successful.
-//
-////////////////////////////////////////////////////////////////////////////////
-int FireWeapon(WEAPONTYPE type, int heading) {
-	WEAPON_SYSTEM *weaponSys;
-	WEAPON weapon;
-	int imageX, imageY;
-
-	heading = heading % 360;     //Change heading so it is abs(heading)<360.
-	//Figure out which weapon is being examined and set the bitmap constants.
-	//Note: should the image vals be part of the weapon system for uniformity?
-	switch (type) {
-	case WEAPON_LASER:
-		weaponSys = &curRobot->weaponArray[LASER_PORT];
-		imageX = LASER_BMP_SZ;
-		imageY = LASER_BMP_SZ;
-		break;
-	case WEAPON_MISSILE:
-		weaponSys = &curRobot->weaponArray[MISSILE_PORT];
-		imageX = MISSILE_BMP_SZ;
-		imageY = MISSILE_BMP_SZ;
-		break;
-	default:
-		return 0;
-	}
-
-	//Check aiming and energy conditions.
-	if (heading < -weaponSys->maxAngle || heading > weaponSys->maxAngle)
-		return 0;
-	if (weaponSys->chargeEnergy < weaponSys->minEnergy) {
-		weaponSys->chargeEnergy = 0;     //Trying to fire without enough energy
-		return 0;                      //wastes the charged energy.
-	}
-
-	//Fill out remaining information and create the bitmap.
-	weapon.type = weaponSys->type;
-	weapon.owner = curRobot;
-	weapon.x = curRobot->x;
-	weapon.y = curRobot->y;
-	weapon.heading = BoundAngle(curRobot->heading - heading);
-	weapon.speed = weaponSys->speed;
-	weapon.energy = weaponSys->chargeEnergy
-			+ weaponSys->chargeEnergy * weaponSys->bonusEnergy;
-	weapon.splashRange = weaponSys->splashRange;
-	weapon.splashDamage = weaponSys->splashDamage;
-	weapon.bumpValue = weaponSys->bumpValue;
-	weapon.impactSound = weaponSys->impactSound;
-	weapon.image = create_bitmap(imageX, imageY);
-
-	weaponSys->chargeEnergy = 0;            //Weapon fired: reset charge energy.
-
-	InsLastLL(weaponList, weapon);                //Put the weapon in the list.
-	DrawWeaponBitmap(LastElmLL(weaponList));     //Pass the weapon for bmp draw.
-	theGame.playSound[weaponSys->firingSound] = 1; //Play the weapon firing sound.
-
-	return 1;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetSystemEnergy
-//
-// Description: This function returns the current amount of energy in the
-//              indicated system.
-//
-// Parameters: SYSTEM type - The system to check the power on.
-//
-// Returns: float - The power in the requested system.  -1 if an invalid
-//                  system was specified.
-//
-////////////////////////////////////////////////////////////////////////////////
-float GetSystemEnergy(SYSTEM type) {
-	switch (type) {
-	case SYSTEM_SHIELDS:
-		return curRobot->shields;
-	case SYSTEM_LASERS:
-		return (curRobot->weaponArray[LASER_PORT].chargeEnergy);
-	case SYSTEM_MISSILES:
-		return (curRobot->weaponArray[MISSILE_PORT].chargeEnergy);
-	default:
-		return -1;
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SetSystemChargeRate
-//
-// Description: This function sets the requested rate for a system to charge.
-//
-// Parameters: SYSTEM type - The system to set the charge rate for.
-//             int rate - The rate in units/min at which the system
-//             should charge.
-//
-// Returns: Nothing
-//
-////////////////////////////////////////////////////////////////////////////////
-void SetSystemChargeRate(SYSTEM type, int rate) {
-	if (rate < 0)
-		rate = 0;
-
-	//Since sensor "rates" can't be set, just check for shields, lasers, and
-	//missiles if they are within the correct charging bounds.  If not, bound
-	//them and set the rate.
-	switch (type) {
-	case SYSTEM_SHIELDS:
-		if (rate > MAX_SHIELD_CHARGE_RATE)
-			rate = MAX_SHIELD_CHARGE_RATE;
-		curRobot->shieldChargeRate = rate;
-		return;
-	case SYSTEM_LASERS:
-		if (rate > MAX_LASER_CHARGE_RATE)
-			rate = MAX_LASER_CHARGE_RATE;
-		curRobot->weaponArray[LASER_PORT].chargeRate = rate;
-		return;
-	case SYSTEM_MISSILES:
-		if (rate > MAX_MISSILE_CHARGE_RATE)
-			rate = MAX_MISSILE_CHARGE_RATE;
-		curRobot->weaponArray[MISSILE_PORT].chargeRate = rate;
-		return;
-	default:
-		return;
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SetSystemChargePriorities
-//
-// Description: This function records the robot's charging priorities.
-//
-// Parameters: int priorities - This is an array where each system must appear
-//                              once and only once or the function will not
-//                              change the priorities.  For example:
-//
-//                  priorities[0]=SYSTEM_MISSILES;
-//                  priorities[1]=SYSTEM_SHIELDS;
-//                  priorities[2]=SYSTEM_SENSORS;
-//                  priorities[3]=SYSTEM_LASERS;
-//
-// Returns: int - 1 if change was successful,
-//                0 otherwise.
-//
-////////////////////////////////////////////////////////////////////////////////
-int SetSystemChargePriorites(SYSTEM priorities[NUM_ENERGY_SYSTEMS]) {
-	int i, j;
-
-	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++) {
-		if (priorities[i] < 0 || priorities[i] > NUM_ENERGY_SYSTEMS - 1) //Check if valid
-			return 0;                                            //SYSTEM value.
-
-		for (j = i + 1; j < NUM_ENERGY_SYSTEMS; j++)   //Check for duplicates in
-			if (priorities[i] == priorities[j])          //the priority list.
-				return 0;
-	}
-
-	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++)                  //Write priorities
-		curRobot->energyPriorities[i] = priorities[i];          //into the list.
-	return 1;
-
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetBumpInfo
-//
-// Description: This function reports the bump information since the bump
-//              status was last checked.  Bump info is cleared after checking.
-//
-// Parameters: None.
-//
-// Returns: int - A number representing what has been bumped.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetBumpInfo(void) {
-	int tempBumpInfo = curRobot->bumped;
-	curRobot->bumped = BUMP_NONE;
-	return tempBumpInfo;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetGeneratorStructure
-//
-// Description: This function returns the remaining structure of the generator.
-//
-// Parameters: None.
-//
-// Returns: int - The remaining generator structure.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetGeneratorStructure(void) {
-	return curRobot->generatorStructure;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetGeneratorOutput
-//
-// Description: This function returns the remaining output of the generator
-//              in energy units/min.
-//
-// Parameters: None.
-//
-// Returns: int - The output of the generator.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetGeneratorOutput(void) {
-	return curRobot->generatorStructure * GENERATOR_CAPACITY
-			/ MAX_GENERATOR_STRUCTURE;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SetStatusMessage
-//
-// Description: This function allows the user to set the status message of the
-//              robot.
-//
-// Parameters: char *message - String to be recorded.  Max length is
-//                             STATUS_MSG_LEN (includes null char).  Messages
-//                             that exceed this length will cause program
-//                             termination.
-//
-// Bug Fixes: 19 July 2006 - Found that hasNull was initialized to 1, so calls
-//                           would never fail, no matter how long the message.
-//                           Additionally, the loop looking for the null char
-//                           was only checking the 0th character of the string
-//                           ie: message instead of message[i].
-//                           Update: August 1 2006 - This part of the function
-//                                   has been moved to its own function called
-//                                   HasNullCharacter()
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void SetStatusMessage(char *message) {
-
-	if (!HasNullCharacter(message, STATUS_MSG_LEN)) {
-		char errorMessage[100 + MAX_NAME_LEN];        //Only create if required.
-		sprintf(errorMessage, "%s did not have a properly formatted string "
-				"in its call to SetStatusMessage().\n"
-				"Program will end.", curRobot->name);
-		AbortOnError(errorMessage);
-	} else
-		strcpy(curRobot->statusMessage, message);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: SendMessage
-//
-// Description: This function allows a robot to send a message to another robot
-//              if they know its name.
-//
-// Parameters: char *robotName - The name of the destination robot.
-//             INT_32 data - INT_32 is a platform specific type defined in
-//                           competition.h and is a 32 bit integer.  This is the
-//                           data being sent.
-//
-// Returns: int - 1 if message was successfully delivered.
-//                0 if robot was not found (name wrong or robot dead).
-//
-////////////////////////////////////////////////////////////////////////////////
-int SendMessage(char *robotName, INT_32 data) {
-	ROBOT *addressee;
-	if (!HasNullCharacter(robotName, MAX_NAME_LEN)) {
-		char errorMessage[100 + MAX_NAME_LEN];        //Only create if required.
-		sprintf(errorMessage,
-				"%s did not have a properly formatted name string "
-						"in its call to SendMessage().\n"
-						"Program will end.", curRobot->name);
-		AbortOnError(errorMessage);
-	}
-
-	if ((addressee = LookupRobotByName(robotName)) != NULL) {
-		InsLastLL(addressee->mailBox, data);
-		return 1;
-	}
-	return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetMessage
-//
-// Description: This function reads a message from a robot's mailbox.  When the
-//              message is read, it is deleted from the mailbox.
-//
-// Parameters: INT_32 *data - A pointer to a 32-bit integer that will be filled
-//                            out with the message from the mailbox.
-//
-// Returns: int - 0 if the mailbox was empty and no data was returned.
-//                1 if the mailbox contained a message which was returned.
-//
-////////////////////////////////////////////////////////////////////////////////
-int GetMessage(INT_32 *data) {
-	if (!IsEmptyLL(curRobot->mailBox))                //There are messages...
-			{
-		*data = *(int*) FirstElmLL(curRobot->mailBox);    //Get the data out.
-		DelElmLL(FirstElmLL(curRobot->mailBox));       //Delete the message.
-		return 1;
-	}
-	return 0;                                        //No messages.
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: AbortOnError
-//
-// Description: This function reports an error to the user and exits
-//              the program.
-//
-// Parameters: char *message - The error message to show the user.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void AbortOnError(char *message) {
-	allegro_message(message);
-	exit(-1);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: GetRandomNumber
-//
-// Description: This function returns a random integer in the range
-//              0<=x<upperBound.
-//
-// Parameters: int upperBound - The upper bound of numbers.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-float GetRandomNumber(int upperBound) {
-	return upperBound * rand() / (RAND_MAX + 1.0);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: HasNullCharacter
-//
-// Description: This function checks if a string contains a null character
-//              within a specified length.
-//
-// Parameters: char *string - The string to test
-//             int   numChars - The maximum length of the string.  If properly
-//                              formatted, a null character will exist within
-//                              the string.
-//
-// Returns: int - 1 if the string contains a null character
-//                0 otherwise.
-//
-////////////////////////////////////////////////////////////////////////////////
-static int HasNullCharacter(char *string, int numChars) {
-	int i;
-
-	for (i = 0; i < numChars - 1; i++)
-		if (string[i] == '\0')
-			return 1;
-
-	return 0;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: LookupRobotByName
-//
-// Description: This function finds the pointer of another robot in the linked
-//              list by using the name of the robot.
-//
-// Notes: This function simply iterates through the linked list looking for the
-//        named robot.  If there is ever a significant number of robots in the
-//        competition (and I don't know what that is, but I suspect over 100 or
-//        so) this would no longer suffice.  Instead, a hash would likely have
-//        to be created to quickly find the robot in question.
-//
-// Parameters: char *name - The name of the robot to find.
-//
-// Returns: ROBOT* - Pointer to the robot.  If the robot was not found in the
-//                   list (because the name is bad or the robot is dead) NULL
-//                   is returned.
-//
-////////////////////////////////////////////////////////////////////////////////
-static ROBOT *LookupRobotByName(char *name) {
-	ROBOT *theRobot;
-
-	ForeachLL_M(robotList, theRobot)
-	{
-		if (!strcmp(theRobot->name, name))
-			return theRobot;
-	}
-	return NULL;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: BoundAngle
-//
-// Description: This is a short utility function to ensure an angle is within
-//              a range of 0<=angle<360
-//
-// Parameters: int angle - The angle to be bounded.
-//
-// Returns: int - The bounded angle.
-//
-////////////////////////////////////////////////////////////////////////////////
-static int BoundAngle(int angle) {
-	while (angle > 360)
-		angle -= 360;
-	while (angle < 360)
-		angle += 360;
-	return angle;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: ChooseRandomLocation
-//
-// Description: This function chooses a random x/y location for a robot.  The
-//              location will be at least MIN_RANDOM_DIST cm away from each
-//              other robot The function will make 1000 attempts to find a non-
-//              colliding location, and then give up.
-//
-// Parameters: ROBOT *robot - The robot to move.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-static void ChooseRandomLocation(ROBOT *robot) {
-	int dx, dy, success, attempts = 1000;
-	double dist;
-	ROBOT *tmpRob;                         //Robot pointer iterator.
-
-	while (attempts--) {
-		//Choose a random location within the arena.
-		robot->x = GetRandomNumber(
-		ARENA_WIDTH_CM - SHIELD_RAD_CM * 2) + SHIELD_RAD_CM;
-		robot->y = GetRandomNumber(
-		ARENA_HEIGHT_CM - SHIELD_RAD_CM * 2) + SHIELD_RAD_CM;
-
-		if (SizeLL(robotList) == 1) //No need to check for collisions if this is
-			return;                   //the only robot.
-
-		//Iterate through each other robot.  If the distance is less than that
-		//allowed, record a failure and break to start next attempt.
-		success = 1;
-		for (tmpRob = FirstElmLL(robotList); IsElmLL(tmpRob); tmpRob =
-				NextElmLL(tmpRob)) {
-			if (tmpRob != robot)           //Don't check if too close to itself.
-					{
-				dx = robot->x - tmpRob->x;
-				dy = robot->y - tmpRob->y;
-				dist = sqrt(pow(dx, 2) + pow(dy, 2));
-				if (dist < (SHIELD_RAD_CM * 2 + MIN_RANDOM_DIST)) {
-					success = 0;
-					break;
-				}
-			}
-		}
-		if (success)
-			return;
-	}
-
-	AbortOnError("ChooseRandomLocation() could not find a place for this robot "
-			"that did not collide with another robot.\n"
-			"Program will end.");
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: PlaySounds
-//
-// Description: This function plays sounds based on the requests in the game's
-//              state.  Once fulfilled, these requests are turned off.
-//
-// Parameters: GAME *game - Pointer to the game's state.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-static void PlaySounds(GAME *game) {
-	int i;
-	for (i = 0; i < NUM_SOUNDS; i++)
-		if (game->playSound[i]) {
-			play_sample(game->sounds[i], 255, 128, 1000, 0);
-			game->playSound[i] = 0;
-		}
-}
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: competition.c
+//
+// Description:
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 6 Mar 2006 - Created
+//                  18 Apr 2006 - Bugs fixed in RegisterRobot().
+//                  19 Jul 2006 - Bug fixed in SetStatusMessage().
+//                  19 Jul 2006 - Major rework to change robot data from array
+//                                to linked list.  LL docs found at:
+//                                http://cmp.felk.cvut.cz/~matas/surrey/
+//                                                             software/LL.html
+//                  20 Jul 2006 - Added gamestate GS_SETUP and added checks in
+//                                RegisterRobot() and AddSensor() to ensure
+//                                they are called only during game setup.
+//                                Note that through a couple of tricks it is
+//                                still possible for a robot to add another
+//                                robot during its own setup, but it's not
+//                                worth coding the code to stop it as this
+//                                cheat would be plainly evident.
+//                  23 Jul 2006 - Changed the way weapons function to have them
+//                                exist as systems in the robot before firing,
+//                                but create a weapon in a linked list after
+//                                firing.  This greatly simplifies iterating
+//                                through weapons in other files.  Changes here
+//                                include some in InitCompetition() and
+//                                Fight(), but more in FireWeapon(), and
+//                                EndCompetition().  As part of these changes,
+//                                weapons were also standardized.  For example,
+//                                lasers now have a splash damage that is
+//                                treated the same as missiles, but it happens
+//                                to be for 0 range and 0 damage.
+//                   1 Aug 2006 - Added a range of new functions:
+//                                   - SendMessage()
+//                                   - GetMessage()
+//                                   - HasNullCharacter()
+//                                   - LookupRobotByName()
+//                                Also changed all "internal" functions to
+//                                static to protect newer functions such as
+//                                LookupRobotByName(), which could have easily
+//                                broken the internal game "secrets".
+//                   6 Sep 2006 - Changed RegisterRobot() to allow for custom
+//                                robot graphics and start locations.
+//                              - Changed ChooseRandomLocation() so that robots
+//                                are placed anywhere on the screen but keep at
+//                                least MIN_RANDOM_DIST cm from each other.
+//                  10 Apr 2007 - New functions TurboBoost() and IsTurboOn().
+//                                New sound in global sound file array.
+//                  18 Oct 2026 - Heading trig is cached on robots and weapons.
+//                                RegisterRobot(), FireWeapon() and the 'R' key
+//                                handler in Fight() now fill the cache.
+//                  18 Oct 2026 - InitCompetition() and EndCompetition() start
+//                                and stop the job system.
+//                  18 Oct 2026 - The robot API no longer changes robots or
+//                                the weapon list directly.  Reads come from
+//                                the robot's ROBOT_VIEW and changes are
+//                                recorded in its COMMAND_BUFFER, which Fight()
+//                                applies once every robot has given orders.
+//                                Messages sent to a robot can now be read on
+//                                its next turn.
+//                  18 Oct 2026 - With PARALLEL_ORDERS defined, Fight() runs
+//                                the robots' orders functions on the job
+//                                system.  curRobot is now thread-local and
+//                                each robot draws from its own random number
+//                                stream so results don't depend on timing.
+//                  18 Oct 2026 - With PIPELINED_ORDERS defined, orders are
+//                                given in the background and applied one
+//                                order period later.
+//                  18 Oct 2026 - With SANDBOX_ROBOTS defined, Fight() starts
+//                                a child process for each robot to give its
+//                                orders in.  See sandbox.c.
+//                  18 Oct 2026 - New function RegisterRemoteRobot().  Remote
+//                                robots' orders are exchanged with their
+//                                brains during the order phase and given
+//                                through the robot API.  See remote.h.
+//                  18 Oct 2026 - New function ReplaceRobotFunctions().
+//                  18 Oct 2026 - New function ResetMatch() starts another
+//                                match with the robots already registered.
+//                                RegisterRobot() split into InitRobotState()
+//                                and SetUpRobot() so ResetMatch() can share
+//                                them.  GetRandomNumber() now uses its own
+//                                seedable stream instead of rand().
+//                  18 Oct 2026 - New functions SaveMatch() and RestoreMatch()
+//                                snapshot the whole match.  Fight() counts
+//                                ticks in matchTick so a snapshot knows where
+//                                it is in the order period.
+//                  18 Oct 2026 - A calculation moved from Fight() to
+//                                RunCalculation() so RunMatch() can run
+//                                headless matches flat out.  New function
+//                                SetHeadless().
+//                  18 Oct 2026 - Matches end when one robot is left, at a
+//                                time limit or in a stalemate (no damage and
+//                                no weapon fired for a while).  Fight() then
+//                                shows the winner until ESC is pressed.  New
+//                                functions SetMatchLimits() and
+//                                GetMatchResult().
+//                  18 Oct 2026 - New function RecordMatch() records the
+//                                match calculation by calculation.  Weapons
+//                                are numbered as they are fired, and sounds
+//                                are cleared every calculation even when
+//                                they aren't played.
+//                  18 Oct 2026 - New functions LogMatchCommands() and
+//                                ResimulateMatch() log the commands applied
+//                                to each robot and play them back without
+//                                the robots' code.  SetUpRobot() keeps each
+//                                robot's configuration orders for the log.
+//                  18 Oct 2026 - New function ChecksumMatch() writes a hash
+//                                of the state after every calculation.
+//                  18 Oct 2026 - InitRobotState() is public, for tools that
+//                                build their own arenas.
+//                  18 Oct 2026 - RunCalculation() and Fight() mark the end of
+//                                each stage and frame (see profile.h).  'T'
+//                                toggles the timing overlay.
+//                  18 Oct 2026 - Calculations, robot turns and weapons fired
+//                                are traced (see trace.h).  EndCompetition()
+//                                writes the trace.
+//                  18 Oct 2026 - With the hardware counters on, each robot's
+//                                orders are counted and the counts printed
+//                                when the match ends (see perfcount.h).
+//                  18 Oct 2026 - Lists and bitmaps are counted in the memory
+//                                accounts (see memstats.h), and each
+//                                calculation marked for the allocation rate.
+//                                EndCompetition() reports the accounts.
+//                  18 Oct 2026 - Each robot's turns are timed and its API
+//                                calls counted (see robotprof.h), and the
+//                                profiles printed when the match ends.  New
+//                                function GetRobotProfile().
+//                  18 Oct 2026 - A robot that gives more than MAX_COMMANDS
+//                                commands in a turn has the rest dropped and
+//                                counted, rather than ending the program.
+//                                Messages sent have a store of their own that
+//                                grows as needed.  Only the first fire
+//                                command for a weapon in a turn is kept.
+//                  18 Oct 2026 - RestoreMatch() checks the whole snapshot
+//                                before changing anything, and puts robots'
+//                                statics back if one can't be loaded.
+//                  18 Oct 2026 - A remote robot whose brain can't be reached
+//                                or doesn't configure it is left idle,
+//                                rather than ending the program.
+//
+// TODO: 1) Add a detector for an infinite loop on a robot's turn.
+//
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>                       //For sprintf(), srand, and rand
+#include <time.h>                        //For system time.
+#include <string.h>
+#include <stddef.h>                      //For offsetof().
+#include <limits.h>                      //For INT_MAX.
+#include <math.h>
+#include "competition.h"
+#include "physics.h"
+#include "graphics.h"
+#include "particles.h"
+#include "jobs.h"
+#include "threads.h"
+#include "sandbox.h"
+#include "remote.h"
+#include "recorder.h"
+#include "cmdlog.h"
+#include "checksum.h"
+#include "profile.h"
+#include "timing.h"
+#include "trace.h"
+#include "perfcount.h"
+#include "memstats.h"
+#include "robotprof.h"
+
+static GAME theGame;
+static t_LL robotList;        //Holds list of all robots.
+static t_LL deadRobotList;    //Holds list of destroyed robots.
+static THREAD_LOCAL ROBOT *curRobot = NULL;  //Used when robots are giving
+                                             //orders, on each thread.
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+static ELEMENT_ARRAY orderArray;   //Robots giving orders, in list order, and
+static int orderGroups[MAX_ROBOTS];  //the first robot using the same orders
+                                     //function as each of them.
+static JOB_BATCH orderBatch;       //Jobs for the orders being given.
+#endif
+static int orderTick = 0;          //Order phases so far.
+static int matchTick = 0;          //Calculations so far this match.
+static int remoteGps[MAX_ROBOTS];  //Remote robots that paid for GPS.
+static REMOTE *pendingRemote;      //Connection for the robot being registered.
+static REMOTE_COMMAND remoteCommands[MAX_COMMANDS];
+static t_LL weaponList;       //Weapons that have been fired.
+static char *robotNames[MAX_ROBOTS];  //Names and alive status by robot number,
+static int robotAlive[MAX_ROBOTS];    //as of the start of the order phase.
+static unsigned int gameRandomState;  //GetRandomNumber() stream for the game.
+static int matchCalcLimit = MATCH_CALC_LIMIT;  //See SetMatchLimits().
+static int stalemateLimit = STALEMATE_CALCS;
+static int lastAction = 0;            //matchTick of the last damage or shot.
+static MATCH_END matchEnd = MATCH_RUNNING;
+static int nextWeaponId = 0;          //Id of the next weapon fired.
+static RECORDER *recorder = NULL;     //See RecordMatch().
+static COMMAND_LOG *commandLog = NULL;     //See LogMatchCommands().
+static COMMAND_LOG *loggedCommands = NULL; //See ResimulateMatch().
+static CHECKSUM_FILE *checksums = NULL;    //See ChecksumMatch().
+static COMMAND_BUFFER setupOrders[MAX_ROBOTS];  //Configuration orders and
+static char setupMessages[MAX_ROBOTS][STATUS_MSG_LEN];  //status message,
+                                                        //by robot number.
+static PERF_COUNTS robotCounts[MAX_ROBOTS];  //Hardware counts of each
+static int robotTurns[MAX_ROBOTS];           //robot's orders, by number.
+static ROBOT_PROFILE robotProfiles[MAX_ROBOTS];  //By robot number.
+static char *matchEndNames[] = { "running", "knockout", "time limit",
+		"stalemate" };
+
+volatile int calcCounter = 0;
+volatile int calcsCompleted = 0, cps = 0;
+volatile int frameCounter = 0, fps = 0;
+
+static char *soundFileNames[NUM_SOUNDS] = { "..\\resources\\sounds\\laser.wav",
+		"..\\resources\\sounds\\laserhit.wav",
+		"..\\resources\\sounds\\missile.wav",
+		"..\\resources\\sounds\\missilehit.wav",
+		"..\\resources\\sounds\\fight.wav",
+		"..\\resources\\sounds\\robotscollide.wav",
+		"..\\resources\\sounds\\robotexplode.wav",
+		"..\\resources\\sounds\\turboboost.wav" };
+
+//Internal Helper Prototypes.  These are static
+//to protect them from being called by a robot.
+static int HasNullCharacter(char *string, int numChars);
+static int LookupRobotByName(char *name);
+static int BoundAngle(int angle);
+static void ChooseRandomLocation(ROBOT *robot);
+static void PlaySounds(GAME *game);
+static void StartMatch(void);
+static void RunCalculation(void);
+static int CheckMatchEnd(void);
+static void StopRecording(void);
+static void StopLoggingCommands(void);
+static void LogRobotOrders(ROBOT *robot);
+static void StopChecksums(void);
+static void PrintMatchCounts(void);
+static void PrintMatchProfiles(void);
+static void SetUpRobot(ROBOT *robot);
+static unsigned int NextRandom(unsigned int *state);
+static void SaveRobot(SNAPSHOT *snapshot, ROBOT *robot);
+static int CheckMatch(SNAPSHOT *snapshot, ROBOT **byNumber, ROBOT **order,
+		void **states, int *stateSizes);
+static int CheckListOrder(SNAPSHOT *snapshot, ROBOT **byNumber, ROBOT **order,
+		int *listed);
+static int CheckRobot(SNAPSHOT *snapshot, ROBOT *robot, void **state,
+		int *stateSize);
+static int CheckWeapons(SNAPSHOT *snapshot, ROBOT **byNumber);
+static int LoadRobotStates(ROBOT **order, int count, void **states,
+		int *stateSizes);
+static void RestoreRobot(SNAPSHOT *snapshot, ROBOT *robot);
+static void RestoreWeapons(SNAPSHOT *snapshot, ROBOT **byNumber);
+static void RestoreListOrder(SNAPSHOT *snapshot, t_LL list, ROBOT **byNumber);
+static void TakeRobotViews(void);
+#ifndef PIPELINED_ORDERS
+static void GiveOrders(void);
+#endif
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+static void StartOrders(void);
+static void GiveGroupOrders(void *data, int begin, int end);
+#endif
+static void FinishOrders(void);
+static void GiveRobotOrders(ROBOT *robot);
+static void RunRobotTurn(ROBOT *robot);
+static void ConfigureRemoteRobot(void);
+static void RemoteRobotActions(int time);
+static void ExchangeRemoteOrders(void);
+static void GiveRemoteOrders(ROBOT *robot, REMOTE_COMMAND *commands,
+		int count);
+static void ReadLoggedCommands(void);
+static void ConfigurePuppet(void);
+static void PuppetActions(int time);
+
+//Robot API functions that aren't in competition.h.
+int SendMessage(char *robotName, INT_32 data);
+int GetMessage(INT_32 *data);
+static void TakeRobotView(ROBOT *robot);
+static COMMAND *FindCommand(COMMANDTYPE type, int replace, int key);
+static COMMAND *NewCommand(COMMANDTYPE type, int replace, int key);
+static void ApplyOrders(void);
+static void ApplyRobotOrders(ROBOT *robot);
+static int ApplyFireWeapon(ROBOT *robot, WEAPONTYPE type, int heading);
+static ROBOT *LookupRobotByNumber(int number);
+
+//Values for the replace parameter of NewCommand().
+#define NEW_COMMAND      0     //Always add a new command.
+#define REPLACE_TYPE     1     //Reuse an earlier command of the same type.
+#define REPLACE_TARGET   2     //Reuse one of the same type and args[0].
+
+//Counts a robot API call against the robot giving orders.
+#define CountCall_M(call) \
+	CountRobotCall_M(&robotProfiles[curRobot->number], (call))
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Name: AddCalc
+//
+// Description: This is the timer interrupt handler for calculation counts.
+//              It should be called CALCS_PER_SEC times each second.  All that
+//              is performed is a record of the number of calculations to
+//              perform the next time a game loop runs.  This way the robots
+//              will move at the same speed irrespective of the refresh rate
+//              of the monitor.
+//
+//              Because timers are actually implemented as threads, the
+//              following rules must be followed for proper Allegro timer ops:
+//                - Globals accessed here must be declared volatile AND must be
+//                  locked in the initialization code.
+//                - The function itself must be locked in the initialization.
+//                - Function must end with the macro END_OF_FUNCTION(AddCalc)
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AddCalc(void) {
+	calcCounter++;
+}
+END_OF_FUNCTION(AddCalc)
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Name: SecondTimer
+//
+// Description: This is the timer interrupt handler that increments once per
+//              second.  This is used to calculate the frames per second.
+//              and calculations performed per second.  This function and the
+//              variables frameCounter, fps, calcsCompleted, and cps are
+//              subject to all the same restrictions described in AddCalc().
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void FPSTimer(void) {
+	fps = frameCounter;
+	frameCounter = 0;
+	cps = calcsCompleted;
+	calcsCompleted = 0;
+}
+END_OF_FUNCTION(SecondTimer)
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Fight
+//
+// Description: This is heart of the Robot Wars competition.  It installs the
+//              required timers (including locking the related variables) and
+//              then enters the main game loop.  In that loop, the robots are
+//              updated based on the number of remaining calculations to
+//              perform.  Only once calcCounter has been reduced to 0 is the
+//              scene drawn.
+//
+// Note: While not a bug per se, if run on a crappy system, or with too many
+//       robots, this system can result in no scenes being rendered for periods
+//       of time, or even the duration of the competition.  I need to add a
+//       sanity check that will still render at least 1 frames/s even if the
+//       overall speed of the simulation drops.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void Fight(void) {
+	int keyPress, backlog;
+	char systemMessage[255] = "";
+	ROBOT *robot;
+	MATCH_RESULT result;
+	long long frameStart, renderStart;
+
+	LOCK_VARIABLE(calcCounter);LOCK_VARIABLE(calcsCompleted);LOCK_VARIABLE(cps);LOCK_VARIABLE(frameCounter);LOCK_FUNCTION(fps);LOCK_FUNCTION(AddCalc);
+
+	if (install_int_ex(AddCalc, BPS_TO_TIMER(CALCS_PER_SEC)) != 0)
+		AbortOnError(
+				"Fight() failed to create calcs timer.\nProgram will exit.");
+
+	if (install_int_ex(FPSTimer, SECS_TO_TIMER(1)) != 0)
+		AbortOnError("Fight() failed to create FPS timer.\nProgram will exit.");
+
+	while (!key[KEY_SPACE])
+		;  //Wait for screen to initialize before starting.
+
+	StartMatch();
+
+	frameStart = ReadTimer();
+	while (!key[KEY_ESC]) {
+
+		if (keypressed())                          //Check for relevant keys.
+		{
+			keyPress = readkey() & 0xff;
+			if (keyPress == 'r' || keyPress == 'R') //User wants re-randomized loc's.
+				ForeachLL_M(robotList, robot)
+				{
+					ChooseRandomLocation(robot);
+					robot->heading = GetRandomNumber(360);
+					UpdateHeadingTrig(robot);
+				}
+			else if (keyPress == 't' || keyPress == 'T')   //Timing overlay.
+				ToggleTimingOverlay();
+		}
+
+		backlog = calcCounter;
+		while (calcCounter) {
+			calcCounter--;
+			if (theGame.state != GS_FIGHTING)
+				continue;                //Match over, only the scene is drawn.
+			RunCalculation();
+			calcsCompleted++;
+			CheckMatchEnd();
+		}
+
+		if (theGame.state == GS_OVER) {
+			GetMatchResult(&result);
+			if (result.winner >= 0)
+				sprintf(systemMessage, "Match over (%s): %s wins.  ESC to exit.",
+						matchEndNames[result.end], robotNames[result.winner]);
+			else
+				sprintf(systemMessage, "Match over (%s): no winner.  ESC to "
+						"exit.", matchEndNames[result.end]);
+		} else
+			sprintf(systemMessage, "FPS: %d  CPS: %d", fps, cps);
+		renderStart = StartStage();
+		RenderScene(robotList, deadRobotList, weaponList, systemMessage);
+		MarkStage(TS_RENDER, renderStart);
+		frameCounter++;
+		frameStart = MarkFrame(frameStart, backlog);
+	}
+
+	FinishOrders();             //Robots may still be giving orders in the
+	StopRecording();            //background.  Wait before they're freed.
+	StopLoggingCommands();
+	StopChecksums();
+	if (theGame.state != GS_OVER) {
+		PrintMatchCounts();     //Otherwise printed as the match ended.
+		PrintMatchProfiles();
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunMatch
+//
+// Description: This function runs the match as fast as it can, without
+//              timers, rendering, keyboard or sound, until it ends (see
+//              SetMatchLimits()).  It is how headless matches are played;
+//              Fight() is still used for matches that are watched.
+//
+// Parameters: MATCH_RESULT *result - Filled with how the match ended.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RunMatch(MATCH_RESULT *result) {
+	StartMatch();
+	while (!CheckMatchEnd())
+		RunCalculation();
+	GetMatchResult(result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetMatchLimits
+//
+// Description: This function sets when a match with more than one robot
+//              still fighting is called.  A match with more than one robot
+//              registered always ends once at most one is left.  With no
+//              limits and robots that never finish each other off, a match
+//              run by RunMatch() never ends.
+//
+// Parameters: int maxCalcs - The longest a match may last, or 0 for no limit.
+//                            MATCH_CALC_LIMIT by default.
+//             int stalemateCalcs - How long a match may go with no damage
+//                                  done and no weapon fired, or 0 for no
+//                                  limit.  STALEMATE_CALCS by default.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetMatchLimits(int maxCalcs, int stalemateCalcs) {
+	matchCalcLimit = maxCalcs;
+	stalemateLimit = stalemateCalcs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetMatchResult
+//
+// Description: This function reports how the match ended, or how it stands
+//              if it hasn't.  The winner is the robot left standing with the
+//              most generator structure, then the most shields, then the
+//              lowest robot number, so a match called at a limit always has
+//              the same winner.  There is no winner if every robot is dead.
+//
+// Parameters: MATCH_RESULT *result - Filled with the result.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GetMatchResult(MATCH_RESULT *result) {
+	ROBOT *robot, *best = NULL;
+
+	result->end = matchEnd;
+	result->calcs = matchTick;
+	result->numRobots = SizeLL(robotList) + SizeLL(deadRobotList);
+	ForeachLL_M(robotList, robot)
+	{
+		result->alive[robot->number] = 1;
+		result->shields[robot->number] = robot->shields;
+		result->generatorStructure[robot->number] = robot->generatorStructure;
+		if (best == NULL
+				|| robot->generatorStructure > best->generatorStructure
+				|| (robot->generatorStructure == best->generatorStructure
+						&& (robot->shields > best->shields
+								|| (robot->shields == best->shields
+										&& robot->number < best->number))))
+			best = robot;
+	}
+	ForeachLL_M(deadRobotList, robot)
+	{
+		result->alive[robot->number] = 0;
+		result->shields[robot->number] = 0;
+		result->generatorStructure[robot->number] = 0;
+	}
+	result->winner = best != NULL ? best->number : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetRobotProfile
+//
+// Description: This function gives a robot's profile (see robotprof.h): its
+//              turns and API calls since the match started.  Orders being
+//              given in the background are finished first.
+//
+// Parameters: int number - The robot's number.
+//             ROBOT_PROFILE *profile - Filled with its profile, or emptied if
+//                                      there is no such robot.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GetRobotProfile(int number, ROBOT_PROFILE *profile) {
+	FinishOrders();
+	if (number >= 0 && number < MAX_ROBOTS)
+		*profile = robotProfiles[number];
+	else
+		ClearRobotProfile(profile);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RecordMatch
+//
+// Description: This function records the match to a file, one frame for
+//              each calculation (see recorder.h).  Call it once the robots
+//              are registered, or after ResetMatch(), and before Fight() or
+//              RunMatch().  The recording ends with the match, or when
+//              ResetMatch() or EndCompetition() is called before it ends.
+//              Any recording already being made is ended first.
+//
+// Parameters: char *fileName - The file to record to.  It is replaced.
+//
+// Returns: int - 1 if recording, 0 if the file couldn't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+int RecordMatch(char *fileName) {
+	StopRecording();
+	recorder = StartRecorder(fileName, robotList, deadRobotList);
+	if (recorder == NULL)
+		return 0;
+	RecordCalculation(recorder, matchTick, robotList, deadRobotList,
+			weaponList, theGame.playSound);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LogMatchCommands
+//
+// Description: This function logs what goes into the match: where each
+//              robot starts, its sensors, the game's random number stream
+//              and the commands applied to each robot, configuration orders
+//              included (see cmdlog.h).  ResimulateMatch() plays the log
+//              back.  Call it once the robots are registered, or after
+//              ResetMatch(), and before Fight() or RunMatch().  The log ends
+//              with the match, or when ResetMatch(), RestoreMatch() or
+//              EndCompetition() is called before it ends.  Any log already
+//              being written is ended first.
+//
+// Parameters: char *fileName - The file to log to.  It is replaced.
+//
+// Returns: int - 1 if logging, 0 if the match has started or the file
+//                couldn't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+int LogMatchCommands(char *fileName) {
+	COMMAND_LOG_HEADER header;
+	COMMAND_LOG_ROBOT *logged;
+	ROBOT *robot;
+	int i;
+
+	StopLoggingCommands();
+	if (matchTick != 0 || !IsEmptyLL(deadRobotList))
+		return 0;
+
+	memset(&header, 0, sizeof(header));
+	header.numRobots = SizeLL(robotList);
+	header.randomState = gameRandomState;
+	header.matchCalcLimit = matchCalcLimit;
+	header.stalemateLimit = stalemateLimit;
+	ForeachLL_M(robotList, robot)
+	{
+		logged = &header.robots[robot->number];
+		strncpy(logged->name, robot->name, MAX_NAME_LEN);
+		logged->color = robot->color;
+		logged->x = robot->x;
+		logged->y = robot->y;
+		logged->heading = robot->heading;
+		for (i = 0; i < MAX_SENSORS; i++) {
+			logged->sensors[i].type = robot->sensorArray[i].type;
+			logged->sensors[i].angle = robot->sensorArray[i].angle;
+			logged->sensors[i].width = robot->sensorArray[i].width;
+			logged->sensors[i].range = robot->sensorArray[i].range;
+		}
+	}
+
+	commandLog = StartCommandLog(fileName, &header);
+	if (commandLog == NULL)
+		return 0;
+	for (i = 0; i < header.numRobots; i++)   //Applied in SetUpRobot().
+		LogOrders(commandLog, 0, i, &setupOrders[i], setupMessages[i]);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ChecksumMatch
+//
+// Description: This function writes a hash of the state of the match after
+//              each calculation to a file (see checksum.h), for
+//              tools/hashdiff to compare with another run of the match.
+//              Call it when RecordMatch() would be called.  The file ends
+//              with the match, or when ResetMatch() or EndCompetition() is
+//              called before it ends.  Any checksum file already being
+//              written is ended first.
+//
+// Parameters: char *fileName - The file to write.  It is replaced.
+//
+// Returns: int - 1 if writing checksums, 0 if the file couldn't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ChecksumMatch(char *fileName) {
+	StopChecksums();
+	checksums = OpenChecksumFile(fileName, robotList, deadRobotList);
+	if (checksums == NULL)
+		return 0;
+	WriteChecksum(checksums, matchTick, robotList, deadRobotList, weaponList,
+			gameRandomState);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ResimulateMatch
+//
+// Description: This function sets up the match logged by LogMatchCommands()
+//              so Fight() or RunMatch() plays it again, calculation for
+//              calculation, without the robots' code.  A puppet robot is
+//              registered for each logged one, set up as it was, and at
+//              every order tick it is given the commands that were applied
+//              to it.  The match limits are set as they were.  It must be
+//              called after InitCompetition() and before any robot is
+//              registered.  ResetMatch() starts the same match over, and
+//              RestoreMatch() carries on from the snapshot's calculation.
+//              Once the log runs out the puppets give no more orders.
+//
+// Parameters: char *fileName - The log.
+//
+// Returns: int - 1 if set up, 0 if the log can't be read, is damaged or is
+//                from a build with another ORDER_FREQ.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ResimulateMatch(char *fileName) {
+	COMMAND_LOG_HEADER *header;
+	COMMAND_LOG_ROBOT *logged;
+	int i;
+
+	if (theGame.state != GS_SETUP || !IsEmptyLL(robotList)
+			|| loggedCommands != NULL)
+		AbortOnError("ResimulateMatch() must be called before any robot is "
+				"registered.\nProgram will end.");
+
+	loggedCommands = OpenCommandLog(fileName);
+	if (loggedCommands == NULL)
+		return 0;
+	header = GetLoggedHeader(loggedCommands);
+	for (i = 0; i < header->numRobots; i++) {   //Placed by ConfigurePuppet().
+		logged = &header->robots[i];
+		RegisterRobot(logged->name, ROBOT_WHITE, PuppetActions,
+				ConfigurePuppet, NULL, (int) logged->x, (int) logged->y,
+				logged->heading);
+	}
+	gameRandomState = header->randomState;
+	SetMatchLimits(header->matchCalcLimit, header->stalemateLimit);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetHeadless
+//
+// Description: This function makes the competition run without a window,
+//              keyboard, timers or sound, for matches run by RunMatch() on
+//              machines with no display.  Images are still drawn, to memory,
+//              as the physics need them.  It must be called before
+//              InitCompetition(), and Fight() can't be used afterwards.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetHeadless(void) {
+	if (theGame.state != GS_SETUP || robotList != NULL)
+		AbortOnError("SetHeadless() must be called before InitCompetition()."
+				"\nProgram will end.");
+	theGame.headless = 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitCompetition
+//
+// Description: This function sets up the robot list, the Allegro library,
+//              sets up and loads in the sounds, and calls the function to
+//              initialize the graphics.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitCompetition() {
+	int i;
+
+	theGame.state = GS_SETUP;    //Record game state.
+	robotList = ConsLL();        //Create the robot linked list.
+	deadRobotList = ConsLL();    //Create the destroyed robots linked list.
+	weaponList = ConsLL();
+	AccountLL(robotList, MA_ROBOT_NODES);
+	AccountLL(deadRobotList, MA_ROBOT_NODES);
+	AccountLL(weaponList, MA_WEAPON_NODES);
+
+	srand((unsigned) time(NULL)); //Randomize random numbers with time.
+	gameRandomState = (unsigned) time(NULL);
+	allegro_init();              //Initialize the Allegro library and
+	if (!theGame.headless) {     //specifically add the timer, keyboard,
+		install_timer();         //and mouse functionality.
+		install_keyboard();
+		install_mouse();
+	}
+
+	if (theGame.headless)
+		theGame.useSounds = 0;
+	else if (!install_sound(DIGI_AUTODETECT, MIDI_NONE, NULL)) {
+		theGame.useSounds = 1;
+		for (i = 0; i < NUM_SOUNDS; i++)   //Set all sounds to NULL so they will
+			theGame.sounds[i] = NULL;    //be properly freed in EndCompetition()
+
+		for (i = 0; i < NUM_SOUNDS; i++) {
+			theGame.playSound[i] = 0;
+			theGame.sounds[i] = load_wav(soundFileNames[i]);
+			if (theGame.sounds[i] == NULL) {
+				theGame.useSounds = 0;
+				char message [40];
+                sprintf(message, "Sounds failed to load %d", i);
+				AbortOnError(message);
+				break;
+			}
+		}
+	} else
+		theGame.useSounds = 0;
+
+	InitGraphics(theGame.headless);  //Load graphics particular to the robot
+	                             //competition.
+	InitJobSystem(NUM_JOB_WORKERS);  //Start the physics worker threads.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RegisterRobot
+//
+// Description: This function adds robots to the game.  Note that the random
+//              starting locations are highly dependent on a maximum number
+//              of robots of 4.  If more are desired, this function will
+//              have to be adjusted.
+//
+// Bug Fixes: 18 Apr 2006 - Found a bug that caused all calls to
+//                          SetSystemChargePriorities() to affect the 0th
+//                          robot when called from the setup function.
+//                          curRobot is now changed before the call to the
+//                          robot configuration function.  This also means that
+//                          all robot functions can be called during
+//                          configuration.
+//                        - The call the the configuration function also moved
+//                          to the end of this function so that any changes the
+//                          player makes to how the robot functions will not be
+//                          overwritten with defaults.
+//
+// Change History: 23 Juy 2006 - Now that weapons are treated the same, there
+//                               is a much larger area as weapons are
+//                               initialized on the robot.  Some of this data
+//                               (eg: impactSound) isn't even used as part of
+//                               the robot, but is simply copied over to the
+//                               weapon when it is fired in FireWeapon() for
+//                               later use.
+//                  6 Sep 2006 - Major change as users can now specify unique
+//                               graphics for their robot, as well as a
+//                               starting location.
+//                 10 Apr 2007 - Added Turbo boost functions to turn on/check
+//                               as well as required constants and sound
+//                               support.
+//                 18 Oct 2026 - Robot state that is reset for each match moved
+//                               to InitRobotState(), and placement and
+//                               configuration to SetUpRobot().
+//
+// Parameters: char *robotName - The string name of the robot.
+//             ROBOTCOLORS color - The color of the robot in the game.
+//             robotActions - A pointer to a function that accepts an int
+//                            to be called by the game every time the robot's
+//                            logic is to be executed.
+//             configureRobot - A pointer to a function so the player can
+//                              configure the robot before the game begins.
+//             customImage - A string giving the path/file name of a bitmap to
+//                           use as the image for this robot.  No size checking
+//                           is performed, so use with caution.
+//             x, y        - Starting location and heading for the robot.  If
+//                           any of these values are <0 then a random location
+//                           will be selected.  Values in cm.
+//             heading     - Starting heading of the robot.  If <0 then a random
+//                           heading will be chosen.  Value in degrees.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RegisterRobot(char *robotName, ROBOTCOLORS color,
+		void (*robotActions)(int), void (*configureRobot)(void),
+		char *customImage, int x, int y, float heading) {
+	int i, robotNumber;
+	ROBOT newRobot;
+
+	if (theGame.state != GS_SETUP)
+		AbortOnError(
+				"Call made to RegisterRobot() when game is not in setup state."
+						"\nProgram will end.");
+
+	robotNumber = SizeLL(robotList);
+	if (robotNumber == MAX_ROBOTS)
+		AbortOnError("RegisterRobot() Attempted to add too many robots.\n"
+				"Program will end.");
+
+	newRobot.ActionsFunction = robotActions;
+	newRobot.ConfigureFunction = configureRobot;
+	newRobot.SaveStateFunction = NULL;     //See SetRobotStateFunctions().
+	newRobot.LoadStateFunction = NULL;
+
+	switch (color) {
+	case ROBOT_RED:
+		newRobot.color = makecol(255, 0, 0);
+		break;
+	case ROBOT_GREEN:
+		newRobot.color = makecol(0, 255, 0);
+		break;
+	case ROBOT_BLUE:
+		newRobot.color = makecol(0, 0, 255);
+		break;
+	case ROBOT_YELLOW:
+		newRobot.color = makecol(255, 255, 0);
+		break;
+	case ROBOT_PURPLE:
+		newRobot.color = makecol(255, 0, 240);
+		break;
+	case ROBOT_TURQUOISE:
+		newRobot.color = makecol(0, 255, 255);
+		break;
+	case ROBOT_WHITE:
+	default:
+		newRobot.color = makecol(255, 255, 255);
+	}
+	if (HasNullCharacter(robotName, MAX_NAME_LEN)) {
+		newRobot.name = malloc(sizeof(char) * strlen(robotName));
+		strcpy(newRobot.name, robotName);
+		newRobot.number = robotNumber;
+		robotNames[robotNumber] = newRobot.name;
+		robotAlive[robotNumber] = 1;
+	} else
+		AbortOnError("RegisterRobot() was passed a robot name exceeding "
+				"MAX_NAME_LEN.\nProgram will end.");
+
+	for (i = 0; i < MAX_SENSORS; i++)      //Sensor images are made by
+		newRobot.sensorArray[i].image = NULL;  //AddSensor().
+	InitOrders(&newRobot.orders, NULL, 0);
+	InitRobotState(&newRobot);
+
+	//Load the robot's graphic, if required.  There is no error checking here as
+	//if newRobot.graphic is NULL, the graphics routines will simply use the
+	//default robot graphic to render the robot.
+	newRobot.graphic = NULL;
+	if (customImage != NULL)
+		newRobot.graphic = load_bitmap(customImage, NULL);
+
+	//Create the robot's bitmap.
+	newRobot.image = CreateBitmap(MA_SHIELD_BITMAPS, SHIELD_BMP_SZ,
+			SHIELD_BMP_SZ);
+	if (newRobot.image == NULL)
+		AbortOnError("RegisterRobot() failed to create robot image.\n"
+				"Program will end.");
+
+	newRobot.mailBox = ConsLL();        //Create the robot's mailbox.
+	AccountLL(newRobot.mailBox, MA_MAIL_NODES);
+	newRobot.startX = x;                //Kept for ResetMatch().
+	newRobot.startY = y;
+	newRobot.startHeading = heading;
+	newRobot.sandbox = NULL;            //Gives orders in-process until Fight().
+	newRobot.remote = NULL;             //Set by ConfigureRemoteRobot().
+
+	InsLastLL(robotList, newRobot);     //Put robot on end of the list.
+	SetUpRobot(LastElmLL(robotList));  //Place and configure it.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RegisterRemoteRobot
+//
+// Description: This function adds a robot whose orders come from a brain in
+//              another process.  The brain is asked for the robot's sensors
+//              and first orders straight away.  See remote.h.  If the brain
+//              can't be reached the robot still joins, but gives no orders.
+//
+// Parameters: char *robotName - The string name of the robot.
+//             ROBOTCOLORS color - The color of the robot in the game.
+//             char *socketPath - Path of the Unix domain socket the brain is
+//                                listening on.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RegisterRemoteRobot(char *robotName, ROBOTCOLORS color, char *socketPath) {
+	pendingRemote = ConnectRemote(socketPath);     //NULL if not listening.
+	RegisterRobot(robotName, color, RemoteRobotActions, ConfigureRemoteRobot,
+			NULL, -1, -1, -1);
+	pendingRemote = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReplaceRobotFunctions
+//
+// Description: This function points every robot, dead or alive, using one
+//              orders function at another, along with its configuration
+//              function.  It is used when a plugin is reloaded between
+//              matches.
+//
+// Parameters: oldActions - The orders function being replaced.
+//             newActions - The function to use instead.
+//             newConfigure - The configuration function to use with it.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ReplaceRobotFunctions(void (*oldActions)(int), void (*newActions)(int),
+		void (*newConfigure)(void)) {
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		if (robot->ActionsFunction == oldActions) {
+			robot->ActionsFunction = newActions;
+			robot->ConfigureFunction = newConfigure;
+		}
+	ForeachLL_M(deadRobotList, robot)
+		if (robot->ActionsFunction == oldActions) {
+			robot->ActionsFunction = newActions;
+			robot->ConfigureFunction = newConfigure;
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ResetMatch
+//
+// Description: This function starts a new match with the robots already
+//              registered, without reloading anything.  Dead robots come back,
+//              every robot is reset and placed as it was when registered, and
+//              its configuration function is run again.  Weapons, particles
+//              and mailboxes are emptied.  Robot bitmaps, sensor bitmaps,
+//              sounds and lists are all reused.  Fight() can then be called
+//              again.  To pick up rebuilt plugins call ReloadChangedPlugins()
+//              first, as the fork server does before each match.
+//
+// Parameters: unsigned int seed - Seed for GetRandomNumber().  The same seed
+//                                 gives the same random start locations,
+//                                 headings and robot random numbers.  It
+//                                 is ignored when re-simulating a log.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ResetMatch(unsigned int seed) {
+	ROBOT *robot;
+	WEAPON *weapon, *nextWeapon;
+	int i;
+
+	FinishOrders();                        //No orders may be in flight.
+	StopRecording();
+	StopLoggingCommands();
+	StopChecksums();
+
+	while (!IsEmptyLL(deadRobotList))      //Revive the dead and put every
+		LinkAftLL(LastElmLL(robotList), UnlinkLL(FirstElmLL(deadRobotList)));
+	for (i = 0; i < MAX_ROBOTS; i++)       //robot back in registration order.
+		ForeachLL_M(robotList, robot)
+			if (robot->number == i) {
+				UnlinkLL(robot);
+				LinkAftLL(LastElmLL(robotList), robot);
+				break;
+			}
+
+	SafeForeachLL_M(weaponList, weapon, nextWeapon)
+	{
+		nextWeapon = NextElmLL(weapon);
+		if (weapon->image != NULL)
+			DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+		DelElmLL(weapon);
+	}
+	ClearParticles();
+
+	gameRandomState = seed;
+	orderTick = 0;
+	matchTick = 0;
+	lastAction = 0;
+	matchEnd = MATCH_RUNNING;
+	nextWeaponId = 0;
+	for (i = 0; i < NUM_SOUNDS; i++)
+		theGame.playSound[i] = 0;
+	for (i = 0; i < MAX_ROBOTS; i++)
+		ClearRobotProfile(&robotProfiles[i]);
+	NextRemoteMatch();                     //Brains see HELLO for a new match.
+
+	ForeachLL_M(robotList, robot)
+	{
+		if (robot->sandbox != NULL) {      //The child has the last match's
+			StopSandbox(robot->sandbox);   //statics.  Fight() starts another.
+			robot->sandbox = NULL;
+		}
+		EmptyLL(robot->mailBox);
+		InitRobotState(robot);
+		robotAlive[robot->number] = 1;
+		remoteGps[robot->number] = 0;
+		robot->x = robot->y = -ARENA_WIDTH_CM;   //Off the arena so unplaced
+	}                                           //robots don't block others.
+
+	theGame.state = GS_SETUP;              //Configuration may add sensors.
+	if (loggedCommands != NULL)
+		RewindCommandLog(loggedCommands);
+	ForeachLL_M(robotList, robot)
+		SetUpRobot(robot);
+	if (loggedCommands != NULL)            //The logged match, not the seed.
+		gameRandomState = GetLoggedHeader(loggedCommands)->randomState;
+	calcCounter = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetRobotStateFunctions
+//
+// Description: This function gives every robot using an orders function the
+//              functions that save and load the statics of its code, so
+//              snapshots include them.  It is used by robots in plugins.
+//
+// Parameters: actions - The robots' orders function.
+//             saveState - Called as saveState(buffer, size).  Returns the
+//                         bytes the state needs and, if size is at least
+//                         that, writes the state to buffer.  NULL to stop
+//                         saving.
+//             loadState - Called as loadState(buffer, size) with what
+//                         saveState wrote.  Returns 0 if it can't be used.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetRobotStateFunctions(void (*actions)(int),
+		int (*saveState)(void *, int), int (*loadState)(void *, int)) {
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		if (robot->ActionsFunction == actions) {
+			robot->SaveStateFunction = saveState;
+			robot->LoadStateFunction = loadState;
+		}
+	ForeachLL_M(deadRobotList, robot)
+		if (robot->ActionsFunction == actions) {
+			robot->SaveStateFunction = saveState;
+			robot->LoadStateFunction = loadState;
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SaveMatch
+//
+// Description: This function writes the complete state of the match to a
+//              snapshot: tick counts, random number streams, robots (alive
+//              and dead, in list order), pending orders, mailboxes, weapons,
+//              particles and the statics of robots that opted in.  Orders
+//              being given in the background are finished first.
+//
+// Parameters: SNAPSHOT *snapshot - Emptied and filled with the match.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SaveMatch(SNAPSHOT *snapshot) {
+	int header[8], count;
+	ROBOT *robot;
+	WEAPON *weapon;
+
+	FinishOrders();
+	ClearSnapshot(snapshot);
+
+	header[0] = SNAPSHOT_MAGIC;
+	header[1] = SNAPSHOT_VERSION;
+	header[2] = SizeLL(robotList) + SizeLL(deadRobotList);
+	header[3] = matchTick;
+	header[4] = orderTick;
+	header[5] = gameRandomState;
+	header[6] = lastAction;
+	header[7] = nextWeaponId;
+	WriteSnapshot(snapshot, header, sizeof(header));
+	WriteSnapshot(snapshot, theGame.playSound, sizeof(theGame.playSound));
+	WriteSnapshot(snapshot, robotAlive, sizeof(robotAlive));
+	WriteSnapshot(snapshot, remoteGps, sizeof(remoteGps));
+
+	count = SizeLL(robotList);                      //Which robots are alive
+	WriteSnapshot(snapshot, &count, sizeof(count));  //and dead, in list order.
+	ForeachLL_M(robotList, robot)
+		WriteSnapshot(snapshot, &robot->number, sizeof(robot->number));
+	count = SizeLL(deadRobotList);
+	WriteSnapshot(snapshot, &count, sizeof(count));
+	ForeachLL_M(deadRobotList, robot)
+		WriteSnapshot(snapshot, &robot->number, sizeof(robot->number));
+
+	ForeachLL_M(robotList, robot)
+		SaveRobot(snapshot, robot);
+	ForeachLL_M(deadRobotList, robot)
+		SaveRobot(snapshot, robot);
+
+	count = SizeLL(weaponList);                     //Owners are saved by
+	WriteSnapshot(snapshot, &count, sizeof(count));  //number.
+	ForeachLL_M(weaponList, weapon)
+	{
+		WriteSnapshot(snapshot, &weapon->owner->number, sizeof(int));
+		WriteSnapshot(snapshot, weapon, sizeof(WEAPON));
+	}
+
+	SaveParticles(snapshot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RestoreMatch
+//
+// Description: This function puts the match back as it was when a snapshot
+//              was saved.  It must be the same match setup: the same robots
+//              registered in the same order.  Robot, sensor and weapon
+//              bitmaps, list elements and mailboxes are reused where they
+//              exist, and robot and sensor images are redrawn so the scene
+//              can be rendered straight away.  The whole snapshot is checked
+//              before anything is changed.
+//
+// Parameters: SNAPSHOT *snapshot - A snapshot from SaveMatch().
+//
+// Returns: int - 1 if successful.  0 if the snapshot is damaged or from
+//                another match setup, or a robot's code can't use the
+//                statics saved for it, in which case the match is left as it
+//                was.
+//
+////////////////////////////////////////////////////////////////////////////////
+int RestoreMatch(SNAPSHOT *snapshot) {
+	ROBOT *byNumber[MAX_ROBOTS], *order[MAX_ROBOTS], *robot;
+	void *states[MAX_ROBOTS];
+	int stateSizes[MAX_ROBOTS], header[8], i, count;
+
+	FinishOrders();
+	for (i = 0; i < MAX_ROBOTS; i++)
+		byNumber[i] = NULL;
+	ForeachLL_M(robotList, robot)
+		byNumber[robot->number] = robot;
+	ForeachLL_M(deadRobotList, robot)
+		byNumber[robot->number] = robot;
+
+	snapshot->position = 0;
+	if (!CheckMatch(snapshot, byNumber, order, states, stateSizes))
+		return 0;
+	count = SizeLL(robotList) + SizeLL(deadRobotList);
+	if (!LoadRobotStates(order, count, states, stateSizes))
+		return 0;
+
+	StopLoggingCommands();                 //The log can't jump.
+	if (loggedCommands != NULL)            //Read up to the snapshot's
+		RewindCommandLog(loggedCommands);  //calculation again.
+
+	snapshot->position = 0;                //Nothing can fail from here on.
+	ReadSnapshot(snapshot, header, sizeof(header));
+	matchTick = header[3];
+	orderTick = header[4];
+	gameRandomState = header[5];
+	lastAction = header[6];
+	nextWeaponId = header[7];
+	matchEnd = MATCH_RUNNING;            //Worked out again after the next
+	if (theGame.state == GS_OVER)        //calculation.
+		theGame.state = GS_FIGHTING;
+	ReadSnapshot(snapshot, theGame.playSound, sizeof(theGame.playSound));
+	ReadSnapshot(snapshot, robotAlive, sizeof(robotAlive));
+	ReadSnapshot(snapshot, remoteGps, sizeof(remoteGps));
+	RestoreListOrder(snapshot, robotList, byNumber);
+	RestoreListOrder(snapshot, deadRobotList, byNumber);
+
+	ForeachLL_M(robotList, robot)
+		RestoreRobot(snapshot, robot);
+	ForeachLL_M(deadRobotList, robot)
+		RestoreRobot(snapshot, robot);
+	RestoreWeapons(snapshot, byNumber);
+	RestoreParticles(snapshot);
+
+	DrawRobotBitmaps(robotList);           //Images are only drawn during a
+	DrawSensorBitmaps(robotList);          //tick, so bring them up to date.
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddSensor
+//
+// Description: This adds a sensor to the robot.  The provided port must be
+//              an empty port on the robot, and must be in the valid port range,
+//              width range, and distance range.
+//
+// Parameters: int port - The port to put the sensor on.
+//             SENSORTYPE type - The type of sensor to add.
+//             int angle - The angle the sensor points.  This may have different
+//                         meanings for different sensors.
+//             int range - The distance to which the sensor can "look".
+//
+// Returns: int - 0 if sensor install fails.
+//                1 if successful.
+//
+////////////////////////////////////////////////////////////////////////////////
+int AddSensor(int port, SENSORTYPE type, int angle, int width, int range) {
+	if (theGame.state != GS_SETUP)
+		AbortOnError(
+				"Call made to AddSensor() when game is not in setup state.\n"
+						"Program will end.");
+	CountCall_M(RC_ADD_SENSOR);
+
+	if (port < 0 || port > MAX_SENSORS - 1)
+		return 0;
+
+	if (curRobot->sensorArray[port].type != SENSOR_NONE)
+		return 0;
+
+	angle = BoundAngle(angle);
+
+	if (type == SENSOR_RADAR) {
+		if (width < MIN_RADAR_ARC || width > MAX_RADAR_ARC)
+			return 0;
+
+		if (range < RADAR_MIN_RANGE || range > RADAR_MAX_RANGE)
+			return 0;
+
+		if (curRobot->sensorArray[port].image == NULL)  //Reuse last match's.
+			curRobot->sensorArray[port].image = CreateBitmap(
+					MA_RADAR_BITMAPS, RADAR_IMAGE_PX, RADAR_IMAGE_PX);
+		if (curRobot->sensorArray[port].image == NULL)
+			AbortOnError("AddSensor() failed to create a radar bitmap.\n"
+					"Program will end.");
+	} else if (type == SENSOR_RANGE) {
+		if (curRobot->sensorArray[port].image != NULL)
+			DestroyBitmap(MA_RADAR_BITMAPS, curRobot->sensorArray[port].image);
+		curRobot->sensorArray[port].image = NULL;
+		range = RANGE_MAX_RANGE;
+	} else
+		return 0;
+
+	curRobot->sensorArray[port].type = type;
+	curRobot->sensorArray[port].angle = angle;
+	curRobot->sensorArray[port].width = width;
+	curRobot->sensorArray[port].range = range;
+	curRobot->sensorArray[port].on = 1;
+	curRobot->sensorArray[port].powered = 0;
+	curRobot->sensorArray[port].data = -1;
+
+	curRobot->view.sensorType[port] = type;   //Keep the view in step so the
+	curRobot->view.sensorOn[port] = 1;        //rest of the configuration
+	curRobot->view.sensorPowered[port] = 0;   //sees the new sensor.
+	curRobot->view.sensorData[port] = -1;
+
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: EndCompetition
+//
+// Description: This function cleans up our allocated resources such as the
+//              linked lists, images, sounds, etc... as well as shutting down
+//              the Allegro graphics library.  The trace, if one is being
+//              recorded, is written (see trace.h), and the memory accounts
+//              reported before anything is freed (see memstats.h).
+//
+// Parameters:  None.
+//
+// Change History: 19-23 July 2006 - When the linked list rework was done, this
+//                                   function changed to perform the cleanup
+//                                   of a) allocated memory for each element
+//                                   in a linked list, b) each element of in
+//                                   that list and finally c) the list.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void EndCompetition() {
+	int i;
+	ROBOT *tempRobot, *nextRobot;
+	WEAPON *tempWeapon, *nextWeapon;
+
+	ReportMemStats();              //While the last match's memory is held.
+	StopRecording();
+	StopLoggingCommands();
+	StopChecksums();
+	if (loggedCommands != NULL)
+		CloseCommandLog(loggedCommands);
+	loggedCommands = NULL;
+
+	//Move the dead robots back into the main list for deletion.
+	//deadRobotList should be empty after this loop has finished.
+	while (!IsEmptyLL(deadRobotList))
+		LinkAftLL(LastElmLL(robotList), UnlinkLL(FirstElmLL(deadRobotList)));
+
+	//Now iterate through each robot, cleaning up allocated memory
+	//and, when all memory is cleaned up, remove each one from the list.
+	SafeForeachLL_M(robotList, tempRobot, nextRobot)
+	//Has to be "safe" as
+	{                                                    //list elements will be
+		nextRobot = NextElmLL(tempRobot);                   //deleted during the
+		for (i = 0; i < MAX_SENSORS; i++)                       //iteration.
+			if (tempRobot->sensorArray[i].image != NULL)    //Free sensor images.
+				DestroyBitmap(MA_RADAR_BITMAPS, tempRobot->sensorArray[i].image);
+
+		if (tempRobot->graphic != NULL)
+			destroy_bitmap(tempRobot->graphic);        //Free custom images.
+		DestroyBitmap(MA_SHIELD_BITMAPS, tempRobot->image);  //Free robot bitmaps.
+		free(tempRobot->name);                       //Free robot name strings.
+
+		DestLL(tempRobot->mailBox);                  //Remove all messages.
+		FreeOrders(&tempRobot->orders);              //And any being sent.
+		if (tempRobot->sandbox != NULL)
+			StopSandbox(tempRobot->sandbox);       //End its orders process.
+		if (tempRobot->remote != NULL)
+			DisconnectRemote(tempRobot->remote);   //Let its brain go.
+
+		DelElmLL(tempRobot);                   //Delete the robot from the list.
+	}
+	for (i = 0; i < MAX_ROBOTS; i++)
+		FreeOrders(&setupOrders[i]);
+
+	//Now clean up the weapon list, deleting each weapon.
+	SafeForeachLL_M(weaponList, tempWeapon, nextWeapon)
+	{
+		nextWeapon = NextElmLL(tempWeapon);
+		if (tempWeapon->image != NULL)
+			DestroyBitmap(MA_WEAPON_BITMAPS, tempWeapon->image);  //Free images.
+		DelElmLL(tempWeapon);                          //Delete the weapon.
+	}
+
+	if (IsEmptyLL(robotList) && IsEmptyLL(deadRobotList)
+			&& IsEmptyLL(weaponList)) {
+		DestLL(robotList);
+		DestLL(deadRobotList);
+		DestLL(weaponList);
+	} else {
+		DestLL(robotList);
+		DestLL(deadRobotList);
+		DestLL(weaponList);
+		AbortOnError(
+				"EndCompetition() discovered one of the main linked lists was "
+						"not empty before deletion.\n"
+						"Program will now end.");
+	}
+
+	//Delete the sounds.
+	for (i = 0; i < NUM_SOUNDS; i++)
+		if (theGame.sounds[i] != NULL)
+			destroy_sample(theGame.sounds[i]);
+
+	if (!theGame.headless)
+		clear_keybuf();            //Clean up Allegro and our graphics.
+	DeInitGraphics();
+	DeInitJobSystem();             //Stop the worker threads.
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+	FreeElements(&orderArray);
+#endif
+	FreePhysicsScratch();
+	StopTrace();                   //Only once no worker is tracing.
+	StopPerfCounters();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetMotorSpeeds
+//
+// Description: This function sets the robots tread speeds.  Speeds are a % of
+//              maximum, from 0 to 100, -ve to +ve.  Only the last call in a
+//              turn has any effect.
+//
+// Parameters: int leftSpd - Left tread speed.
+//             int rightSpd - Right tread speed.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetMotorSpeeds(int leftSpd, int rightSpd) {
+	COMMAND *command;
+
+	CountCall_M(RC_SET_MOTOR_SPEEDS);
+	if (leftSpd < -100)
+		leftSpd = -100;
+	else if (leftSpd > 100)
+		leftSpd = 100;
+
+	if (rightSpd < -100)
+		rightSpd = -100;
+	else if (rightSpd > 100)
+		rightSpd = 100;
+
+	if ((command = NewCommand(CMD_MOTOR_SPEEDS, REPLACE_TYPE, 0)) != NULL) {
+		command->args[0] = leftSpd;
+		command->args[1] = rightSpd;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TurboBoost
+//
+// Description: This function fires the turbo boost, if energy allows.
+//              The new firing "wastes" any time remaining in the previous turbo
+//              boost, if there was any.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if Turbo was turned on, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int TurboBoost() {
+	CountCall_M(RC_TURBO_BOOST);
+	if (curRobot->view.shields > TURBOBOOST_COST
+			&& NewCommand(CMD_TURBO_BOOST, NEW_COMMAND, 0) != NULL) {
+		curRobot->view.shields -= TURBOBOOST_COST;
+		curRobot->view.turboTime = TURBOBOOST_TIME * CALCS_PER_SEC;
+		return 1;
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: IsTurboOn
+//
+// Description: This function check if a turbo boost is currently firing.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if Turbo is firing, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int IsTurboOn() {
+	CountCall_M(RC_IS_TURBO_ON);
+	if (curRobot->view.turboTime)
+		return 1;
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetGPSInfo
+//
+// Description: This function fills out a GPS_INFO structure for the requesting
+//              robot.  Energy for the GPS use is dedected from the robot's
+//              shield capacitor.  If there in not sufficient energy, the
+//              request fails.
+//
+// Note: The heading is the same as that stored by the robot, so it is in
+//       math coordinates, with 0 being to the right and increasing counter-
+//       clockwise.
+//
+// Parameters: GPS_INFO *gpsData - Pointer to the structure to fill out.
+//
+// Returns: int - 1 if the request succeeds, 0 if it fails.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetGPSInfo(GPS_INFO *gpsData) {
+	CountCall_M(RC_GET_GPS_INFO);
+	if (curRobot->view.shields > GPS_COST
+			&& NewCommand(CMD_USE_GPS, NEW_COMMAND, 0) != NULL) {
+		curRobot->view.shields -= GPS_COST;
+		gpsData->x = curRobot->view.x;
+		gpsData->y = curRobot->view.y;
+		gpsData->heading = curRobot->view.heading;
+		return 1;
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetSensorData
+//
+// Description: This function returns a sensor's data, if the sensor is on
+//              and powered.
+//
+// Parameters: int port - The sensor port to read.
+//
+// Returns: int - The sensor's data.  If the port is invalid, or the sensor is
+//                off or unpowered this returns -1.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetSensorData(int port) {
+	CountCall_M(RC_GET_SENSOR_DATA);
+	if (port >= 0 && port < MAX_SENSORS)
+		if (curRobot->view.sensorType[port] != SENSOR_NONE)
+			if (curRobot->view.sensorOn[port]
+					&& curRobot->view.sensorPowered[port])
+				return curRobot->view.sensorData[port];
+
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetSensorStatus
+//
+// Description: This function allows the user to turn a robot's sensor on/off.
+//
+// Parameters: int port - The sensor port to change.
+//             int status - 0 to turn off, non-zero to turn on.
+//
+// Returns: Nothing
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetSensorStatus(int port, int status) {
+	COMMAND *command;
+
+	CountCall_M(RC_SET_SENSOR_STATUS);
+	if (status != 0)
+		status = 1;
+	if (port >= 0 && port < MAX_SENSORS
+			&& (command = NewCommand(CMD_SENSOR_STATUS, REPLACE_TARGET, port))
+					!= NULL) {
+		curRobot->view.sensorOn[port] = status;
+		command->args[1] = status;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FireWeapon
+//
+// Description: This function fires the given weapon, if it is sufficiently
+//              powered and it meets firing arc requirements.  The weapon
+//              leaves the robot when the orders are applied.
+//
+//              Any try to fire, failed or not, uses up the charge in the
+//              view, so only the first fire command for a weapon in a turn
+//              can do anything.  Later ones aren't added.
+//
+// Parameters: WEAPONTYPE type - The weapon to fire.
+//
+// Returns: int - 0 if weapon firing fails, 1 if successful.
+//
+////////////////////////////////////////////////////////////////////////////////
+int FireWeapon(WEAPONTYPE type, int heading) {
+	WEAPON_SYSTEM *weaponSys;
+	COMMAND *command;
+	int port;
+
+	CountCall_M(RC_FIRE_WEAPON);
+	switch (type) {
+	case WEAPON_LASER:
+		port = LASER_PORT;
+		break;
+	case WEAPON_MISSILE:
+		port = MISSILE_PORT;
+		break;
+	default:
+		return 0;
+	}
+	weaponSys = &curRobot->weaponArray[port];  //Only its constants are read.
+
+	//Check aiming and energy conditions.
+	if (heading % 360 < -weaponSys->maxAngle
+			|| heading % 360 > weaponSys->maxAngle)
+		return 0;
+
+	//Trying to fire without enough energy wastes the charged energy.  The
+	//command is still given, as there may be enough when it is applied.
+	if (curRobot->view.chargeEnergy[port] < weaponSys->minEnergy) {
+		curRobot->view.chargeEnergy[port] = 0;
+		if (FindCommand(CMD_FIRE_WEAPON, REPLACE_TARGET, type) == NULL
+				&& (command = NewCommand(CMD_FIRE_WEAPON, REPLACE_TARGET,
+						type)) != NULL)
+			command->args[1] = heading;
+		return 0;
+	}
+	if ((command = NewCommand(CMD_FIRE_WEAPON, NEW_COMMAND, type)) == NULL)
+		return 0;
+	command->args[1] = heading;
+	curRobot->view.chargeEnergy[port] = 0;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetSystemEnergy
+//
+// Description: This function returns the current amount of energy in the
+//              indicated system.
+//
+// Parameters: SYSTEM type - The system to check the power on.
+//
+// Returns: float - The power in the requested system.  -1 if an invalid
+//                  system was specified.
+//
+////////////////////////////////////////////////////////////////////////////////
+float GetSystemEnergy(SYSTEM type) {
+	CountCall_M(RC_GET_SYSTEM_ENERGY);
+	switch (type) {
+	case SYSTEM_SHIELDS:
+		return curRobot->view.shields;
+	case SYSTEM_LASERS:
+		return (curRobot->view.chargeEnergy[LASER_PORT]);
+	case SYSTEM_MISSILES:
+		return (curRobot->view.chargeEnergy[MISSILE_PORT]);
+	default:
+		return -1;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetSystemChargeRate
+//
+// Description: This function sets the requested rate for a system to charge.
+//
+// Parameters: SYSTEM type - The system to set the charge rate for.
+//             int rate - The rate in units/min at which the system
+//             should charge.
+//
+// Returns: Nothing
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetSystemChargeRate(SYSTEM type, int rate) {
+	COMMAND *command;
+
+	CountCall_M(RC_SET_CHARGE_RATE);
+	if (rate < 0)
+		rate = 0;
+
+	//Since sensor "rates" can't be set, just check for shields, lasers, and
+	//missiles if they are within the correct charging bounds.  If not, bound
+	//them and set the rate.
+	switch (type) {
+	case SYSTEM_SHIELDS:
+		if (rate > MAX_SHIELD_CHARGE_RATE)
+			rate = MAX_SHIELD_CHARGE_RATE;
+		break;
+	case SYSTEM_LASERS:
+		if (rate > MAX_LASER_CHARGE_RATE)
+			rate = MAX_LASER_CHARGE_RATE;
+		break;
+	case SYSTEM_MISSILES:
+		if (rate > MAX_MISSILE_CHARGE_RATE)
+			rate = MAX_MISSILE_CHARGE_RATE;
+		break;
+	default:
+		return;
+	}
+	if ((command = NewCommand(CMD_CHARGE_RATE, REPLACE_TARGET, type)) != NULL)
+		command->args[1] = rate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetSystemChargePriorities
+//
+// Description: This function records the robot's charging priorities.
+//
+// Parameters: int priorities - This is an array where each system must appear
+//                              once and only once or the function will not
+//                              change the priorities.  For example:
+//
+//                  priorities[0]=SYSTEM_MISSILES;
+//                  priorities[1]=SYSTEM_SHIELDS;
+//                  priorities[2]=SYSTEM_SENSORS;
+//                  priorities[3]=SYSTEM_LASERS;
+//
+// Returns: int - 1 if change was successful,
+//                0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int SetSystemChargePriorites(SYSTEM priorities[NUM_ENERGY_SYSTEMS]) {
+	COMMAND *command;
+	int i, j;
+
+	CountCall_M(RC_SET_CHARGE_PRIORITIES);
+	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++) {
+		if (priorities[i] < 0 || priorities[i] > NUM_ENERGY_SYSTEMS - 1) //Check if valid
+			return 0;                                            //SYSTEM value.
+
+		for (j = i + 1; j < NUM_ENERGY_SYSTEMS; j++)   //Check for duplicates in
+			if (priorities[i] == priorities[j])          //the priority list.
+				return 0;
+	}
+
+	command = NewCommand(CMD_CHARGE_PRIORITIES, REPLACE_TYPE, 0);
+	if (command == NULL)
+		return 0;
+	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++)                 //Record priorities
+		command->args[i] = priorities[i];                  //in the command.
+	return 1;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetBumpInfo
+//
+// Description: This function reports the bump information since the bump
+//              status was last checked.  Bump info is cleared after checking.
+//
+// Parameters: None.
+//
+// Returns: int - A number representing what has been bumped.  BUMP_NONE if
+//                the robot has given too many orders this turn to clear it.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetBumpInfo(void) {
+	int tempBumpInfo = curRobot->view.bumped;
+
+	CountCall_M(RC_GET_BUMP_INFO);
+	if (tempBumpInfo != BUMP_NONE         //Only the reported bumps are cleared
+			&& NewCommand(CMD_CLEAR_BUMP, NEW_COMMAND, tempBumpInfo) == NULL)
+		return BUMP_NONE;                 //so any since are still seen.
+	curRobot->view.bumped = BUMP_NONE;
+	return tempBumpInfo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetGeneratorStructure
+//
+// Description: This function returns the remaining structure of the generator.
+//
+// Parameters: None.
+//
+// Returns: int - The remaining generator structure.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetGeneratorStructure(void) {
+	CountCall_M(RC_GET_GENERATOR_STRUCTURE);
+	return curRobot->view.generatorStructure;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetGeneratorOutput
+//
+// Description: This function returns the remaining output of the generator
+//              in energy units/min.
+//
+// Parameters: None.
+//
+// Returns: int - The output of the generator.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetGeneratorOutput(void) {
+	CountCall_M(RC_GET_GENERATOR_OUTPUT);
+	return curRobot->view.generatorStructure * GENERATOR_CAPACITY
+			/ MAX_GENERATOR_STRUCTURE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetStatusMessage
+//
+// Description: This function allows the user to set the status message of the
+//              robot.
+//
+// Parameters: char *message - String to be recorded.  Max length is
+//                             STATUS_MSG_LEN (includes null char).  Messages
+//                             that exceed this length will cause program
+//                             termination.
+//
+// Bug Fixes: 19 July 2006 - Found that hasNull was initialized to 1, so calls
+//                           would never fail, no matter how long the message.
+//                           Additionally, the loop looking for the null char
+//                           was only checking the 0th character of the string
+//                           ie: message instead of message[i].
+//                           Update: August 1 2006 - This part of the function
+//                                   has been moved to its own function called
+//                                   HasNullCharacter()
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetStatusMessage(char *message) {
+	CountCall_M(RC_SET_STATUS_MESSAGE);
+
+	if (!HasNullCharacter(message, STATUS_MSG_LEN)) {
+		char errorMessage[100 + MAX_NAME_LEN];        //Only create if required.
+		sprintf(errorMessage, "%s did not have a properly formatted string "
+				"in its call to SetStatusMessage().\n"
+				"Program will end.", curRobot->name);
+		AbortOnError(errorMessage);
+	} else if (NewCommand(CMD_STATUS_MESSAGE, REPLACE_TYPE, 0) != NULL)
+		strcpy(curRobot->view.statusMessage, message);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SendMessage
+//
+// Description: This function allows a robot to send a message to another robot
+//              if they know its name.
+//
+// Parameters: char *robotName - The name of the destination robot.
+//             INT_32 data - INT_32 is a platform specific type defined in
+//                           competition.h and is a 32 bit integer.  This is the
+//                           data being sent.
+//
+// Returns: int - 1 if message will be delivered when the orders are applied.
+//                0 if robot was not found (name wrong or robot dead), or the
+//                message couldn't be kept.
+//
+////////////////////////////////////////////////////////////////////////////////
+int SendMessage(char *robotName, INT_32 data) {
+	int addressee;
+
+	CountCall_M(RC_SEND_MESSAGE);
+	if (!HasNullCharacter(robotName, MAX_NAME_LEN)) {
+		char errorMessage[100 + MAX_NAME_LEN];        //Only create if required.
+		sprintf(errorMessage,
+				"%s did not have a properly formatted name string "
+						"in its call to SendMessage().\n"
+						"Program will end.", curRobot->name);
+		AbortOnError(errorMessage);
+	}
+
+	if ((addressee = LookupRobotByName(robotName)) < 0)
+		return 0;
+	if (!AddSentMessage(&curRobot->orders, addressee, data)) {
+		curRobot->orders.dropped++;
+		return 0;
+	}
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetMessage
+//
+// Description: This function reads a message from a robot's mailbox.  When the
+//              message is read, it is deleted from the mailbox.
+//
+// Parameters: INT_32 *data - A pointer to a 32-bit integer that will be filled
+//                            out with the message from the mailbox.
+//
+// Returns: int - 0 if the mailbox was empty and no data was returned.
+//                1 if the mailbox contained a message which was returned.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetMessage(INT_32 *data) {
+	ROBOT_VIEW *view = &curRobot->view;
+
+	CountCall_M(RC_GET_MESSAGE);
+	if (view->mailRead < view->mailCount              //There are messages...
+			&& NewCommand(CMD_READ_MESSAGE, NEW_COMMAND, 0) != NULL) { //Delete
+		*data = view->mail[view->mailRead++];        //the message and get the
+		return 1;                                    //data out.
+	}
+	return 0;                                        //No messages.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AbortOnError
+//
+// Description: This function reports an error to the user and exits
+//              the program.
+//
+// Parameters: char *message - The error message to show the user.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AbortOnError(char *message) {
+	allegro_message(message);
+	exit(-1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetRandomNumber
+//
+// Description: This function returns a random integer in the range
+//              0<=x<upperBound.  While a robot is giving orders the number
+//              comes from that robot's own stream (a simple LCG) so robots
+//              running on different threads can't change each other's
+//              numbers.  Otherwise it comes from the game's stream, which
+//              ResetMatch() seeds.  Starting locations and headings come
+//              from the game's stream, so they rely on the whole range being
+//              covered and upperBound itself never being given.
+//
+// Parameters: int upperBound - The upper bound of numbers.
+//
+// Returns: float - The number.
+//
+////////////////////////////////////////////////////////////////////////////////
+float GetRandomNumber(int upperBound) {
+	float number;
+
+	if (curRobot != NULL)
+		CountCall_M(RC_GET_RANDOM_NUMBER);
+	number = upperBound * (double) NextRandom(curRobot != NULL
+			? &curRobot->randomState : &gameRandomState) / 16777216.0;
+	if (upperBound > 0 && number >= upperBound)   //Rounded up to a float.
+		number = nextafterf(upperBound, 0.0f);
+	return number;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: HasNullCharacter
+//
+// Description: This function checks if a string contains a null character
+//              within a specified length.
+//
+// Parameters: char *string - The string to test
+//             int   numChars - The maximum length of the string.  If properly
+//                              formatted, a null character will exist within
+//                              the string.
+//
+// Returns: int - 1 if the string contains a null character
+//                0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int HasNullCharacter(char *string, int numChars) {
+	int i;
+
+	for (i = 0; i < numChars - 1; i++)
+		if (string[i] == '\0')
+			return 1;
+
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LookupRobotByName
+//
+// Description: This function finds the pointer of another robot in the linked
+//              list by using the name of the robot.
+//
+// Notes: This function searches robotNames rather than the robot list so it
+//        is safe to call while orders are being given.  Which robots are
+//        alive comes from the current robot's view, so a robot in a sandbox
+//        (forked before any robot died) sees them as of this turn too.  If
+//        there is ever a significant number of robots in the competition
+//        (and I don't know what that is, but I suspect over 100 or so) this
+//        would no longer suffice.  Instead, a hash would likely have to be
+//        created to quickly find the robot in question.
+//
+// Parameters: char *name - The name of the robot to find.
+//
+// Returns: int - Number of the robot.  If the robot was not found (because
+//                the name is bad or the robot is dead) -1 is returned.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int LookupRobotByName(char *name) {
+	int i;
+
+	for (i = 0; i < MAX_ROBOTS; i++)
+		if (curRobot->view.robotAlive[i] && !strcmp(robotNames[i], name))
+			return i;
+	return -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LookupRobotByNumber
+//
+// Description: This function finds a living robot from its number.
+//
+// Parameters: int number - The number of the robot to find.
+//
+// Returns: ROBOT* - Pointer to the robot, or NULL if it is dead.
+//
+////////////////////////////////////////////////////////////////////////////////
+static ROBOT *LookupRobotByNumber(int number) {
+	ROBOT *theRobot;
+
+	ForeachLL_M(robotList, theRobot)
+	{
+		if (theRobot->number == number)
+			return theRobot;
+	}
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: BoundAngle
+//
+// Description: This is a short utility function to ensure an angle is within
+//              a range of 0<=angle<360
+//
+// Parameters: int angle - The angle to be bounded.
+//
+// Returns: int - The bounded angle.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int BoundAngle(int angle) {
+	while (angle > 360)
+		angle -= 360;
+	while (angle < 360)
+		angle += 360;
+	return angle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ChooseRandomLocation
+//
+// Description: This function chooses a random x/y location for a robot.  The
+//              location will be at least MIN_RANDOM_DIST cm away from each
+//              other robot The function will make 1000 attempts to find a non-
+//              colliding location, and then give up.
+//
+// Parameters: ROBOT *robot - The robot to move.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ChooseRandomLocation(ROBOT *robot) {
+	int dx, dy, success, attempts = 1000;
+	double dist;
+	ROBOT *tmpRob;                         //Robot pointer iterator.
+
+	while (attempts--) {
+		//Choose a random location within the arena.
+		robot->x = GetRandomNumber(
+		ARENA_WIDTH_CM - SHIELD_RAD_CM * 2) + SHIELD_RAD_CM;
+		robot->y = GetRandomNumber(
+		ARENA_HEIGHT_CM - SHIELD_RAD_CM * 2) + SHIELD_RAD_CM;
+
+		if (SizeLL(robotList) == 1) //No need to check for collisions if this is
+			return;                   //the only robot.
+
+		//Iterate through each other robot.  If the distance is less than that
+		//allowed, record a failure and break to start next attempt.
+		success = 1;
+		for (tmpRob = FirstElmLL(robotList); IsElmLL(tmpRob); tmpRob =
+				NextElmLL(tmpRob)) {
+			if (tmpRob != robot)           //Don't check if too close to itself.
+					{
+				dx = robot->x - tmpRob->x;
+				dy = robot->y - tmpRob->y;
+				dist = sqrt(pow(dx, 2) + pow(dy, 2));
+				if (dist < (SHIELD_RAD_CM * 2 + MIN_RANDOM_DIST)) {
+					success = 0;
+					break;
+				}
+			}
+		}
+		if (success)
+			return;
+	}
+
+	AbortOnError("ChooseRandomLocation() could not find a place for this robot "
+			"that did not collide with another robot.\n"
+			"Program will end.");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitRobotState
+//
+// Description: This function sets everything about a robot that starts
+//              afresh each match: speeds, sensors, weapons, energy and
+//              damage.  Its name, color, images and mailbox are untouched.
+//              The benchmark tools use it to make robots without
+//              registering them.
+//
+// Parameters: ROBOT *robot - The robot to reset.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitRobotState(ROBOT *robot) {
+	int i;
+
+	//Set starting speed values
+	robot->leftTreadSpeed = 0;
+	robot->rightTreadSpeed = 0;
+	robot->impulseHeading = 0;
+	robot->impulseSpeed = 0;
+	robot->impulseCos = 1;
+	robot->impulseSin = 0;
+	robot->turboTime = 0;
+
+	//Configure the sensors.
+	robot->bumped = BUMP_NONE;
+	for (i = 0; i < MAX_SENSORS; i++)     //Images are kept for AddSensor() to
+		robot->sensorArray[i].type = SENSOR_NONE;      //reuse.
+
+	//Configure the laser.
+	robot->weaponArray[LASER_PORT].type = WEAPON_LASER;
+	robot->weaponArray[LASER_PORT].maxAngle = LASER_MAX_ANGLE;
+	robot->weaponArray[LASER_PORT].minEnergy = MIN_LASER_ENERGY;
+	robot->weaponArray[LASER_PORT].maxEnergy = MAX_LASER_ENERGY;
+	robot->weaponArray[LASER_PORT].bonusEnergy = LASER_ENERGY_BONUS;
+	robot->weaponArray[LASER_PORT].splashRange = LASER_SPLASH_RANGE;
+	robot->weaponArray[LASER_PORT].splashDamage = LASER_SPLASH_DAMAGE;
+	robot->weaponArray[LASER_PORT].speed = LASER_SPEED;
+	robot->weaponArray[LASER_PORT].bumpValue = BUMP_LASER;
+	robot->weaponArray[LASER_PORT].firingSound = SND_LASER_FIRE;
+	robot->weaponArray[LASER_PORT].impactSound = SND_LASER_HIT;
+
+	//Configure the missiles.
+	robot->weaponArray[MISSILE_PORT].type = WEAPON_MISSILE;
+	robot->weaponArray[MISSILE_PORT].maxAngle = MISSILE_MAX_ANGLE;
+	robot->weaponArray[MISSILE_PORT].minEnergy = MIN_MISSILE_ENERGY;
+	robot->weaponArray[MISSILE_PORT].maxEnergy = MAX_MISSILE_ENERGY;
+	robot->weaponArray[MISSILE_PORT].bonusEnergy = MISSILE_ENERGY_BONUS;
+	robot->weaponArray[MISSILE_PORT].splashRange = MISSILE_SPLASH_RANGE;
+	robot->weaponArray[MISSILE_PORT].splashDamage = MISSILE_SPLASH_DAMAGE;
+	robot->weaponArray[MISSILE_PORT].speed = MISSILE_SPEED;
+	robot->weaponArray[MISSILE_PORT].bumpValue = BUMP_MISSILE;
+	robot->weaponArray[MISSILE_PORT].firingSound = SND_MISSILE_FIRE;
+	robot->weaponArray[MISSILE_PORT].impactSound = SND_MISSILE_HIT;
+
+	for (i = 0; i < MAX_WEAPONS; i++) {
+		robot->weaponArray[i].chargeRate = 0;
+		robot->weaponArray[i].chargeEnergy = 0;
+	}
+
+	//Set starting energy priorites in same order as SYSTEMS declaration.
+	for (i = 0; i < NUM_ENERGY_SYSTEMS; i++)
+		robot->energyPriorities[i] = (SYSTEM) i;
+
+	//Set initial energy values.  Weapons were done in the weapons section.
+	robot->shields = START_SHIELD_ENERGY;
+	robot->shieldChargeRate = 0;
+
+	//Set structure-related values
+	robot->generatorStructure = MAX_GENERATOR_STRUCTURE;
+
+	//Robot has no damage to be applied at start.
+	robot->damageBank = 0;
+
+	strcpy(robot->statusMessage, "");     //No status message at start.
+	ClearOrders(&robot->orders);
+	robot->randomState = NextRandom(&gameRandomState);  //Seed its stream.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetUpRobot
+//
+// Description: This function places a robot at its start location and runs
+//              its configuration function.  The robot must be in the robot
+//              list because ChooseRandomLocation() checks the others.
+//
+// Parameters: ROBOT *robot - The robot, with InitRobotState() done.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SetUpRobot(ROBOT *robot) {
+	curRobot = robot;                  //Record current robot for configuration.
+
+	if (robot->startX < 0 || robot->startY < 0)
+		ChooseRandomLocation(robot);
+	else {
+		robot->x = robot->startX;
+		robot->y = robot->startY;
+	}
+	if (robot->startHeading < 0)
+		robot->heading = GetRandomNumber(360);
+	else
+		robot->heading = robot->startHeading;
+
+	if (robot->remote != NULL)          //Remote robots say hello again.
+		pendingRemote = robot->remote;
+	TakeRobotView(robot);               //The API works on the view, so the
+	robot->ConfigureFunction();         //configuration's orders are applied
+	CopyOrders(&setupOrders[robot->number], &robot->orders);  //straight
+	strcpy(setupMessages[robot->number],          //afterwards.  They are kept
+			robot->view.statusMessage);           //for LogMatchCommands().
+	ApplyRobotOrders(robot);
+	UpdateHeadingTrig(robot);           //Heading and sensors are now known.
+	pendingRemote = NULL;
+	curRobot = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NextRandom
+//
+// Description: This function steps a random number stream (a simple LCG).
+//
+// Parameters: unsigned int *state - The stream.
+//
+// Returns: unsigned int - A random number, 0<=x<2^24.  The low bits of an
+//                         LCG are poor so they are dropped.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned int NextRandom(unsigned int *state) {
+	*state = *state * 1103515245u + 12345u;
+	return *state >> 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartMatch
+//
+// Description: This function starts the robots' sandboxes, if used, and puts
+//              the game in the fighting state.  Every robot is registered by
+//              now, so the sandboxes' child processes start with a full copy.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void StartMatch(void) {
+#ifdef SANDBOX_ROBOTS
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		if (robot->sandbox == NULL && loggedCommands == NULL)  //Puppets have
+			robot->sandbox = StartSandbox(robot, GiveRobotOrders);  //no code.
+#endif
+	theGame.state = GS_FIGHTING;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunCalculation
+//
+// Description: This function advances the match by one calculation: energy,
+//              movement, collisions, weapons, damage, sensors and particles,
+//              then the robots' orders every ORDER_FREQ calculations.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RunCalculation(void) {
+	int i;
+	long long start = StartStage();
+	long long mark = start;               //Start of the stage (profile.h).
+
+	matchTick++;
+
+	UpdateEnergySystems(robotList);           //Do first so we know what
+											  //systems are powered.
+	mark = MarkStage(TS_ENERGY, mark);
+	MoveRobots(robotList);
+	mark = MarkStage(TS_MOVE_ROBOTS, mark);
+	DrawRobotBitmaps(robotList);
+	mark = MarkStage(TS_DRAW_ROBOTS, mark);
+	CheckRobotCollisions(&theGame, robotList);
+	mark = MarkStage(TS_ROBOT_COLLISIONS, mark);
+
+	MoveWeapons(weaponList);
+	mark = MarkStage(TS_MOVE_WEAPONS, mark);
+	CheckWeaponCollisions(&theGame, robotList, weaponList);
+	mark = MarkStage(TS_WEAPON_COLLISIONS, mark);
+
+	//Now that collisions are
+	if (ApplyDamage(&theGame, robotList, deadRobotList) > 0)  //done and
+		lastAction = matchTick;          //weapons have hit, we apply damage.
+	mark = MarkStage(TS_DAMAGE, mark);
+
+	DrawSensorBitmaps(robotList);          //Need to draw BEFORE data is
+										   //updated because bimaps are
+										   //used in collision detection.
+	mark = MarkStage(TS_DRAW_SENSORS, mark);
+	UpdateSensorData(robotList);
+	mark = MarkStage(TS_SENSOR_DATA, mark);
+
+	UpdateParticles();
+	mark = MarkStage(TS_PARTICLES, mark);
+
+	if (matchTick % ORDER_FREQ == 0 && loggedCommands != NULL) {
+		TakeRobotViews();                 //Orders come from the log
+		ReadLoggedCommands();             //instead of the robots.  See
+		ApplyOrders();                    //ResimulateMatch().
+	} else if (matchTick % ORDER_FREQ == 0) {
+#ifdef PIPELINED_ORDERS
+		FinishOrders();     //Orders given from last order tick's views
+		ApplyOrders();      //are applied now, always one period late,
+		TakeRobotViews();   //then the next orders are started and the
+		StartOrders();      //simulation carries on while they run.
+		ExchangeRemoteOrders();
+#else
+		TakeRobotViews();                 //Every robot sees the same
+		GiveOrders();                        //tick, and their orders
+		ApplyOrders();                  //are applied in list order.
+#endif
+	}
+	if (matchTick % ORDER_FREQ == 0)
+		mark = MarkStage(TS_ORDERS, mark);
+	TraceSpan("Calculation", start, mark, "tick", matchTick);
+	MarkAllocTick();
+
+	if (recorder != NULL)
+		RecordCalculation(recorder, matchTick, robotList, deadRobotList,
+				weaponList, theGame.playSound);
+	if (checksums != NULL)
+		WriteChecksum(checksums, matchTick, robotList, deadRobotList,
+				weaponList, gameRandomState);
+
+	if (theGame.useSounds)
+		PlaySounds(&theGame);
+	else
+		for (i = 0; i < NUM_SOUNDS; i++)   //Only this calculation's sounds
+			theGame.playSound[i] = 0;      //are ever recorded.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckMatchEnd
+//
+// Description: This function ends the match, after a calculation, if at most
+//              one robot is left, the time limit has been reached or nothing
+//              has happened for too long.  Orders being given in the
+//              background are finished.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if the match is over, 0 if it carries on.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckMatchEnd(void) {
+	if (matchEnd != MATCH_RUNNING)
+		return 1;
+
+	if (SizeLL(robotList) <= 1 && SizeLL(deadRobotList) > 0)
+		matchEnd = MATCH_KNOCKOUT;
+	else if (matchCalcLimit > 0 && matchTick >= matchCalcLimit)
+		matchEnd = MATCH_TIME_LIMIT;
+	else if (stalemateLimit > 0 && matchTick - lastAction >= stalemateLimit)
+		matchEnd = MATCH_STALEMATE;
+	else
+		return 0;
+
+	FinishOrders();
+	theGame.state = GS_OVER;
+	StopRecording();
+	StopLoggingCommands();
+	StopChecksums();
+	PrintMatchCounts();
+	PrintMatchProfiles();
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopRecording
+//
+// Description: This function ends the recording started by RecordMatch(),
+//              if there is one, with the match result as it stands.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void StopRecording(void) {
+	MATCH_RESULT result;
+
+	if (recorder == NULL)
+		return;
+	GetMatchResult(&result);
+	StopRecorder(recorder, &result);
+	recorder = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopLoggingCommands
+//
+// Description: This function ends the log started by LogMatchCommands(), if
+//              there is one, with the match result if the match is over.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void StopLoggingCommands(void) {
+	MATCH_RESULT result;
+
+	if (commandLog == NULL)
+		return;
+	GetMatchResult(&result);
+	StopCommandLog(commandLog, matchEnd != MATCH_RUNNING ? &result : NULL);
+	commandLog = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopChecksums
+//
+// Description: This function ends the checksum file started by
+//              ChecksumMatch(), if there is one.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void StopChecksums(void) {
+	if (checksums == NULL)
+		return;
+	CloseChecksumFile(checksums);
+	checksums = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintMatchCounts
+//
+// Description: This function prints the hardware counts of each stage and
+//              of each robot's orders since they were last printed, if the
+//              counters are on, and starts them again.  A robot in a
+//              sandbox is counted only for the time spent waiting on it.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PrintMatchCounts(void) {
+	ROBOT *robot;
+
+	if (!PerfCountersOn())
+		return;
+	printf("Hardware counts to calculation %d:\n", matchTick);
+	PrintStageCounts(stdout);
+	PrintPerfHeader(stdout, "Robot orders");
+	ForeachLL_M(robotList, robot)
+		PrintPerfCounts(stdout, robot->name, &robotCounts[robot->number],
+				robotTurns[robot->number]);
+	ForeachLL_M(deadRobotList, robot)
+		PrintPerfCounts(stdout, robot->name, &robotCounts[robot->number],
+				robotTurns[robot->number]);
+	memset(robotCounts, 0, sizeof(robotCounts));
+	memset(robotTurns, 0, sizeof(robotTurns));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintMatchProfiles
+//
+// Description: This function prints every robot's profile, if
+//              SetProfileReport() was given a file.  They are kept until
+//              the next match starts, for GetRobotProfile().
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PrintMatchProfiles(void) {
+	FILE *file = GetProfileReport();
+	ROBOT *robot;
+	char title[64];
+
+	if (file == NULL)
+		return;
+	sprintf(title, "Robot turns to calculation %d", matchTick);
+	PrintProfileHeader(file, title);
+	ForeachLL_M(robotList, robot)
+		PrintRobotProfile(file, robot->name, &robotProfiles[robot->number]);
+	ForeachLL_M(deadRobotList, robot)
+		PrintRobotProfile(file, robot->name, &robotProfiles[robot->number]);
+	fflush(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LogRobotOrders
+//
+// Description: This function logs the commands about to be applied to a
+//              robot, leaving out those that would set something to the
+//              value it already has.  Robots repeat most of their settings
+//              (status messages above all) every turn, and leaving the
+//              repeats out makes logs several times smaller.
+//
+// Parameters: ROBOT *robot - The robot, before its orders are applied.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void LogRobotOrders(ROBOT *robot) {
+	static COMMAND_BUFFER changes;         //Only used by the main thread.
+	COMMAND *command;
+	int i, j, same;
+
+	changes.count = 0;
+	changes.messages = robot->orders.messages;      //Messages sent are
+	changes.messageCount = robot->orders.messageCount;  //always logged.
+	for (i = 0; i < robot->orders.count; i++) {
+		command = &robot->orders.commands[i];
+		switch (command->type) {
+		case CMD_MOTOR_SPEEDS:
+			same = robot->leftTreadSpeed == command->args[0]
+					&& robot->rightTreadSpeed == command->args[1];
+			break;
+		case CMD_SENSOR_STATUS:
+			same = robot->sensorArray[command->args[0]].on == command->args[1];
+			break;
+		case CMD_CHARGE_RATE:
+			if (command->args[0] == SYSTEM_SHIELDS)
+				same = robot->shieldChargeRate == command->args[1];
+			else if (command->args[0] == SYSTEM_LASERS)
+				same = robot->weaponArray[LASER_PORT].chargeRate
+						== command->args[1];
+			else
+				same = robot->weaponArray[MISSILE_PORT].chargeRate
+						== command->args[1];
+			break;
+		case CMD_CHARGE_PRIORITIES:
+			same = 1;
+			for (j = 0; j < NUM_ENERGY_SYSTEMS; j++)
+				same &= robot->energyPriorities[j] == command->args[j];
+			break;
+		case CMD_CLEAR_BUMP:
+			same = (robot->bumped & command->args[0]) == 0;
+			break;
+		case CMD_STATUS_MESSAGE:
+			same = strcmp(robot->statusMessage, robot->view.statusMessage)
+					== 0;
+			break;
+		default:                           //These depend on more than the
+			same = 0;                      //value given.
+		}
+		if (!same)
+			changes.commands[changes.count++] = *command;
+	}
+	LogOrders(commandLog, matchTick, robot->number, &changes,
+			robot->view.statusMessage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SaveRobot
+//
+// Description: This function adds a robot to a snapshot: the ROBOT itself
+//              (its pointers are ignored on restore), only the commands and
+//              messages given, its mailbox and the statics of its code if it
+//              saves them.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being written.
+//             ROBOT *robot - The robot to save.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SaveRobot(SNAPSHOT *snapshot, ROBOT *robot) {
+	int afterOrders = offsetof(ROBOT, orders) + sizeof(COMMAND_BUFFER);
+	int count;
+	INT_32 *message;
+
+	WriteSnapshot(snapshot, robot, offsetof(ROBOT, orders));
+	WriteSnapshot(snapshot, &robot->orders.count, sizeof(int));
+	WriteSnapshot(snapshot, robot->orders.commands,
+			robot->orders.count * sizeof(COMMAND));
+	WriteSnapshot(snapshot, &robot->orders.dropped, sizeof(int));
+	WriteSnapshot(snapshot, &robot->orders.messageCount, sizeof(int));
+	WriteSnapshot(snapshot, robot->orders.messages,
+			robot->orders.messageCount * sizeof(SENT_MESSAGE));
+	WriteSnapshot(snapshot, (char *) robot + afterOrders,
+			sizeof(ROBOT) - afterOrders);
+
+	count = SizeLL(robot->mailBox);
+	WriteSnapshot(snapshot, &count, sizeof(count));
+	ForeachLL_M(robot->mailBox, message)
+		WriteSnapshot(snapshot, message, sizeof(INT_32));
+
+	count = 0;
+	if (robot->SaveStateFunction != NULL)
+		count = robot->SaveStateFunction(NULL, 0);
+	WriteSnapshot(snapshot, &count, sizeof(count));
+	if (count > 0)
+		robot->SaveStateFunction(ReserveSnapshot(snapshot, count), count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckMatch
+//
+// Description: This function reads through a snapshot, without changing
+//              anything, to make sure RestoreMatch() can put all of it back.
+//              It reads from the snapshot's current position.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//             ROBOT **byNumber - Every robot, by number.
+//             ROBOT **order - Set to the robots in the order they were saved.
+//             void **states - Set to the statics saved for each robot in
+//                             order, within the snapshot.
+//             int *stateSizes - Set to their sizes.
+//
+// Returns: int - 1 if the snapshot can be restored, 0 if it is damaged or
+//                from another match setup.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckMatch(SNAPSHOT *snapshot, ROBOT **byNumber, ROBOT **order,
+		void **states, int *stateSizes) {
+	int header[8], listed[MAX_ROBOTS], i, count, alive, dead;
+
+	count = SizeLL(robotList) + SizeLL(deadRobotList);
+	if (ReadSnapshot(snapshot, header, sizeof(header)) == NULL
+			|| header[0] != SNAPSHOT_MAGIC || header[1] != SNAPSHOT_VERSION
+			|| header[2] != count
+			|| ReadSnapshot(snapshot, NULL, sizeof(theGame.playSound)) == NULL
+			|| ReadSnapshot(snapshot, NULL, sizeof(robotAlive)) == NULL
+			|| ReadSnapshot(snapshot, NULL, sizeof(remoteGps)) == NULL)
+		return 0;
+
+	for (i = 0; i < MAX_ROBOTS; i++)
+		listed[i] = 0;
+	if ((alive = CheckListOrder(snapshot, byNumber, order, listed)) < 0
+			|| (dead = CheckListOrder(snapshot, byNumber, order + alive,
+					listed)) < 0 || alive + dead != count)
+		return 0;                          //Every robot exactly once.
+
+	for (i = 0; i < count; i++)
+		if (!CheckRobot(snapshot, order[i], &states[i], &stateSizes[i]))
+			return 0;
+	return CheckWeapons(snapshot, byNumber) && CheckParticles(snapshot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckListOrder
+//
+// Description: This function reads a list of robot numbers saved by
+//              SaveMatch() and makes sure each is a robot not already
+//              listed.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//             ROBOT **byNumber - Every robot, by number.
+//             ROBOT **order - Set to the robots in the list.
+//             int *listed - By number, set for robots already listed.
+//
+// Returns: int - The number of robots in the list, or -1 if the snapshot is
+//                damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckListOrder(SNAPSHOT *snapshot, ROBOT **byNumber, ROBOT **order,
+		int *listed) {
+	int count, number, i;
+
+	if (ReadSnapshot(snapshot, &count, sizeof(count)) == NULL || count < 0
+			|| count > MAX_ROBOTS)
+		return -1;
+	for (i = 0; i < count; i++) {
+		if (ReadSnapshot(snapshot, &number, sizeof(number)) == NULL
+				|| number < 0 || number >= MAX_ROBOTS
+				|| byNumber[number] == NULL || listed[number])
+			return -1;
+		listed[number] = 1;
+		order[i] = byNumber[number];
+	}
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckRobot
+//
+// Description: This function reads through a robot saved by SaveRobot(),
+//              checking its counts and that it is the right robot.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//             ROBOT *robot - The robot it should be.
+//             void **state - Set to the statics saved for it.
+//             int *stateSize - Set to their size, 0 if there are none.
+//
+// Returns: int - 1 if successful, 0 if the snapshot is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckRobot(SNAPSHOT *snapshot, ROBOT *robot, void **state,
+		int *stateSize) {
+	int afterOrders = offsetof(ROBOT, orders) + sizeof(COMMAND_BUFFER);
+	int number, count;
+	char *start;
+
+	if ((start = ReadSnapshot(snapshot, NULL, offsetof(ROBOT, orders)))
+			== NULL || ReadSnapshot(snapshot, &count, sizeof(int)) == NULL
+			|| count < 0 || count > MAX_COMMANDS
+			|| ReadSnapshot(snapshot, NULL, count * sizeof(COMMAND)) == NULL
+			|| ReadSnapshot(snapshot, NULL, sizeof(int)) == NULL
+			|| ReadSnapshot(snapshot, &count, sizeof(int)) == NULL
+			|| count < 0 || count > INT_MAX / (int) sizeof(SENT_MESSAGE)
+			|| ReadSnapshot(snapshot, NULL, count * sizeof(SENT_MESSAGE))
+					== NULL
+			|| ReadSnapshot(snapshot, NULL, sizeof(ROBOT) - afterOrders)
+					== NULL
+			|| ReadSnapshot(snapshot, &count, sizeof(count)) == NULL
+			|| count < 0 || count > INT_MAX / (int) sizeof(INT_32)
+			|| ReadSnapshot(snapshot, NULL, count * sizeof(INT_32)) == NULL
+			|| ReadSnapshot(snapshot, stateSize, sizeof(int)) == NULL
+			|| (*state = ReadSnapshot(snapshot, NULL, *stateSize)) == NULL)
+		return 0;
+	memcpy(&number, start + offsetof(ROBOT, number), sizeof(int));
+	return number == robot->number;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckWeapons
+//
+// Description: This function reads through the weapons saved by SaveMatch(),
+//              checking their owners.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//             ROBOT **byNumber - Every robot, by number.
+//
+// Returns: int - 1 if successful, 0 if the snapshot is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CheckWeapons(SNAPSHOT *snapshot, ROBOT **byNumber) {
+	int count, owner;
+
+	if (ReadSnapshot(snapshot, &count, sizeof(count)) == NULL || count < 0)
+		return 0;
+	for (; count > 0; count--)
+		if (ReadSnapshot(snapshot, &owner, sizeof(owner)) == NULL
+				|| ReadSnapshot(snapshot, NULL, sizeof(WEAPON)) == NULL
+				|| owner < 0 || owner >= MAX_ROBOTS || byNumber[owner] == NULL)
+			return 0;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LoadRobotStates
+//
+// Description: This function gives each robot's code the statics saved for
+//              it.  The statics are saved first, so if any robot's code
+//              can't use what it is given, those already loaded are put
+//              back.
+//
+// Parameters: ROBOT **order - The robots.
+//             int count - How many.
+//             void **states - The statics saved for each robot.
+//             int *stateSizes - Their sizes.
+//
+// Returns: int - 1 if successful, 0 if a robot's code refused its statics.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int LoadRobotStates(ROBOT **order, int count, void **states,
+		int *stateSizes) {
+	SNAPSHOT current;
+	int i, j, size;
+
+	for (i = 0; i < count; i++)
+		if (stateSizes[i] > 0 && order[i]->LoadStateFunction != NULL)
+			break;
+	if (i == count)                        //The usual case: nothing to do.
+		return 1;
+
+	InitSnapshot(&current);
+	for (i = 0; i < count; i++)
+		if (stateSizes[i] > 0 && order[i]->LoadStateFunction != NULL) {
+			size = order[i]->SaveStateFunction(NULL, 0);
+			WriteSnapshot(&current, &size, sizeof(size));
+			if (size > 0)
+				order[i]->SaveStateFunction(ReserveSnapshot(&current, size),
+						size);
+		}
+
+	for (i = 0; i < count; i++)
+		if (stateSizes[i] > 0 && order[i]->LoadStateFunction != NULL
+				&& !order[i]->LoadStateFunction(states[i], stateSizes[i]))
+			break;
+	if (i < count)                         //Put back all up to the one that
+		for (j = 0; j <= i; j++)           //refused, which may be half done.
+			if (stateSizes[j] > 0 && order[j]->LoadStateFunction != NULL) {
+				ReadSnapshot(&current, &size, sizeof(size));
+				if (size > 0)
+					order[j]->LoadStateFunction(
+							ReadSnapshot(&current, NULL, size), size);
+			}
+	FreeSnapshot(&current);
+	return i == count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RestoreRobot
+//
+// Description: This function reads back a robot saved by SaveRobot().  The
+//              robot keeps its own name, functions, images, mailbox list,
+//              message store, sandbox and remote connection.  Its statics
+//              are skipped, having been loaded by LoadRobotStates().
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read, which
+//                                  CheckMatch() has passed.
+//             ROBOT *robot - The robot to restore.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RestoreRobot(SNAPSHOT *snapshot, ROBOT *robot) {
+	int afterOrders = offsetof(ROBOT, orders) + sizeof(COMMAND_BUFFER);
+	int i, count, messageCount;
+	SENT_MESSAGE *messages;
+	INT_32 *mail;
+	ROBOT saved;
+
+	ReadSnapshot(snapshot, &saved, offsetof(ROBOT, orders));
+	ReadSnapshot(snapshot, &count, sizeof(int));
+	ReadSnapshot(snapshot, saved.orders.commands, count * sizeof(COMMAND));
+	ReadSnapshot(snapshot, &saved.orders.dropped, sizeof(int));
+	ReadSnapshot(snapshot, &messageCount, sizeof(int));
+	messages = ReadSnapshot(snapshot, NULL,
+			messageCount * sizeof(SENT_MESSAGE));
+	ReadSnapshot(snapshot, (char *) &saved + afterOrders,
+			sizeof(ROBOT) - afterOrders);
+	saved.orders.count = count;
+	saved.orders.messages = robot->orders.messages;
+	saved.orders.messageCount = 0;
+	saved.orders.messageRoom = robot->orders.messageRoom;
+	saved.orders.messagesFixed = robot->orders.messagesFixed;
+	for (i = 0; i < messageCount; i++)
+		if (!AddSentMessage(&saved.orders, messages[i].to, messages[i].data))
+			saved.orders.dropped++;
+
+	saved.ActionsFunction = robot->ActionsFunction;
+	saved.ConfigureFunction = robot->ConfigureFunction;
+	saved.SaveStateFunction = robot->SaveStateFunction;
+	saved.LoadStateFunction = robot->LoadStateFunction;
+	saved.name = robot->name;
+	saved.mailBox = robot->mailBox;
+	saved.sandbox = robot->sandbox;
+	saved.remote = robot->remote;
+	saved.graphic = robot->graphic;
+	saved.image = robot->image;
+	for (i = 0; i < MAX_SENSORS; i++) {
+		saved.sensorArray[i].image = robot->sensorArray[i].image;
+		if (saved.sensorArray[i].type == SENSOR_RADAR      //Configured
+				&& saved.sensorArray[i].image == NULL) {   //differently.
+			saved.sensorArray[i].image = CreateBitmap(MA_RADAR_BITMAPS,
+					RADAR_IMAGE_PX, RADAR_IMAGE_PX);
+			if (saved.sensorArray[i].image == NULL)
+				AbortOnError("RestoreMatch() failed to create a radar bitmap.\n"
+						"Program will end.");
+		}
+	}
+	*robot = saved;
+
+	ReadSnapshot(snapshot, &count, sizeof(count));
+	mail = ReadSnapshot(snapshot, NULL, count * sizeof(INT_32));
+	EmptyLL(robot->mailBox);
+	for (i = 0; i < count; i++)
+		InsLastLL(robot->mailBox, mail[i]);
+
+	ReadSnapshot(snapshot, &count, sizeof(count));
+	ReadSnapshot(snapshot, NULL, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RestoreListOrder
+//
+// Description: This function reads a list of robot numbers from a snapshot
+//              and moves those robots, in that order, to the end of a list.
+//              Done for the living and then the dead, every robot ends up in
+//              the list, and the place, it was saved in.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read, which
+//                                  CheckMatch() has passed.
+//             t_LL list - robotList or deadRobotList.
+//             ROBOT **byNumber - Every robot, by number.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RestoreListOrder(SNAPSHOT *snapshot, t_LL list, ROBOT **byNumber) {
+	int count, number;
+	ROBOT *robot;
+
+	ReadSnapshot(snapshot, &count, sizeof(count));
+	while (count-- > 0) {
+		ReadSnapshot(snapshot, &number, sizeof(number));
+		robot = byNumber[number];
+		UnlinkLL(robot);
+		LinkAftLL(LastElmLL(list), robot);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RestoreWeapons
+//
+// Description: This function replaces the weapons in flight with those in a
+//              snapshot.  Existing weapons are overwritten, keeping their
+//              bitmap if it is the right kind, before any more are created.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read, which
+//                                  CheckMatch() has passed.
+//             ROBOT **byNumber - Every robot, by number, for the owners.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RestoreWeapons(SNAPSHOT *snapshot, ROBOT **byNumber) {
+	WEAPON *weapon, *nextWeapon, saved;
+	int count, owner;
+
+	ReadSnapshot(snapshot, &count, sizeof(count));
+	weapon = FirstElmLL(weaponList);
+	for (; count > 0; count--) {
+		ReadSnapshot(snapshot, &owner, sizeof(owner));
+		ReadSnapshot(snapshot, &saved, sizeof(WEAPON));
+		saved.owner = byNumber[owner];
+
+		if (!IsElmLL(weapon)) {                         //Need another one.
+			saved.image = NULL;
+			InsLastLL(weaponList, saved);
+			weapon = LastElmLL(weaponList);
+		} else if (weapon->type != saved.type) {        //Wrong size bitmap.
+			DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+			saved.image = NULL;
+		} else
+			saved.image = weapon->image;
+		if (saved.image == NULL) {
+			saved.image = saved.type == WEAPON_LASER ?
+					CreateBitmap(MA_WEAPON_BITMAPS, LASER_BMP_SZ, LASER_BMP_SZ) :
+					CreateBitmap(MA_WEAPON_BITMAPS, MISSILE_BMP_SZ,
+							MISSILE_BMP_SZ);
+			if (saved.image == NULL)
+				AbortOnError("RestoreMatch() failed to create a weapon "
+						"bitmap.\nProgram will end.");
+		}
+		*weapon = saved;
+		DrawWeaponBitmap(weapon);
+		weapon = NextElmLL(weapon);
+	}
+
+	for (; IsElmLL(weapon); weapon = nextWeapon) {   //Delete any left over.
+		nextWeapon = NextElmLL(weapon);
+		if (weapon->image != NULL)
+			DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+		DelElmLL(weapon);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PlaySounds
+//
+// Description: This function plays sounds based on the requests in the game's
+//              state.  Once fulfilled, these requests are turned off.
+//
+// Parameters: GAME *game - Pointer to the game's state.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PlaySounds(GAME *game) {
+	int i;
+	for (i = 0; i < NUM_SOUNDS; i++)
+		if (game->playSound[i]) {
+			play_sample(game->sounds[i], 255, 128, 1000, 0);
+			game->playSound[i] = 0;
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TakeRobotViews
+//
+// Description: This function prepares every living robot to give orders.  It
+//              refreshes robotAlive and takes each robot's view.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void TakeRobotViews(void) {
+	ROBOT *robot;
+	int i;
+
+	orderTick++;
+	for (i = 0; i < MAX_ROBOTS; i++)
+		robotAlive[i] = 0;
+	ForeachLL_M(robotList, robot)
+		robotAlive[robot->number] = 1;
+	ForeachLL_M(robotList, robot)     //Views hold robotAlive, so every
+		TakeRobotView(robot);         //flag must be set first.
+}
+
+#ifndef PIPELINED_ORDERS
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GiveOrders
+//
+// Description: This function calls every living robot's orders function.
+//              It isn't used with PIPELINED_ORDERS defined, as the orders
+//              are then started and finished at different ticks.  With
+//              PARALLEL_ORDERS defined each group of robots sharing an
+//              orders function is one job.  Robots in a group run one after
+//              another, in list order, as they share the function's statics.
+//              The order phase then takes as long as the slowest group rather
+//              than the sum of them all.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GiveOrders(void) {
+#ifdef PARALLEL_ORDERS
+	StartOrders();
+	ExchangeRemoteOrders();        //Wait on the brains while the others think.
+	FinishOrders();
+#else
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		RunRobotTurn(robot);
+	ExchangeRemoteOrders();
+#endif
+}
+#endif
+
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartOrders
+//
+// Description: This function queues the jobs that call the robots' orders
+//              functions and returns without waiting for them.  Jobs only
+//              touch each robot's view, command buffer and random stream, so
+//              the simulation can carry on until FinishOrders() is called.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void StartOrders(void) {
+	ROBOT *robot;
+	int i, j;
+
+	GatherElements(robotList, &orderArray);
+	InitJobBatch(&orderBatch);
+	for (i = 0; i < orderArray.count; i++) {
+		robot = orderArray.items[i];
+		for (j = 0; j < i && robot->sandbox == NULL; j++)   //Sandboxed robots
+			if (((ROBOT *) orderArray.items[j])->ActionsFunction  //have their
+					== robot->ActionsFunction                   //own statics.
+					&& ((ROBOT *) orderArray.items[j])->sandbox == NULL)
+				break;
+		orderGroups[i] = robot->sandbox == NULL ? j : i;
+	}
+	for (i = 0; i < orderArray.count; i++)    //Only once every group is known,
+		if (orderGroups[i] == i)          //as a worker may start a job while
+			AddJob(&orderBatch, GiveGroupOrders, NULL, i, i + 1); //they're added.
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FinishOrders
+//
+// Description: This function waits until the jobs queued by StartOrders()
+//              are done.  It returns at once if no orders are being given,
+//              which is always the case without PARALLEL_ORDERS or
+//              PIPELINED_ORDERS defined.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void FinishOrders(void) {
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+	WaitJobBatch(&orderBatch);
+#endif
+}
+
+#if defined(PARALLEL_ORDERS) || defined(PIPELINED_ORDERS)
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GiveGroupOrders
+//
+// Description: This is the job for StartOrders().  It calls the orders
+//              function of every robot in the group led by robot begin.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GiveGroupOrders(void *data, int begin, int end) {
+	int i;
+
+	for (i = begin; i < orderArray.count; i++)
+		if (orderGroups[i] == begin)
+			RunRobotTurn(orderArray.items[i]);
+}
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunRobotTurn
+//
+// Description: This function has a robot give its orders, in its sandbox if
+//              it has one.
+//
+// Parameters: ROBOT *robot - The robot, with its view already taken.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RunRobotTurn(ROBOT *robot) {
+	PERF_COUNTS before, after;
+	long long start, end, cpuStart;
+	int counted;
+
+	if (robot->remote != NULL)
+		return;                        //See ExchangeRemoteOrders().
+	start = ReadTimer();
+	cpuStart = ReadThreadTime();
+	counted = ReadThreadCounters(&before);
+	if (robot->sandbox != NULL)
+		RunSandboxTurn(robot->sandbox, robot);
+	else
+		GiveRobotOrders(robot);
+	if (counted && ReadThreadCounters(&after)) {  //Only this thread writes
+		robotTurns[robot->number]++;              //this robot's counts.
+		AddPerfCounts(&robotCounts[robot->number], &before, &after);
+	}
+	end = ReadTimer();
+	AddRobotTurn(&robotProfiles[robot->number], end - start,
+			robot->sandbox == NULL && cpuStart >= 0   //A sandboxed robot's
+					? ReadThreadTime() - cpuStart : -1);  //CPU is the child's.
+	TraceRobotSpan("Robot orders", start, end, robot->name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GiveRobotOrders
+//
+// Description: This function calls a robot's orders function with curRobot
+//              set.  In a sandbox it is called by the child process.
+//
+// Parameters: ROBOT *robot - The robot, with its view already taken.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GiveRobotOrders(ROBOT *robot) {
+	curRobot = robot;
+	curRobot->ActionsFunction(TURN_TIME);
+	curRobot = NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TakeRobotView
+//
+// Description: This function copies the parts of a robot the API can read
+//              into its view, along with which robots are alive, and empties
+//              its command buffer.
+//
+// Parameters: ROBOT *robot - The robot about to give orders.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void TakeRobotView(ROBOT *robot) {
+	ROBOT_VIEW *view = &robot->view;
+	INT_32 *message;
+	int i;
+
+	view->x = robot->x;
+	view->y = robot->y;
+	view->heading = robot->heading;
+	view->turboTime = robot->turboTime;
+	view->shields = robot->shields;
+	view->generatorStructure = robot->generatorStructure;
+	view->bumped = robot->bumped;
+	for (i = 0; i < MAX_WEAPONS; i++)
+		view->chargeEnergy[i] = robot->weaponArray[i].chargeEnergy;
+	for (i = 0; i < MAX_SENSORS; i++) {
+		view->sensorType[i] = robot->sensorArray[i].type;
+		view->sensorOn[i] = robot->sensorArray[i].on;
+		view->sensorPowered[i] = robot->sensorArray[i].powered;
+		view->sensorData[i] = robot->sensorArray[i].data;
+	}
+
+	view->mailCount = 0;              //Copy the oldest messages.  Any beyond
+	view->mailRead = 0;               //MAILBOX_VIEW_SIZE wait for next turn.
+	ForeachLL_M(robot->mailBox, message)
+	{
+		if (view->mailCount == MAILBOX_VIEW_SIZE)
+			break;
+		view->mail[view->mailCount++] = *message;
+	}
+
+	strcpy(view->statusMessage, robot->statusMessage);
+	memcpy(view->robotAlive, robotAlive, sizeof(robotAlive));
+	ClearOrders(&robot->orders);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NewCommand
+//
+// Description: This function finds a command already in the current robot's
+//              buffer.
+//
+// Parameters: COMMANDTYPE type - The type of command.
+//             int replace - REPLACE_TYPE or REPLACE_TARGET.
+//             int key - With REPLACE_TARGET, the args[0] to look for.
+//
+// Returns: COMMAND* - The first such command, or NULL if there isn't one.
+//
+////////////////////////////////////////////////////////////////////////////////
+static COMMAND *FindCommand(COMMANDTYPE type, int replace, int key) {
+	COMMAND_BUFFER *orders = &curRobot->orders;
+	int i;
+
+	for (i = 0; i < orders->count; i++)
+		if (orders->commands[i].type == type && (replace == REPLACE_TYPE
+				|| orders->commands[i].args[0] == key))
+			return &orders->commands[i];
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NewCommand
+//
+// Description: This function adds a command to the current robot's buffer.
+//              Commands that simply set a value can replace an earlier one,
+//              as only the last value given in a turn matters.  A robot that
+//              has filled its buffer has the command dropped and counted
+//              against it; the API call should then fail.
+//
+// Parameters: COMMANDTYPE type - The type of command.
+//             int replace - NEW_COMMAND, REPLACE_TYPE or REPLACE_TARGET.
+//             int key - Stored in args[0].  With REPLACE_TARGET only a
+//                       command with the same args[0] is replaced.
+//
+// Returns: COMMAND* - The command, for the caller to fill out its arguments,
+//                     or NULL if it was dropped.
+//
+////////////////////////////////////////////////////////////////////////////////
+static COMMAND *NewCommand(COMMANDTYPE type, int replace, int key) {
+	COMMAND_BUFFER *orders = &curRobot->orders;
+	COMMAND *command = NULL;
+
+	if (replace != NEW_COMMAND)
+		command = FindCommand(type, replace, key);
+
+	if (command == NULL) {
+		if (orders->count == MAX_COMMANDS) {
+			orders->dropped++;
+			return NULL;
+		}
+		command = &orders->commands[orders->count++];
+	}
+
+	command->type = type;
+	command->args[0] = key;
+	return command;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitOrders
+//
+// Description: This function sets up an empty command buffer.  Messages sent
+//              go in a store of their own, which grows as needed, so a robot
+//              can send as many as it likes.  A sandboxed robot can't
+//              allocate, so its store is a fixed block in shared memory.
+//
+// Parameters: COMMAND_BUFFER *orders - The buffer.
+//             SENT_MESSAGE *messages - A fixed store, or NULL for one that
+//                                      grows.
+//             int room - Messages the fixed store holds.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitOrders(COMMAND_BUFFER *orders, SENT_MESSAGE *messages, int room) {
+	orders->messages = messages;
+	orders->messageRoom = messages != NULL ? room : 0;
+	orders->messagesFixed = messages != NULL;
+	ClearOrders(orders);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ClearOrders
+//
+// Description: This function empties a command buffer, keeping its store.
+//
+// Parameters: COMMAND_BUFFER *orders - The buffer.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ClearOrders(COMMAND_BUFFER *orders) {
+	orders->count = 0;
+	orders->dropped = 0;
+	orders->messageCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddSentMessage
+//
+// Description: This function adds a message to a command buffer's store,
+//              growing it if it is full.
+//
+// Parameters: COMMAND_BUFFER *orders - The buffer.
+//             int to - The addressee's robot number.
+//             INT_32 data - The message.
+//
+// Returns: int - 1 if successful, 0 if a fixed store is full or memory ran
+//                out.  The caller counts the message as dropped.
+//
+////////////////////////////////////////////////////////////////////////////////
+int AddSentMessage(COMMAND_BUFFER *orders, int to, INT_32 data) {
+	SENT_MESSAGE *grown;
+	int room;
+
+	if (orders->messageCount == orders->messageRoom) {
+		if (orders->messagesFixed)
+			return 0;
+		room = orders->messageRoom > 0 ? orders->messageRoom * 2 : 16;
+		grown = realloc(orders->messages, room * sizeof(SENT_MESSAGE));
+		if (grown == NULL)
+			return 0;
+		orders->messages = grown;
+		orders->messageRoom = room;
+	}
+	orders->messages[orders->messageCount].to = to;
+	orders->messages[orders->messageCount++].data = data;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CopyOrders
+//
+// Description: This function copies one command buffer's commands and
+//              messages into another, which keeps its own store.  Messages
+//              that don't fit are counted as dropped.
+//
+// Parameters: COMMAND_BUFFER *to - The buffer to fill.
+//             COMMAND_BUFFER *from - The buffer to copy.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void CopyOrders(COMMAND_BUFFER *to, COMMAND_BUFFER *from) {
+	int i;
+
+	memcpy(to->commands, from->commands, from->count * sizeof(COMMAND));
+	to->count = from->count;
+	to->dropped = from->dropped;
+	to->messageCount = 0;
+	for (i = 0; i < from->messageCount; i++)
+		if (!AddSentMessage(to, from->messages[i].to, from->messages[i].data))
+			to->dropped++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FreeOrders
+//
+// Description: This function frees a command buffer's store if it grew one.
+//
+// Parameters: COMMAND_BUFFER *orders - The buffer.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void FreeOrders(COMMAND_BUFFER *orders) {
+	if (!orders->messagesFixed)
+		free(orders->messages);
+	orders->messages = NULL;
+	orders->messageRoom = 0;
+	ClearOrders(orders);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ApplyOrders
+//
+// Description: This function applies every living robot's orders, in list
+//              order, so the results do not depend on when each robot's
+//              orders function ran.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ApplyOrders(void) {
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		ApplyRobotOrders(robot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ApplyRobotOrders
+//
+// Description: This function carries out a robot's commands on the robot
+//              itself.  Commands that depend on the robot's state are checked
+//              again, so a command that was valid against the view but no
+//              longer is (eg: shields drained since) simply fails.  The
+//              commands are logged first if LogMatchCommands() was called.
+//              Messages are delivered after the other commands, and any
+//              commands dropped are added to the robot's profile.
+//
+// Parameters: ROBOT *robot - The robot whose orders to apply.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ApplyRobotOrders(ROBOT *robot) {
+	COMMAND *command;
+	SENT_MESSAGE *message;
+	ROBOT *addressee;
+	int i, j;
+
+	if (commandLog != NULL && theGame.state != GS_SETUP)
+		LogRobotOrders(robot);
+
+	for (i = 0; i < robot->orders.count; i++) {
+		command = &robot->orders.commands[i];
+		switch (command->type) {
+		case CMD_MOTOR_SPEEDS:
+			robot->leftTreadSpeed = command->args[0];
+			robot->rightTreadSpeed = command->args[1];
+			break;
+		case CMD_TURBO_BOOST:
+			if (robot->shields > TURBOBOOST_COST) {
+				robot->shields -= TURBOBOOST_COST;
+				robot->turboTime = TURBOBOOST_TIME * CALCS_PER_SEC;
+				theGame.playSound[SND_TURBOBOOST] = 1;
+			}
+			break;
+		case CMD_SENSOR_STATUS:
+			robot->sensorArray[command->args[0]].on = command->args[1];
+			break;
+		case CMD_FIRE_WEAPON:
+			if (ApplyFireWeapon(robot, command->args[0], command->args[1]))
+				lastAction = matchTick;
+			break;
+		case CMD_CHARGE_RATE:
+			if (command->args[0] == SYSTEM_SHIELDS)
+				robot->shieldChargeRate = command->args[1];
+			else if (command->args[0] == SYSTEM_LASERS)
+				robot->weaponArray[LASER_PORT].chargeRate = command->args[1];
+			else
+				robot->weaponArray[MISSILE_PORT].chargeRate = command->args[1];
+			break;
+		case CMD_CHARGE_PRIORITIES:
+			for (j = 0; j < NUM_ENERGY_SYSTEMS; j++)
+				robot->energyPriorities[j] = command->args[j];
+			break;
+		case CMD_CLEAR_BUMP:
+			robot->bumped &= ~command->args[0];
+			break;
+		case CMD_USE_GPS:
+			if (robot->shields > GPS_COST)
+				robot->shields -= GPS_COST;
+			break;
+		case CMD_STATUS_MESSAGE:
+			strcpy(robot->statusMessage, robot->view.statusMessage);
+			break;
+		case CMD_SEND_MESSAGE:             //In robot->orders.messages.
+			break;
+		case CMD_READ_MESSAGE:
+			if (!IsEmptyLL(robot->mailBox))
+				DelElmLL(FirstElmLL(robot->mailBox));
+			break;
+		}
+	}
+	for (i = 0; i < robot->orders.messageCount; i++) {
+		message = &robot->orders.messages[i];
+		if ((addressee = LookupRobotByNumber(message->to)) != NULL)
+			InsLastLL(addressee->mailBox, message->data);
+	}
+	robotProfiles[robot->number].dropped += robot->orders.dropped;
+	ClearOrders(&robot->orders);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ApplyFireWeapon
+//
+// Description: This function fires the given weapon, if it is sufficiently
+//              powered and it meets firing arc requirements.  It is what
+//              FireWeapon() did before orders were buffered.
+//
+// Parameters: ROBOT *robot - The robot firing the weapon.
+//             WEAPONTYPE type - The weapon to fire.
+//             int heading - Angle relative to the robot's heading.
+//
+// Returns: int - 0 if weapon firing fails, 1 if successful.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ApplyFireWeapon(ROBOT *robot, WEAPONTYPE type, int heading) {
+	WEAPON_SYSTEM *weaponSys;
+	WEAPON weapon;
+	int imageX, imageY;
+
+	heading = heading % 360;     //Change heading so it is abs(heading)<360.
+	//Figure out which weapon is being examined and set the bitmap constants.
+	//Note: should the image vals be part of the weapon system for uniformity?
+	switch (type) {
+	case WEAPON_LASER:
+		weaponSys = &robot->weaponArray[LASER_PORT];
+		imageX = LASER_BMP_SZ;
+		imageY = LASER_BMP_SZ;
+		break;
+	case WEAPON_MISSILE:
+		weaponSys = &robot->weaponArray[MISSILE_PORT];
+		imageX = MISSILE_BMP_SZ;
+		imageY = MISSILE_BMP_SZ;
+		break;
+	default:
+		return 0;
+	}
+
+	//Check aiming and energy conditions.
+	if (heading < -weaponSys->maxAngle || heading > weaponSys->maxAngle)
+		return 0;
+	if (weaponSys->chargeEnergy < weaponSys->minEnergy) {
+		weaponSys->chargeEnergy = 0;     //Trying to fire without enough energy
+		return 0;                      //wastes the charged energy.
+	}
+
+	//Fill out remaining information and create the bitmap.
+	weapon.id = nextWeaponId++;
+	weapon.type = weaponSys->type;
+	weapon.owner = robot;
+	weapon.x = robot->x;
+	weapon.y = robot->y;
+	weapon.heading = BoundAngle(robot->heading - heading);
+	weapon.cosHeading = cos(weapon.heading * DEG_PER_RAD);
+	weapon.sinHeading = sin(weapon.heading * DEG_PER_RAD);
+	weapon.speed = weaponSys->speed;
+	weapon.energy = weaponSys->chargeEnergy
+			+ weaponSys->chargeEnergy * weaponSys->bonusEnergy;
+	weapon.splashRange = weaponSys->splashRange;
+	weapon.splashDamage = weaponSys->splashDamage;
+	weapon.bumpValue = weaponSys->bumpValue;
+	weapon.impactSound = weaponSys->impactSound;
+	weapon.image = CreateBitmap(MA_WEAPON_BITMAPS, imageX, imageY);
+
+	weaponSys->chargeEnergy = 0;            //Weapon fired: reset charge energy.
+
+	InsLastLL(weaponList, weapon);                //Put the weapon in the list.
+	DrawWeaponBitmap(LastElmLL(weaponList));     //Pass the weapon for bmp draw.
+	theGame.playSound[weaponSys->firingSound] = 1; //Play the weapon firing sound.
+	TraceInstant(type == WEAPON_LASER ? "Laser fired" : "Missile fired",
+			"robot", robot->number);
+
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ConfigureRemoteRobot
+//
+// Description: This is the configuration function of every remote robot.  It
+//              adds the sensors the brain asks for and gives its first
+//              orders (tick 0).  A robot with no brain, or whose brain
+//              doesn't answer, is left idle for the match, as one that stops
+//              answering mid-match is.  Its status message says so.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ConfigureRemoteRobot(void) {
+	REMOTE_SENSOR sensors[MAX_SENSORS];
+	int i, count;
+
+	curRobot->remote = pendingRemote;
+	if (curRobot->remote == NULL) {           //Never connected.
+		SetStatusMessage("No brain");
+		return;
+	}
+	count = RemoteHello(curRobot->remote, curRobot->number, curRobot->name,
+			sensors, MAX_SENSORS);
+	if (count < 0) {                  //The connection has failed, so it gives
+		SetStatusMessage("No brain");     //no orders from now on.
+		return;
+	}
+
+	for (i = 0; i < count; i++)
+		AddSensor(sensors[i].port, sensors[i].type, sensors[i].angle,
+				sensors[i].width, sensors[i].range);
+
+	count = ReceiveOrders(curRobot->remote, curRobot->number, 0,
+			remoteCommands, MAX_COMMANDS);
+	GiveRemoteOrders(curRobot, remoteCommands, count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RemoteRobotActions
+//
+// Description: The orders function of every remote robot.  It is never
+//              called as remote robots give orders in ExchangeRemoteOrders().
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RemoteRobotActions(int time) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ExchangeRemoteOrders
+//
+// Description: This function sends every remote robot's observation, one
+//              write per brain, and then gives the orders each brain sent for
+//              the observation GetRemoteLatency() order ticks ago, waiting
+//              for them if need be.  Robots' views must have been taken.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ExchangeRemoteOrders(void) {
+	ROBOT *robot;
+	int count, latency = GetRemoteLatency();
+
+	ForeachLL_M(robotList, robot)
+		if (robot->remote != NULL)
+			SendObservation(robot->remote, robot->number, orderTick, robot,
+					remoteGps[robot->number]);
+	ForeachLL_M(robotList, robot)
+		if (robot->remote != NULL)
+			FlushObservations(robot->remote);
+
+	if (orderTick <= latency)             //Tick 0's orders were given during
+		return;                           //registration.
+
+	ForeachLL_M(robotList, robot)
+		if (robot->remote != NULL) {
+			count = ReceiveOrders(robot->remote, robot->number,
+					orderTick - latency, remoteCommands, MAX_COMMANDS);
+			GiveRemoteOrders(robot, remoteCommands, count);
+		}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GiveRemoteOrders
+//
+// Description: This function gives a remote robot's commands through the
+//              robot API, so they are checked exactly as a compiled-in
+//              robot's calls would be.
+//
+// Parameters: ROBOT *robot - The robot, with its view taken.
+//             REMOTE_COMMAND *commands - The brain's commands.
+//             int count - Number of commands.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GiveRemoteOrders(ROBOT *robot, REMOTE_COMMAND *commands,
+		int count) {
+	SYSTEM priorities[NUM_ENERGY_SYSTEMS];
+	GPS_INFO gpsData;
+	INT_32 data;
+	ROBOT *previousRobot = curRobot;    //Set during registration.
+	int i, j, bits;
+
+	curRobot = robot;
+	remoteGps[robot->number] = 0;
+	for (i = 0; i < count; i++) {
+		switch (commands[i].type) {
+		case CMD_MOTOR_SPEEDS:
+			SetMotorSpeeds(commands[i].args[0], commands[i].args[1]);
+			break;
+		case CMD_TURBO_BOOST:
+			TurboBoost();
+			break;
+		case CMD_SENSOR_STATUS:
+			SetSensorStatus(commands[i].args[0], commands[i].args[1]);
+			break;
+		case CMD_FIRE_WEAPON:
+			FireWeapon(commands[i].args[0], commands[i].args[1]);
+			break;
+		case CMD_CHARGE_RATE:
+			SetSystemChargeRate(commands[i].args[0], commands[i].args[1]);
+			break;
+		case CMD_CHARGE_PRIORITIES:
+			for (j = 0; j < NUM_ENERGY_SYSTEMS; j++)
+				priorities[j] = commands[i].args[j];
+			SetSystemChargePriorites(priorities);
+			break;
+		case CMD_CLEAR_BUMP:                  //Only bumps the brain has been
+			bits = commands[i].args[0] & curRobot->view.bumped;  //told about.
+			if (bits != BUMP_NONE
+					&& NewCommand(CMD_CLEAR_BUMP, NEW_COMMAND, bits) != NULL)
+				curRobot->view.bumped &= ~bits;
+			break;
+		case CMD_USE_GPS:
+			remoteGps[robot->number] = GetGPSInfo(&gpsData);
+			break;
+		case CMD_SEND_MESSAGE:
+			if (commands[i].args[0] >= 0 && commands[i].args[0] < MAX_ROBOTS
+					&& robotAlive[commands[i].args[0]])
+				SendMessage(robotNames[commands[i].args[0]],
+						commands[i].args[1]);
+			break;
+		case CMD_READ_MESSAGE:
+			GetMessage(&data);
+			break;
+		default:                  //CMD_STATUS_MESSAGE and anything unknown.
+			break;
+		}
+	}
+	curRobot = previousRobot;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadLoggedCommands
+//
+// Description: This function gives every living robot the commands the log
+//              says were applied to it at this calculation.  Robots' views
+//              must have been taken, as a status message goes in the view.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ReadLoggedCommands(void) {
+	ROBOT *robot;
+
+	ForeachLL_M(robotList, robot)
+		ReadLoggedOrders(loggedCommands, matchTick, robot->number,
+				&robot->orders, robot->view.statusMessage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ConfigurePuppet
+//
+// Description: This is the configuration function of every robot registered
+//              by ResimulateMatch().  It puts the robot where the logged one
+//              started, in its color, adds its sensors and gives its logged
+//              configuration orders.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ConfigurePuppet(void) {
+	COMMAND_LOG_ROBOT *logged;
+	int i;
+
+	logged = &GetLoggedHeader(loggedCommands)->robots[curRobot->number];
+	curRobot->color = logged->color;
+	curRobot->x = logged->x;
+	curRobot->y = logged->y;
+	curRobot->heading = logged->heading;
+	for (i = 0; i < MAX_SENSORS; i++)
+		if (logged->sensors[i].type != SENSOR_NONE)
+			AddSensor(i, logged->sensors[i].type, logged->sensors[i].angle,
+					logged->sensors[i].width, logged->sensors[i].range);
+	ReadLoggedOrders(loggedCommands, 0, curRobot->number, &curRobot->orders,
+			curRobot->view.statusMessage);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PuppetActions
+//
+// Description: The orders function of every robot registered by
+//              ResimulateMatch().  It is never called as their orders come
+//              from the log.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PuppetActions(int time) {
+}
@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: forkserver.c
+//
+// Description: This file implements the fork server described in
+//              forkserver.h.
+//
+//              Only the thread that calls fork() exists in the child, so the
+//              job system's workers are stopped before the first fork and
+//              each child starts its own.  When several children run at
+//              once they already keep the processors busy, so each one runs
+//              its physics on a single thread.  Children leave with _exit()
+//              so the server's Allegro and stdio state is never torn down or
+//              flushed twice.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Results give how each match ended.
+//                  18 Oct 2026 - Children can record their matches.
+//                  18 Oct 2026 - Children send each robot's order time
+//                                with the result.
+//                  18 Oct 2026 - betweenMatches is called before each fork.
+//                  18 Oct 2026 - A child's pipe is read to the end before it
+//                                is reaped.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "forkserver.h"
+#include "jobs.h"
+#include "threads.h"
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <poll.h>
+
+static char *endNames[] = { "running", "knockout", "time", "stalemate" };
+
+typedef struct {                 //A match being played.
+	pid_t pid;
+	int fromChild;               //Read end of the child's result pipe.
+	int job;
+	unsigned int seed;
+	int numRobots;
+} FORK_CHILD;
+
+typedef struct {                 //What a child sends back.
+	MATCH_RESULT result;
+	float wallMicros[MAX_ROBOTS];   //Average wall and CPU time of a turn.
+	float cpuMicros[MAX_ROBOTS];
+	int overBudget[MAX_ROBOTS];     //Turns over the order budget.
+} FORK_RESULT;
+
+//Internal helper prototypes
+static int ParseJob(char *line, unsigned int *seed, char **entrants);
+static void PlayMatch(int toServer, int job, unsigned int seed,
+		char **entrants, int numRobots, int workers, char *recordDir,
+		REGISTER_ENTRANT registerEntrant);
+static int ReapChild(FORK_CHILD *children, int running, FILE *results);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunForkServer
+//
+// Description: This function plays every match in a job file, each in its
+//              own child process, with up to maxChildren at once.  It must
+//              be called after InitCompetition() and before any robot is
+//              registered; the children register their own robots.
+//
+// Parameters: FILE *jobs - The job file, read to the end.
+//             FILE *results - Where the results are written.
+//             int maxChildren - Matches played at once.  0 or less for one
+//                               per processor.
+//             char *recordDir - Where to record the matches, or NULL.
+//             registerEntrant - Called in the child to register one robot,
+//                               given as in the job file, in the given slot.
+//             betweenMatches - Called in the server before each match is
+//                              forked, or NULL.
+//
+// Returns: int - The number of jobs read.
+//
+////////////////////////////////////////////////////////////////////////////////
+int RunForkServer(FILE *jobs, FILE *results, int maxChildren,
+		char *recordDir, REGISTER_ENTRANT registerEntrant,
+		BETWEEN_MATCHES betweenMatches) {
+	FORK_CHILD children[MAX_FORK_CHILDREN];
+	char line[FORK_JOB_LEN], *entrants[MAX_ROBOTS];
+	int running = 0, job = 0, numRobots, pipeFds[2], workers;
+	unsigned int seed;
+	pid_t pid;
+
+	if (maxChildren <= 0)
+		maxChildren = GetNumProcessors();
+	if (maxChildren > MAX_FORK_CHILDREN)
+		maxChildren = MAX_FORK_CHILDREN;
+	workers = maxChildren > 1 ? 0 : GetNumJobWorkers();
+	DeInitJobSystem();                    //Threads don't survive fork().
+
+	while (fgets(line, FORK_JOB_LEN, jobs) != NULL) {
+		if (line[0] == '#' || strspn(line, " \t\r\n") == strlen(line))
+			continue;
+
+		numRobots = ParseJob(line, &seed, entrants);
+		if (numRobots < 2) {
+			fprintf(results, "%d %u failed\n", job++, seed);
+			continue;
+		}
+
+		if (running == maxChildren)
+			running = ReapChild(children, running, results);
+		if (betweenMatches != NULL)
+			betweenMatches();
+
+		fflush(results);                  //Nothing buffered may be copied.
+		if (pipe(pipeFds) != 0)
+			AbortOnError("RunForkServer() could not create a pipe.\n"
+					"Program will end.");
+		pid = fork();
+		if (pid < 0)
+			AbortOnError("RunForkServer() could not fork a match.\n"
+					"Program will end.");
+		if (pid == 0) {
+			close(pipeFds[0]);
+			PlayMatch(pipeFds[1], job, seed, entrants, numRobots, workers,
+					recordDir, registerEntrant);
+		}
+
+		close(pipeFds[1]);
+		children[running].pid = pid;
+		children[running].fromChild = pipeFds[0];
+		children[running].job = job++;
+		children[running].seed = seed;
+		children[running].numRobots = numRobots;
+		running++;
+	}
+
+	while (running > 0)
+		running = ReapChild(children, running, results);
+	fflush(results);
+	return job;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ParseJob
+//
+// Description: This function splits a line of the job file into its seed
+//              and robots.  The robots point into the line.
+//
+// Parameters: char *line - The line, which is changed.
+//             unsigned int *seed - Set to the match's seed.
+//             char **entrants - Set to each robot, MAX_ROBOTS at most.
+//
+// Returns: int - The number of robots, or -1 if the line is bad.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ParseJob(char *line, unsigned int *seed, char **entrants) {
+	char *token, *end;
+	int count = 0;
+
+	*seed = 0;
+	token = strtok(line, " \t\r\n");
+	if (token == NULL)
+		return -1;
+	*seed = (unsigned int) strtoul(token, &end, 10);
+	if (*end != '\0')
+		return -1;
+
+	while ((token = strtok(NULL, " \t\r\n")) != NULL) {
+		if (count == MAX_ROBOTS)
+			return -1;
+		entrants[count++] = token;
+	}
+	return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PlayMatch
+//
+// Description: This function is the whole life of a child: register the
+//              robots, play the match and send back the result.  It never
+//              returns.  A match that can't be recorded isn't played.
+//
+// Parameters: int toServer - Write end of the result pipe.
+//             int job - The job number.
+//             unsigned int seed - Passed to ResetMatch().
+//             char **entrants - The robots, as given in the job file.
+//             int numRobots - How many.
+//             int workers - Job system workers to start.
+//             char *recordDir - Where to record the match, or NULL.
+//             registerEntrant - Registers each robot.
+//
+// Returns: Never.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PlayMatch(int toServer, int job, unsigned int seed,
+		char **entrants, int numRobots, int workers, char *recordDir,
+		REGISTER_ENTRANT registerEntrant) {
+	FORK_RESULT sent;
+	ROBOT_PROFILE profile;
+	char *data = (char *) &sent, fileName[FILENAME_MAX];
+	int i, length = sizeof(sent), written;
+
+	SetProfileReport(NULL);              //The results are the report, and
+	InitJobSystem(workers);              //stdout may be where they go.
+	for (i = 0; i < numRobots; i++)
+		registerEntrant(entrants[i], i);
+	ResetMatch(seed);
+	if (recordDir != NULL) {
+		snprintf(fileName, sizeof(fileName), "%s/%d.rwr", recordDir, job);
+		if (!RecordMatch(fileName))
+			_exit(EXIT_FAILURE);
+	}
+	RunMatch(&sent.result);
+	for (i = 0; i < MAX_ROBOTS; i++) {
+		GetRobotProfile(i, &profile);
+		sent.wallMicros[i] = GetMicrosPerTurn(&profile);
+		sent.cpuMicros[i] = profile.cpuTurns > 0
+				? profile.cpuTime / 1000.0 / profile.cpuTurns : -1.0f;
+		sent.overBudget[i] = profile.overBudget;
+	}
+
+	while (length > 0) {
+		written = write(toServer, data, length);
+		if (written < 0 && errno == EINTR)
+			continue;
+		if (written <= 0)
+			_exit(EXIT_FAILURE);
+		data += written;
+		length -= written;
+	}
+	_exit(EXIT_SUCCESS);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReapChild
+//
+// Description: This function waits for a child to finish and writes its
+//              results.  The child's pipe is read to the end before the
+//              child is reaped, so a child can never be left blocked writing
+//              while the server waits for it to exit.  A child that dies
+//              without sending its results is reported as failed.
+//
+// Parameters: FORK_CHILD *children - The matches being played.
+//             int running - How many.
+//             FILE *results - Where the results are written.
+//
+// Returns: int - How many are still being played.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ReapChild(FORK_CHILD *children, int running, FILE *results) {
+	struct pollfd pipes[MAX_FORK_CHILDREN];
+	FORK_RESULT sent;
+	MATCH_RESULT *result = &sent.result;
+	char *data = (char *) &sent, extra[256];
+	int i, robot, status, length = 0, got;
+
+	for (i = 0; i < running; i++) {      //Wait for a child to write or
+		pipes[i].fd = children[i].fromChild;          //close its pipe.
+		pipes[i].events = POLLIN;
+	}
+	while (poll(pipes, running, -1) < 0)
+		if (errno != EINTR)
+			AbortOnError("RunForkServer() lost track of its matches.\n"
+					"Program will end.");
+	for (i = 0; i < running && pipes[i].revents == 0; i++)
+		;
+
+	for (;;) {                           //Read to the end, keeping only
+		if (length < (int) sizeof(sent))             //what fits.
+			got = read(children[i].fromChild, data + length,
+					sizeof(sent) - length);
+		else
+			got = read(children[i].fromChild, extra, sizeof(extra));
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			break;
+		if (length < (int) sizeof(sent))
+			length += got;
+	}
+	close(children[i].fromChild);
+
+	while (waitpid(children[i].pid, &status, 0) < 0)
+		if (errno != EINTR)
+			AbortOnError("RunForkServer() lost track of its matches.\n"
+					"Program will end.");
+
+	if (length != sizeof(sent) || !WIFEXITED(status)
+			|| WEXITSTATUS(status) != EXIT_SUCCESS
+			|| result->numRobots != children[i].numRobots)
+		fprintf(results, "%d %u failed\n", children[i].job, children[i].seed);
+	else {
+		fprintf(results, "%d %u %d %s %d", children[i].job, children[i].seed,
+				result->calcs, endNames[result->end], result->winner);
+		for (robot = 0; robot < result->numRobots; robot++)
+			fprintf(results, " %d %.1f %.1f %.1f %d", result->alive[robot],
+					result->shields[robot], sent.wallMicros[robot],
+					sent.cpuMicros[robot], sent.overBudget[robot]);
+		fprintf(results, "\n");
+	}
+	fflush(results);
+
+	children[i] = children[--running];
+	return running;
+}
+
+#else
+
+int RunForkServer(FILE *jobs, FILE *results, int maxChildren,
+		char *recordDir, REGISTER_ENTRANT registerEntrant,
+		BETWEEN_MATCHES betweenMatches) {
+	AbortOnError("RunForkServer() needs fork(), which this platform doesn't "
+			"have.\nProgram will end.");
+	return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: forkserver.h
+//
+// Description: This file contains the fork server, which plays a batch of
+//              headless matches without paying for start up each time.  The
+//              server process initializes Allegro, loads the arena images
+//              and plugins once, then forks a child for each match.  The
+//              child shares all of that copy-on-write, registers the robots
+//              for its match, calls ResetMatch() with the match's seed and
+//              plays it with RunMatch().  Its MATCH_RESULT comes back through
+//              a pipe, so a robot that crashes only loses its own match.
+//
+//              Each line of the job file is one match:
+//
+//                  seed robot robot [robot robot]
+//
+//              where each robot is given just as on the command line (a
+//              robot number, or name@socket for a remote robot).  Blank
+//              lines and lines starting with # are skipped.  Each match
+//              gives one line of results, in the order they finish:
+//
+//                  job seed calcs end winner robot [robot ...]
+//
+//              where end is knockout, time or stalemate, the winner is -1
+//              if there isn't one (see GetMatchResult() for how ties are
+//              broken), and each robot, in the order they were given, is
+//
+//                  alive shields wallMicros cpuMicros overBudget
+//
+//              wallMicros and cpuMicros being the average wall and CPU time
+//              of its turns (CPU -1 if it wasn't measured) and overBudget
+//              how many went over the budget set by SetOrderBudget() (see
+//              robotprof.h).  With more children than processors the wall
+//              time includes waiting for one, and the CPU time doesn't.  The
+//              match limits are those set by SetMatchLimits() before the
+//              server started.  A match that can't be played gives
+//              "job seed failed".  Jobs are numbered from 0.
+//
+//              Before each match is forked the server calls betweenMatches,
+//              if given, so rockemsockem can pick up rebuilt plugins (see
+//              ReloadChangedPlugins() in plugins.h).
+//
+//              Given a directory, each child also records its match there
+//              (see recorder.h) as job.rwr, where job is the job number.
+//
+//              Only POSIX systems are supported; elsewhere RunForkServer()
+//              ends the program with an error.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Matches end by SetMatchLimits(), and results
+//                                say how they ended.
+//                  18 Oct 2026 - Matches can be recorded.
+//                  18 Oct 2026 - Results give each robot's order time.
+//                  18 Oct 2026 - betweenMatches is called before each fork.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef FORKSERVER_HEADER
+#define FORKSERVER_HEADER 1
+
+#include <stdio.h>
+#include "competition.h"
+
+#define MAX_FORK_CHILDREN   64
+#define FORK_JOB_LEN       512                   //Longest line in a job file.
+
+typedef void (*REGISTER_ENTRANT)(char *entrant, int slot);
+typedef void (*BETWEEN_MATCHES)(void);
+
+int RunForkServer(FILE *jobs, FILE *results, int maxChildren,
+		char *recordDir, REGISTER_ENTRANT registerEntrant,
+		BETWEEN_MATCHES betweenMatches);
+
+#endif
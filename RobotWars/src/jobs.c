@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: jobs.c
+//
+// Description: This file implements the work-stealing job system described in
+//              jobs.h.
+//
+//              Each deque is a growable ring buffer protected by its own lock.
+//              The owner pushes and pops at the bottom; thieves take from the
+//              top, so the oldest (usually largest) work is what gets stolen.
+//              A counting semaphore wakes sleeping workers when jobs arrive.
+//              Wake-ups can outnumber jobs (the waiting thread may have run
+//              them first); a worker that wakes to nothing just sleeps again.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - PopJob() and StealJob() replaced by
+//                                TakeJob(), which can look for the jobs of
+//                                one batch.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "jobs.h"
+#include "threads.h"
+
+void AbortOnError(char *message);
+
+#define JOB_DEQUE_START_SIZE  64
+
+typedef struct {
+	JOB_FUNC func;
+	void *data;
+	int begin;
+	int end;
+	JOB_BATCH *batch;
+} JOB;
+
+typedef struct {
+	MUTEX *lock;
+	JOB *jobs;                    //Ring buffer of jobs.
+	int capacity;
+	int top;                      //Index of the oldest job (steal end).
+	int count;                    //Jobs in the deque.
+	THREAD *thread;               //NULL for the caller's deque when there are
+} WORKER;                         //no worker threads.
+
+static WORKER *workers = NULL;
+static int numDeques = 0;         //Always at least 1.
+static int numWorkers = 0;        //Number of threads actually started.
+static volatile int nextDeque = 0;    //Round robin for jobs from non-workers.
+static volatile int shuttingDown = 0;
+static SEMAPHORE *workAvailable = NULL;
+static THREAD_LOCAL int workerIndex = -1;  //-1 on threads outside the pool.
+
+//Internal helper prototypes
+static void WorkerLoop(void *data);
+static int TakeJob(WORKER *worker, JOB_BATCH *batch, int fromTop, JOB *job);
+static int FindJob(int self, JOB_BATCH *batch, JOB *job);
+static void RunJob(JOB *job);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitJobSystem
+//
+// Description: This function starts the worker threads.  With 0 workers
+//              every job runs on the thread that waits for it.
+//
+// Parameters: int numWorkers - Number of worker threads to start.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitJobSystem(int requestedWorkers) {
+	int i;
+
+	if (requestedWorkers < 0)
+		requestedWorkers = 0;
+	numDeques = requestedWorkers > 0 ? requestedWorkers : 1;
+	workers = calloc(numDeques, sizeof(WORKER));
+	if (workers == NULL)
+		AbortOnError("InitJobSystem() could not allocate the workers.\n"
+				"Program will end.");
+
+	for (i = 0; i < numDeques; i++) {
+		workers[i].lock = NewMutex();
+		workers[i].capacity = JOB_DEQUE_START_SIZE;
+		workers[i].jobs = malloc(sizeof(JOB) * JOB_DEQUE_START_SIZE);
+		if (workers[i].jobs == NULL)
+			AbortOnError("InitJobSystem() could not allocate a job deque.\n"
+					"Program will end.");
+	}
+
+	shuttingDown = 0;
+	workAvailable = NewSemaphore(0);
+	numWorkers = requestedWorkers;
+	for (i = 0; i < numWorkers; i++)
+		workers[i].thread = StartThread(WorkerLoop, (void *) (size_t) i);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DeInitJobSystem
+//
+// Description: This function stops the worker threads and frees the deques.
+//              Any batch still pending must have been waited on first.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void DeInitJobSystem(void) {
+	int i;
+
+	if (workers == NULL)
+		return;
+
+	shuttingDown = 1;
+	MemoryBarrier_M();
+	for (i = 0; i < numWorkers; i++)
+		PostSemaphore(workAvailable);
+	for (i = 0; i < numWorkers; i++)
+		JoinThread(workers[i].thread);
+
+	for (i = 0; i < numDeques; i++) {
+		FreeMutex(workers[i].lock);
+		free(workers[i].jobs);
+	}
+	free(workers);
+	FreeSemaphore(workAvailable);
+	workers = NULL;
+	numDeques = numWorkers = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetNumJobWorkers
+//
+// Description: Reports how many worker threads the pool is running.
+//
+// Parameters: None.
+//
+// Returns: int - The number of workers.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetNumJobWorkers(void) {
+	return numWorkers;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitJobBatch / IsJobBatchDone
+//
+// Description: A batch tracks a group of jobs so the caller can wait for them.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitJobBatch(JOB_BATCH *batch) {
+	batch->pending = 0;
+}
+
+int IsJobBatchDone(JOB_BATCH *batch) {
+	MemoryBarrier_M();
+	return batch->pending == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddJob
+//
+// Description: This function queues a job.  A worker adding a job puts it on
+//              its own deque; any other thread spreads jobs round robin.
+//
+// Parameters: JOB_BATCH *batch - The batch the job belongs to.
+//             JOB_FUNC func - The function to run.
+//             void *data - Passed to func unchanged.
+//             int begin, end - The range of elements for this job.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AddJob(JOB_BATCH *batch, JOB_FUNC func, void *data, int begin, int end) {
+	WORKER *worker;
+	JOB *newJobs;
+	int target, i;
+
+	if (workerIndex >= 0)
+		target = workerIndex;
+	else
+		target = (unsigned) AtomicAdd(&nextDeque, 1) % numDeques;
+	worker = &workers[target];
+
+	AtomicAdd(&batch->pending, 1);
+
+	LockMutex(worker->lock);
+	if (worker->count == worker->capacity) {       //Full: grow and unwrap the
+		newJobs = malloc(sizeof(JOB) * worker->capacity * 2);     //ring buffer.
+		if (newJobs == NULL)
+			AbortOnError("AddJob() could not grow a job deque.\n"
+					"Program will end.");
+		for (i = 0; i < worker->count; i++)
+			newJobs[i] = worker->jobs[(worker->top + i) % worker->capacity];
+		free(worker->jobs);
+		worker->jobs = newJobs;
+		worker->capacity *= 2;
+		worker->top = 0;
+	}
+	i = (worker->top + worker->count) % worker->capacity;
+	worker->jobs[i].func = func;
+	worker->jobs[i].data = data;
+	worker->jobs[i].begin = begin;
+	worker->jobs[i].end = end;
+	worker->jobs[i].batch = batch;
+	worker->count++;
+	UnlockMutex(worker->lock);
+
+	if (numWorkers > 0)
+		PostSemaphore(workAvailable);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: WaitJobBatch
+//
+// Description: This function returns once every job in the batch has run.
+//              Rather than sleep, the waiting thread runs queued jobs from
+//              the batch itself.
+//
+// Parameters: JOB_BATCH *batch - The batch to wait on.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void WaitJobBatch(JOB_BATCH *batch) {
+	JOB job;
+
+	while (!IsJobBatchDone(batch)) {
+		if (FindJob(workerIndex, batch, &job))
+			RunJob(&job);
+		else
+			YieldThread();           //Remaining jobs are running elsewhere.
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ParallelFor
+//
+// Description: This function splits the range [0, count) into jobs of grain
+//              elements and waits for all of them.  Small ranges, or a pool
+//              without workers, run inline to avoid the queueing cost.
+//
+// Parameters: int count - Number of elements.
+//             int grain - Elements per job.
+//             JOB_FUNC func - Called with each [begin, end) range.
+//             void *data - Passed to func unchanged.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ParallelFor(int count, int grain, JOB_FUNC func, void *data) {
+	JOB_BATCH batch;
+	int begin;
+
+	if (count <= 0)
+		return;
+	if (grain < 1)
+		grain = 1;
+	if (numWorkers == 0 || count <= grain) {
+		func(data, 0, count);
+		return;
+	}
+
+	InitJobBatch(&batch);
+	for (begin = 0; begin < count; begin += grain)
+		AddJob(&batch, func, data, begin,
+				begin + grain < count ? begin + grain : count);
+	WaitJobBatch(&batch);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GatherElements / ReserveElements / FreeElements
+//
+// Description: Linked lists can't be split into ranges, so stages copy the
+//              element pointers of a list into an ELEMENT_ARRAY first.  The
+//              array keeps its capacity between ticks, so after the first few
+//              ticks no allocation is done.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GatherElements(t_LL list, ELEMENT_ARRAY *array) {
+	void *element;
+
+	array->count = 0;
+	ForeachLL_M(list, element)
+	{
+		if (array->count == array->capacity)
+			ReserveElements(array, array->capacity * 2 + 16);
+		array->items[array->count++] = element;
+	}
+}
+
+void ReserveElements(ELEMENT_ARRAY *array, int count) {
+	void **items;
+
+	if (count <= array->capacity)
+		return;
+	items = realloc(array->items, sizeof(void *) * count);
+	if (items == NULL)
+		AbortOnError("ReserveElements() could not grow an element array.\n"
+				"Program will end.");
+	array->items = items;
+	array->capacity = count;
+}
+
+void FreeElements(ELEMENT_ARRAY *array) {
+	free(array->items);
+	array->items = NULL;
+	array->count = array->capacity = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Internal helpers.  TakeJob() takes the newest job from a deque (owner end)
+// or the oldest (thief end).  Given a batch, it takes the first job of that
+// batch found from that end instead, which is almost always the end job.
+// FindJob() tries the thread's own deque first and then every other deque in
+// turn.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void WorkerLoop(void *data) {
+	JOB job;
+
+	workerIndex = (int) (size_t) data;
+	for (;;) {
+		WaitSemaphore(workAvailable);
+		MemoryBarrier_M();
+		if (shuttingDown)
+			return;
+		while (FindJob(workerIndex, NULL, &job))
+			RunJob(&job);
+	}
+}
+
+static int TakeJob(WORKER *worker, JOB_BATCH *batch, int fromTop, JOB *job) {
+	int n, i, found = 0;
+
+	LockMutex(worker->lock);
+	for (n = 0; n < worker->count && !found; n++) {
+		i = fromTop ? n : worker->count - 1 - n;     //Position from the top.
+		if (batch != NULL
+				&& worker->jobs[(worker->top + i) % worker->capacity].batch
+						!= batch)
+			continue;
+
+		*job = worker->jobs[(worker->top + i) % worker->capacity];
+		found = 1;
+		if (i == 0)                                     //Take from the top,
+			worker->top = (worker->top + 1) % worker->capacity;
+		else                           //or close the gap below the job taken.
+			for (; i < worker->count - 1; i++)
+				worker->jobs[(worker->top + i) % worker->capacity] =
+						worker->jobs[(worker->top + i + 1) % worker->capacity];
+		worker->count--;
+	}
+	UnlockMutex(worker->lock);
+	return found;
+}
+
+static int FindJob(int self, JOB_BATCH *batch, JOB *job) {
+	int i, start;
+
+	if (self >= 0 && TakeJob(&workers[self], batch, 0, job))
+		return 1;
+
+	start = self >= 0 ? self + 1 : 0;
+	for (i = 0; i < numDeques; i++)
+		if ((start + i) % numDeques != self
+				&& TakeJob(&workers[(start + i) % numDeques], batch, 1, job))
+			return 1;
+	return 0;
+}
+
+static void RunJob(JOB *job) {
+	job->func(job->data, job->begin, job->end);
+	AtomicSub(&job->batch->pending, 1);
+}
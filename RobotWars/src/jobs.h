@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: jobs.h
+//
+// Description: This is the header file for the job system.  A fixed pool of
+//              worker threads each own a deque of jobs.  Workers take work
+//              from the bottom of their own deque and, when it runs dry,
+//              steal from the top of the others.  The thread waiting on a
+//              batch helps out by stealing too, so a pool of 0 workers simply
+//              runs every job on the calling thread.
+//
+//              A job is a range [begin, end) of some caller-defined array.
+//              Jobs must only write to the elements in their own range; any
+//              shared effects (particles, sounds, damage to another robot)
+//              are recorded per element and applied serially afterwards, in
+//              list order, so results are identical to a serial run.
+//
+//              A thread waiting on a batch only helps with that batch's jobs,
+//              so long-running background jobs (eg: pipelined robot orders)
+//              never end up stalling a physics stage that waits on its own.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - WaitJobBatch() only runs jobs from the batch
+//                                being waited on.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef JOBS_HEADER
+#define JOBS_HEADER 1
+
+#include "ll.h"
+
+typedef void (*JOB_FUNC)(void *data, int begin, int end);
+
+typedef struct {
+	volatile int pending;            //Jobs added but not yet completed.
+} JOB_BATCH;
+
+typedef struct {                     //A reusable array of list elements so
+	void **items;                    //stages can hand out index ranges.
+	int count;
+	int capacity;
+} ELEMENT_ARRAY;
+
+void InitJobSystem(int numWorkers);
+void DeInitJobSystem(void);
+int GetNumJobWorkers(void);
+
+void InitJobBatch(JOB_BATCH *batch);
+void AddJob(JOB_BATCH *batch, JOB_FUNC func, void *data, int begin, int end);
+int IsJobBatchDone(JOB_BATCH *batch);
+void WaitJobBatch(JOB_BATCH *batch);
+void ParallelFor(int count, int grain, JOB_FUNC func, void *data);
+
+void GatherElements(t_LL list, ELEMENT_ARRAY *array);
+void ReserveElements(ELEMENT_ARRAY *array, int count);
+void FreeElements(ELEMENT_ARRAY *array);
+
+#endif
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: memstats.c
+//
+// Description: This file implements the memory accounts described in
+//              memstats.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <allegro.h>
+#include "memstats.h"
+
+static MEM_STATS accounts[NUM_MEM_ACCOUNTS];
+static long long totalAllocs = 0;      //In every account.
+static long long allocsAtTick = 0;     //totalAllocs at the last MarkAllocTick().
+static long long tickAllocs = 0;       //Made in the calculations marked.
+static long long peakTickAllocs = 0;
+static long long ticks = 0;
+static FILE *reportFile = NULL;        //See SetMemReport().
+static char *accountNames[NUM_MEM_ACCOUNTS] = { "Other list nodes",
+		"Robot nodes", "Weapon nodes", "Particle nodes", "Mail nodes",
+		"Shield bitmaps", "Radar bitmaps", "Weapon bitmaps",
+		"Scratch bitmaps" };
+
+//Internal helper prototypes
+static long long BitmapBytes(BITMAP *bitmap);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CountAlloc
+//
+// Description: This function counts an allocation.
+//
+// Parameters: MEM_ACCOUNT account - What it is for.
+//             long long bytes - Its size.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void CountAlloc(MEM_ACCOUNT account, long long bytes) {
+	MEM_STATS *stats = &accounts[account];
+
+	stats->allocs++;
+	stats->live++;
+	stats->bytes += bytes;
+	if (stats->live > stats->peakLive)
+		stats->peakLive = stats->live;
+	if (stats->bytes > stats->peakBytes)
+		stats->peakBytes = stats->bytes;
+	totalAllocs++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CountFree
+//
+// Description: This function counts an allocation being freed.
+//
+// Parameters: MEM_ACCOUNT account - The account it was counted in.
+//             long long bytes - Its size.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void CountFree(MEM_ACCOUNT account, long long bytes) {
+	accounts[account].frees++;
+	accounts[account].live--;
+	accounts[account].bytes -= bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CreateBitmap
+//
+// Description: This function makes a memory bitmap, as create_bitmap() does,
+//              and counts it.
+//
+// Parameters: MEM_ACCOUNT account - What it is for.
+//             int width, height - Its size in pixels.
+//
+// Returns: BITMAP* - The bitmap, or NULL if it couldn't be made.
+//
+////////////////////////////////////////////////////////////////////////////////
+BITMAP *CreateBitmap(MEM_ACCOUNT account, int width, int height) {
+	BITMAP *bitmap = create_bitmap(width, height);
+
+	if (bitmap != NULL)
+		CountAlloc(account, BitmapBytes(bitmap));
+	return bitmap;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DestroyBitmap
+//
+// Description: This function frees a bitmap made by CreateBitmap().
+//
+// Parameters: MEM_ACCOUNT account - What it was made for.
+//             BITMAP *bitmap - The bitmap, or NULL.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void DestroyBitmap(MEM_ACCOUNT account, BITMAP *bitmap) {
+	if (bitmap == NULL)
+		return;
+	CountFree(account, BitmapBytes(bitmap));
+	destroy_bitmap(bitmap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MarkAllocTick
+//
+// Description: This function ends a calculation for the allocation rate.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void MarkAllocTick(void) {
+	long long made = totalAllocs - allocsAtTick;
+
+	allocsAtTick = totalAllocs;
+	tickAllocs += made;
+	if (made > peakTickAllocs)
+		peakTickAllocs = made;
+	ticks++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetMemStats
+//
+// Description: This function gives the counts of an account.
+//
+// Parameters: MEM_ACCOUNT account - The account.
+//             MEM_STATS *stats - Filled with its counts.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GetMemStats(MEM_ACCOUNT account, MEM_STATS *stats) {
+	*stats = accounts[account];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetAllocRate
+//
+// Description: This function gives the allocations made a calculation, in
+//              every account.
+//
+// Parameters: double *average - Set to the average.
+//             long long *peak - Set to the most in one calculation.
+//
+// Returns: Nothing.  Both are 0 before the first calculation.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GetAllocRate(double *average, long long *peak) {
+	*average = ticks > 0 ? (double) tickAllocs / ticks : 0.0;
+	*peak = peakTickAllocs;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetMemAccountName
+//
+// Description: This function gives a short name for an account, for display.
+//
+// Parameters: MEM_ACCOUNT account - The account.
+//
+// Returns: char* - The name.
+//
+////////////////////////////////////////////////////////////////////////////////
+char *GetMemAccountName(MEM_ACCOUNT account) {
+	return accountNames[account];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetMemReport
+//
+// Description: This function sets where ReportMemStats() prints.
+//
+// Parameters: FILE *file - Where to print, or NULL not to.  NULL by default.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetMemReport(FILE *file) {
+	reportFile = file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReportMemStats
+//
+// Description: This function prints every account and the allocation rate,
+//              if SetMemReport() was given a file.  EndCompetition() calls it
+//              before freeing anything.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ReportMemStats(void) {
+	MEM_STATS *stats;
+	double average;
+	long long peak;
+	int i;
+
+	if (reportFile == NULL)
+		return;
+	fprintf(reportFile, "%-16s %10s %10s %8s %8s %10s %10s\n", "Memory",
+			"allocs", "frees", "live", "peak", "live KB", "peak KB");
+	for (i = 0; i < NUM_MEM_ACCOUNTS; i++) {
+		stats = &accounts[i];
+		fprintf(reportFile, "%-16s %10lld %10lld %8lld %8lld %10.1f %10.1f\n",
+				accountNames[i], stats->allocs, stats->frees, stats->live,
+				stats->peakLive, stats->bytes / 1024.0,
+				stats->peakBytes / 1024.0);
+	}
+	GetAllocRate(&average, &peak);
+	fprintf(reportFile, "Allocations a calculation: %.1f average, %lld most, "
+			"over %lld calculations.\n", average, peak, ticks);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: BitmapBytes
+//
+// Description: This function works out the memory a bitmap's pixels take.
+//
+// Parameters: BITMAP *bitmap - The bitmap.
+//
+// Returns: long long - The size in bytes.
+//
+////////////////////////////////////////////////////////////////////////////////
+static long long BitmapBytes(BITMAP *bitmap) {
+	return (long long) bitmap->w * bitmap->h
+			* ((bitmap_color_depth(bitmap) + 7) / 8);
+}
@@ -0,0 +1,70 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: memstats.h
+//
+// Description: This file contains the memory accounts, which count what the
+//              engine allocates and what for: the elements of each kind of
+//              list (robots, weapons, particles, messages) and each kind of
+//              bitmap (shields, radars, weapons, the graphics' own working
+//              images).  Each account keeps how many allocations are live
+//              and how many bytes, and the highest both have been, so the
+//              memory a match needs can be known before packing many of them
+//              onto one machine.  The allocations made in each calculation
+//              are counted too, as particle storms make thousands.
+//
+//              A list's elements are counted in the account given to the
+//              list with AccountLL() (see ll.h), or MA_LIST_OTHER.  Bitmaps
+//              are counted when made with CreateBitmap() and freed with
+//              DestroyBitmap(); bitmaps loaded from files are not counted.
+//
+//              Counting is always on, and costs an add or two an allocation.
+//              The counts are not locked: the engine only allocates on the
+//              main thread (jobs record particles and the like for it to
+//              make afterwards).
+//
+//              Note: this file does not need Allegro, so ll.c can include it.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef MEMSTATS_HEADER
+#define MEMSTATS_HEADER 1
+
+#include <stdio.h>
+
+typedef enum {                   //What memory is for.
+	MA_LIST_OTHER,               //Elements of lists without an account.
+	MA_ROBOT_NODES,
+	MA_WEAPON_NODES,
+	MA_PARTICLE_NODES,
+	MA_MAIL_NODES,               //Messages in robots' mailboxes.
+	MA_SHIELD_BITMAPS,           //Each robot's image.
+	MA_RADAR_BITMAPS,            //Radar sensor images.
+	MA_WEAPON_BITMAPS,
+	MA_SCRATCH_BITMAPS,          //The graphics' working images.
+	NUM_MEM_ACCOUNTS
+} MEM_ACCOUNT;
+
+typedef struct {
+	long long allocs;            //Made so far.
+	long long frees;
+	long long live;              //Allocations not yet freed.
+	long long peakLive;
+	long long bytes;             //Held by the live allocations.
+	long long peakBytes;
+} MEM_STATS;
+
+struct BITMAP;                   //Allegro's.
+
+void CountAlloc(MEM_ACCOUNT account, long long bytes);
+void CountFree(MEM_ACCOUNT account, long long bytes);
+struct BITMAP *CreateBitmap(MEM_ACCOUNT account, int width, int height);
+void DestroyBitmap(MEM_ACCOUNT account, struct BITMAP *bitmap);
+void MarkAllocTick(void);
+void GetMemStats(MEM_ACCOUNT account, MEM_STATS *stats);
+void GetAllocRate(double *average, long long *peak);
+char *GetMemAccountName(MEM_ACCOUNT account);
+void SetMemReport(FILE *file);
+void ReportMemStats(void);
+
+#endif
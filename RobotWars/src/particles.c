@@ -1,169 +1,326 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: particles.c
-//
-// Description: This file contains the implementation of the particle engine.
-//              The engine must be initialized with InitParticleSystem() to
-//              ensure particles fade away to the correct background color
-//              and to set up the linked list.
-//
-//              By better using the InitParticleSystem() function, this module
-//              could sever ties with the competition framework. For example,
-//              setting an amount of time to pass on each call.  Some constants
-//              such as DEG_PER_RAD would also need to be defined.
-//
-//              Note: Once initialized with InitParticleSystem(),
-//                    DestroyAllParticles() must be called to clean up the list.
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 4  April 2006 - Created
-//                   14 July 2006  - All functions adjusted to add support for
-//                                   the linked list library by George Matas.
-//                                   My older linked list code removed.
-//
-////////////////////////////////////////////////////////////////////////////////
-#include <math.h>
-#include "particles.h"
-#include "ll.h"
-
-//Global Variables.
-static t_LL particleList;                   //The list of particles.
-static int fadeR = 0, fadeG = 0, fadeB = 0;       //Background fade color.
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: InitParticleSystem
-//
-// Description: This function records the red, green, and blue values to which
-//              particles should be faded over their lifetime.
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void InitParticleSystem(int color) {
-	particleList = ConsLL();            //Initialize the list of particles.
-	fadeR = getr(color);
-	fadeG = getg(color);
-	fadeB = getb(color);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: AddParticle
-//
-// Description: This function adds a particle to the head of the particle list.
-//
-// Parameters:  int x, y - Location of the particle.
-//              int color - Initial color of the particle.
-//              float heading - Direction particle is travelling.
-//              float speed - Speed of the particle.
-//              float timeToLive - Time (in seconds) over which to fade the
-//                                 particle away and then remove it.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void AddParticle(int x, int y, int color, float heading, float speed,
-		float timeToLive) {
-	PARTICLE newParticle;                //Temporary particle to add to list.
-
-	newParticle.x = x;
-	newParticle.y = y;
-	newParticle.color = color;
-	newParticle.r = getr(color);
-	newParticle.g = getg(color);
-	newParticle.b = getb(color);
-	newParticle.heading = heading;
-	newParticle.speed = speed;
-	newParticle.timeToLive = timeToLive;
-	newParticle.originalTTL = timeToLive;
-
-	InsLastLL(particleList, newParticle);     //Put particle at end of the list.
-
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: UpdateParticles
-//
-// Description: This function moves the particles, fades them out, and
-//              deletes them if their time has expired.
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void UpdateParticles() {
-	PARTICLE *tempParticle, *nextParticle;   //Need two temporary particles when
-											 //elements may be deleted from the
-											 //list while iterating through it.
-	double dist, radians, fadePct, addPct;
-
-	SafeForeachLL_M(particleList, tempParticle, nextParticle)
-	//An iterator macro
-	{                                                       //See ll.c for info.
-		nextParticle = NextElmLL(tempParticle);     //Set up nextParticle.  This
-		if (tempParticle->timeToLive < 0)      //allows deletion of tempParticle
-			DelElmLL(tempParticle);                  //if required.
-		else {
-			radians = tempParticle->heading * DEG_PER_RAD;      //Move particle.
-			dist = tempParticle->speed / CALCS_PER_SEC;
-			tempParticle->x += dist * cos(radians);
-			tempParticle->y += dist * sin(radians);
-			fadePct = tempParticle->timeToLive / tempParticle->originalTTL; //Fade
-			addPct = 1 - fadePct;                                     //particle
-			tempParticle->color = makecol(                          //out to the
-					tempParticle->r * fadePct + fadeR * addPct,  //background
-					tempParticle->g * fadePct + fadeG * addPct,  //color.
-					tempParticle->b * fadePct + fadeB * addPct);
-
-			tempParticle->timeToLive -= 1.0 / CALCS_PER_SEC; //Update time to live.
-		}
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: DrawParticles
-//
-// Description: This function draws particles on the given bitmap.  The constant
-//              PX_PER_CM is required to calculate the pixel position vs. the
-//              cm position.
-//
-// Parameters: BITMAP *bmp - The bitmap to draw the particles on.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void DrawParticles(BITMAP *bmp) {
-	int drawX, drawY;
-	PARTICLE *tempParticle;                   //Particle use for list iteration.
-
-	ForeachLL_M(particleList, tempParticle)
-	//Iteration macro.
-	{
-		drawX = tempParticle->x * PX_PER_CM;
-		drawY = ARENA_HEIGHT_PX - tempParticle->y * PX_PER_CM;
-		putpixel(bmp, drawX, drawY, tempParticle->color);
-	}
-
-}
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// Function: DeleteAllParticles
-//
-// Description: This function deletes all particles from the linked list.
-//
-// Parameters: None.
-//
-// Returns: Nothing.
-//
-////////////////////////////////////////////////////////////////////////////////
-void DeleteAllParticles(void) {
-	DestLL(particleList);
-}
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: particles.c
+//
+// Description: This file contains the implementation of the particle engine.
+//              The engine must be initialized with InitParticleSystem() to
+//              ensure particles fade away to the correct background color
+//              and to set up the linked list.
+//
+//              By better using the InitParticleSystem() function, this module
+//              could sever ties with the competition framework. For example,
+//              setting an amount of time to pass on each call.  Some constants
+//              such as DEG_PER_RAD would also need to be defined.
+//
+//              Note: Once initialized with InitParticleSystem(),
+//                    DestroyAllParticles() must be called to clean up the list.
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 4  April 2006 - Created
+//                   14 July 2006  - All functions adjusted to add support for
+//                                   the linked list library by George Matas.
+//                                   My older linked list code removed.
+//                   18 Oct 2026   - UpdateParticles() moves and fades the
+//                                   particles on the job system.
+//                   18 Oct 2026   - New function ClearParticles().
+//                   18 Oct 2026   - New functions SaveParticles() and
+//                                   RestoreParticles() for match snapshots.
+//                   18 Oct 2026   - New function CountParticles().
+//                   18 Oct 2026   - New function CheckParticles().
+//                   18 Oct 2026   - Particles are counted in their own memory
+//                                   account (see memstats.h).
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <math.h>
+#include <limits.h>                 //For INT_MAX.
+#include "particles.h"
+#include "ll.h"
+#include "jobs.h"
+#include "memstats.h"
+
+#define PARTICLE_GRAIN  4096        //Particles per job in UpdateParticles().
+
+//Global Variables.
+static t_LL particleList;                   //The list of particles.
+static int fadeR = 0, fadeG = 0, fadeB = 0;       //Background fade color.
+static ELEMENT_ARRAY particleArray;         //Live particles for the jobs.
+
+//Internal helper prototypes
+static void UpdateParticleRange(void *data, int begin, int end);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitParticleSystem
+//
+// Description: This function records the red, green, and blue values to which
+//              particles should be faded over their lifetime.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitParticleSystem(int color) {
+	particleList = ConsLL();            //Initialize the list of particles.
+	AccountLL(particleList, MA_PARTICLE_NODES);
+	fadeR = getr(color);
+	fadeG = getg(color);
+	fadeB = getb(color);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddParticle
+//
+// Description: This function adds a particle to the head of the particle list.
+//
+// Parameters:  int x, y - Location of the particle.
+//              int color - Initial color of the particle.
+//              float heading - Direction particle is travelling.
+//              float speed - Speed of the particle.
+//              float timeToLive - Time (in seconds) over which to fade the
+//                                 particle away and then remove it.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AddParticle(int x, int y, int color, float heading, float speed,
+		float timeToLive) {
+	PARTICLE newParticle;                //Temporary particle to add to list.
+
+	newParticle.x = x;
+	newParticle.y = y;
+	newParticle.color = color;
+	newParticle.r = getr(color);
+	newParticle.g = getg(color);
+	newParticle.b = getb(color);
+	newParticle.heading = heading;
+	newParticle.speed = speed;
+	newParticle.timeToLive = timeToLive;
+	newParticle.originalTTL = timeToLive;
+
+	InsLastLL(particleList, newParticle);     //Put particle at end of the list.
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: UpdateParticles
+//
+// Description: This function moves the particles, fades them out, and
+//              deletes them if their time has expired.  Deleting has to be
+//              done on one thread, so expired particles are removed first
+//              and the survivors are then moved on the job system.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void UpdateParticles() {
+	PARTICLE *tempParticle, *nextParticle;   //Need two temporary particles when
+											 //elements may be deleted from the
+											 //list while iterating through it.
+
+	particleArray.count = 0;
+	SafeForeachLL_M(particleList, tempParticle, nextParticle)
+	//An iterator macro
+	{                                                       //See ll.c for info.
+		nextParticle = NextElmLL(tempParticle);     //Set up nextParticle.  This
+		if (tempParticle->timeToLive < 0)      //allows deletion of tempParticle
+			DelElmLL(tempParticle);                  //if required.
+		else {
+			if (particleArray.count == particleArray.capacity)
+				ReserveElements(&particleArray, particleArray.capacity * 2 + 256);
+			particleArray.items[particleArray.count++] = tempParticle;
+		}
+	}
+
+	ParallelFor(particleArray.count, PARTICLE_GRAIN, UpdateParticleRange,
+			NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: UpdateParticleRange
+//
+// Description: This is the job for UpdateParticles().  It moves and fades
+//              particles [begin, end) of particleArray.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void UpdateParticleRange(void *data, int begin, int end) {
+	PARTICLE *tempParticle;
+	double dist, radians, fadePct, addPct;
+	int i;
+
+	for (i = begin; i < end; i++) {
+		tempParticle = particleArray.items[i];
+		radians = tempParticle->heading * DEG_PER_RAD;      //Move particle.
+		dist = tempParticle->speed / CALCS_PER_SEC;
+		tempParticle->x += dist * cos(radians);
+		tempParticle->y += dist * sin(radians);
+		fadePct = tempParticle->timeToLive / tempParticle->originalTTL; //Fade
+		addPct = 1 - fadePct;                                     //particle
+		tempParticle->color = makecol(                          //out to the
+				tempParticle->r * fadePct + fadeR * addPct,  //background
+				tempParticle->g * fadePct + fadeG * addPct,  //color.
+				tempParticle->b * fadePct + fadeB * addPct);
+
+		tempParticle->timeToLive -= 1.0 / CALCS_PER_SEC; //Update time to live.
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DrawParticles
+//
+// Description: This function draws particles on the given bitmap.  The constant
+//              PX_PER_CM is required to calculate the pixel position vs. the
+//              cm position.
+//
+// Parameters: BITMAP *bmp - The bitmap to draw the particles on.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void DrawParticles(BITMAP *bmp) {
+	int drawX, drawY;
+	PARTICLE *tempParticle;                   //Particle use for list iteration.
+
+	ForeachLL_M(particleList, tempParticle)
+	//Iteration macro.
+	{
+		drawX = tempParticle->x * PX_PER_CM;
+		drawY = ARENA_HEIGHT_PX - tempParticle->y * PX_PER_CM;
+		putpixel(bmp, drawX, drawY, tempParticle->color);
+	}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DeleteAllParticles
+//
+// Description: This function deletes all particles from the linked list.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void DeleteAllParticles(void) {
+	DestLL(particleList);
+	FreeElements(&particleArray);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ClearParticles
+//
+// Description: This function deletes all particles but keeps the list (and
+//              the job array) for the next match.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ClearParticles(void) {
+	EmptyLL(particleList);
+	particleArray.count = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CountParticles
+//
+// Description: This function counts the particles, as of the last
+//              UpdateParticles() (without walking the list).
+//
+// Parameters: None.
+//
+// Returns: int - The number of live particles.
+//
+////////////////////////////////////////////////////////////////////////////////
+int CountParticles(void) {
+	return particleArray.count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SaveParticles
+//
+// Description: This function adds every particle to a match snapshot.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being written.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SaveParticles(SNAPSHOT *snapshot) {
+	PARTICLE *tempParticle;
+	int count = SizeLL(particleList);
+
+	WriteSnapshot(snapshot, &count, sizeof(count));
+	ForeachLL_M(particleList, tempParticle)
+		WriteSnapshot(snapshot, tempParticle, sizeof(PARTICLE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RestoreParticles
+//
+// Description: This function replaces the particles with those saved by
+//              SaveParticles().  Existing list elements are reused, so only
+//              particles beyond the current count are allocated.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//
+// Returns: int - 1 if successful, 0 if the snapshot is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+int RestoreParticles(SNAPSHOT *snapshot) {
+	PARTICLE *tempParticle, *nextParticle, *saved;
+	int count;
+
+	if (ReadSnapshot(snapshot, &count, sizeof(count)) == NULL || count < 0
+			|| count > INT_MAX / (int) sizeof(PARTICLE)
+			|| (saved = ReadSnapshot(snapshot, NULL, count * sizeof(PARTICLE)))
+					== NULL)
+		return 0;
+
+	SafeForeachLL_M(particleList, tempParticle, nextParticle)
+	{
+		nextParticle = NextElmLL(tempParticle);
+		if (count > 0) {
+			*tempParticle = *saved++;       //Overwrite the particles we have
+			count--;
+		} else
+			DelElmLL(tempParticle);        //and delete any left over,
+	}
+	for (; count > 0; count--, saved++)
+		InsLastLL(particleList, *saved);    //or add those still needed.
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckParticles
+//
+// Description: This function skips over the particles saved by
+//              SaveParticles() without changing any, so a snapshot can be
+//              checked before it is restored.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//
+// Returns: int - 1 if successful, 0 if the snapshot is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+int CheckParticles(SNAPSHOT *snapshot) {
+	int count;
+
+	return ReadSnapshot(snapshot, &count, sizeof(count)) != NULL && count >= 0
+			&& count <= INT_MAX / (int) sizeof(PARTICLE)
+			&& ReadSnapshot(snapshot, NULL, count * sizeof(PARTICLE)) != NULL;
+}
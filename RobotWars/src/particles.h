@@ -1,34 +1,44 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: particles.h
-//
-// Description: This is the header file for the particle engine.
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 2 April 2006 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-#include "competition.h"
-
-typedef struct PARTICLE_TAG {
-	float x;
-	float y;
-	int r;
-	int g;
-	int b;
-	int color;
-	float heading;
-	float speed;
-	float timeToLive;              //Holds remaining life of particle.
-	float originalTTL;            //Used to calculate color reduction over time.
-//  struct PARTICLE_TAG *next;
-} PARTICLE;
-
-void InitParticleSystem(int color);
-void AddParticle(int x, int y, int color, float heading, float speed,
-		float timeToLive);
-void UpdateParticles();
-void DrawParticles(BITMAP *bmp);
-void DeleteAllParticles(void);
-void UpdateParticles(void);
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: particles.h
+//
+// Description: This is the header file for the particle engine.
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 2 April 2006 - Created
+//                  18 Oct 2026  - Added ClearParticles().
+//                  18 Oct 2026  - Added SaveParticles() and RestoreParticles().
+//                  18 Oct 2026  - Added CountParticles().
+//                  18 Oct 2026  - Added CheckParticles().
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "competition.h"
+#include "snapshot.h"
+
+typedef struct PARTICLE_TAG {
+	float x;
+	float y;
+	int r;
+	int g;
+	int b;
+	int color;
+	float heading;
+	float speed;
+	float timeToLive;              //Holds remaining life of particle.
+	float originalTTL;            //Used to calculate color reduction over time.
+//  struct PARTICLE_TAG *next;
+} PARTICLE;
+
+void InitParticleSystem(int color);
+void AddParticle(int x, int y, int color, float heading, float speed,
+		float timeToLive);
+void UpdateParticles();
+void DrawParticles(BITMAP *bmp);
+void DeleteAllParticles(void);
+void ClearParticles(void);
+int CountParticles(void);
+void SaveParticles(SNAPSHOT *snapshot);
+int RestoreParticles(SNAPSHOT *snapshot);
+int CheckParticles(SNAPSHOT *snapshot);
+void UpdateParticles(void);
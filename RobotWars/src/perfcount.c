@@ -0,0 +1,366 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: perfcount.c
+//
+// Description: This file implements the hardware counters described in
+//              perfcount.h.  A group's leader counts cycles and the other
+//              events are its members, so the kernel schedules them onto
+//              the CPU's counters together and one read() gets them all.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#define _GNU_SOURCE 1                  //For syscall().
+#include <string.h>
+#include "perfcount.h"
+
+#ifdef __linux__
+#include <stdlib.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+typedef struct {
+	int tid;
+	int fds[NUM_PERF_COUNTERS];      //-1 for events the CPU hasn't.
+} COUNTER_GROUP;
+
+typedef struct {                     //What a group read() returns.
+	unsigned long long count;
+	unsigned long long values[NUM_PERF_COUNTERS];
+} GROUP_READING;
+
+static COUNTER_GROUP groups[MAX_COUNTED_THREADS];
+static int numGroups = 0;
+static int counting = 0;
+static int available[NUM_PERF_COUNTERS];   //Events found on the first thread.
+static unsigned long long eventConfigs[NUM_PERF_COUNTERS] = {
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+
+//Internal helper prototypes
+static int OpenGroup(COUNTER_GROUP *group, int tid);
+static void CloseGroup(COUNTER_GROUP *group);
+static int ReadGroup(COUNTER_GROUP *group, PERF_COUNTS *counts);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartPerfCounters
+//
+// Description: This function starts counting on every thread of the
+//              program.  Counters already started are started again from 0.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if counting, 0 if the counters aren't available (no
+//                cycle counter, or perf_event_paranoid is above 2).
+//
+////////////////////////////////////////////////////////////////////////////////
+int StartPerfCounters(void) {
+	DIR *tasks;
+	struct dirent *task;
+	int i;
+
+	StopPerfCounters();
+	for (i = 0; i < NUM_PERF_COUNTERS; i++)
+		available[i] = 1;
+	if (!OpenGroup(&groups[0], syscall(SYS_gettid)))
+		return 0;                    //The calling thread decides what's
+	numGroups = 1;                   //available.
+
+	tasks = opendir("/proc/self/task");
+	while (tasks != NULL && (task = readdir(tasks)) != NULL)
+		if (atoi(task->d_name) > 0 && atoi(task->d_name) != groups[0].tid
+				&& numGroups < MAX_COUNTED_THREADS
+				&& OpenGroup(&groups[numGroups], atoi(task->d_name)))
+			numGroups++;
+	if (tasks != NULL)
+		closedir(tasks);
+	counting = 1;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopPerfCounters
+//
+// Description: This function stops counting.  No other thread may be reading
+//              the counters.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StopPerfCounters(void) {
+	int i;
+
+	counting = 0;
+	for (i = 0; i < numGroups; i++)
+		CloseGroup(&groups[i]);
+	numGroups = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PerfCountersOn
+//
+// Description: This function tells whether the counters are counting, so
+//              callers can skip reading them when they aren't.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if counting, 0 if not.
+//
+////////////////////////////////////////////////////////////////////////////////
+int PerfCountersOn(void) {
+	return counting;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadThreadCounters
+//
+// Description: This function reads the counters of the calling thread.
+//
+// Parameters: PERF_COUNTS *counts - Filled with the counts since counting
+//                                   started.
+//
+// Returns: int - 1 if read, 0 if not counting or the thread isn't counted.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ReadThreadCounters(PERF_COUNTS *counts) {
+	int i, tid;
+
+	if (!counting)
+		return 0;
+	tid = syscall(SYS_gettid);
+	for (i = 0; i < numGroups; i++)
+		if (groups[i].tid == tid)
+			return ReadGroup(&groups[i], counts);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadAllCounters
+//
+// Description: This function reads the counters of every counted thread and
+//              adds them up, so work handed to the job workers is counted
+//              with the stage that handed it out.
+//
+// Parameters: PERF_COUNTS *counts - Filled with the counts since counting
+//                                   started.
+//
+// Returns: int - 1 if read, 0 if not counting.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ReadAllCounters(PERF_COUNTS *counts) {
+	PERF_COUNTS thread;
+	int i, j;
+
+	if (!counting)
+		return 0;
+	for (j = 0; j < NUM_PERF_COUNTERS; j++)
+		counts->counts[j] = available[j] ? 0 : -1;
+	for (i = 0; i < numGroups; i++)
+		if (ReadGroup(&groups[i], &thread))
+			for (j = 0; j < NUM_PERF_COUNTERS; j++)
+				if (available[j])
+					counts->counts[j] += thread.counts[j];
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Internal helpers.  OpenGroup() opens and enables a group counting one
+// thread, with the events in available[], and turns off any event it can't
+// open for the first group.  CloseGroup() closes one.  ReadGroup() reads one
+// into PERF_COUNTS.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int OpenGroup(COUNTER_GROUP *group, int tid) {
+	struct perf_event_attr attr;
+	int i, leader = -1;
+
+	group->tid = tid;
+	for (i = 0; i < NUM_PERF_COUNTERS; i++) {
+		group->fds[i] = -1;
+		if (!available[i])
+			continue;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.config = eventConfigs[i];
+		attr.read_format = PERF_FORMAT_GROUP;
+		attr.disabled = leader < 0;           //The group starts as one.
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		group->fds[i] = syscall(SYS_perf_event_open, &attr, tid, -1, leader,
+				0);
+		if (group->fds[i] < 0 && (i == PC_CYCLES || numGroups > 0)) {
+			CloseGroup(group);        //No leader, or a thread that can't
+			return 0;                 //count what the first one does.
+		}
+		if (group->fds[i] < 0)
+			available[i] = 0;
+		else if (leader < 0)
+			leader = group->fds[i];
+	}
+	ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	return 1;
+}
+
+static void CloseGroup(COUNTER_GROUP *group) {
+	int i;
+
+	for (i = NUM_PERF_COUNTERS - 1; i >= 0; i--)      //Members, then leader.
+		if (group->fds[i] >= 0) {
+			close(group->fds[i]);
+			group->fds[i] = -1;
+		}
+}
+
+static int ReadGroup(COUNTER_GROUP *group, PERF_COUNTS *counts) {
+	GROUP_READING reading;
+	int i, n = 0;
+
+	if (read(group->fds[PC_CYCLES], &reading, sizeof(reading)) <= 0)
+		return 0;
+	for (i = 0; i < NUM_PERF_COUNTERS; i++)     //Values are in the order the
+		if (available[i])                       //events were opened.
+			counts->counts[i] = reading.values[n++];
+		else
+			counts->counts[i] = -1;
+	return 1;
+}
+
+#else
+
+int StartPerfCounters(void) {
+	return 0;
+}
+
+void StopPerfCounters(void) {
+}
+
+int PerfCountersOn(void) {
+	return 0;
+}
+
+int ReadThreadCounters(PERF_COUNTS *counts) {
+	return 0;
+}
+
+int ReadAllCounters(PERF_COUNTS *counts) {
+	return 0;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddPerfCounts
+//
+// Description: This function adds what was counted between two readings to
+//              a total.
+//
+// Parameters: PERF_COUNTS *total - The total.
+//             PERF_COUNTS *before - The first reading.
+//             PERF_COUNTS *after - The second.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AddPerfCounts(PERF_COUNTS *total, PERF_COUNTS *before,
+		PERF_COUNTS *after) {
+	int i;
+
+	for (i = 0; i < NUM_PERF_COUNTERS; i++)
+		if (after->counts[i] < 0)
+			total->counts[i] = -1;
+		else
+			total->counts[i] += after->counts[i] - before->counts[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ClearPerfCounts
+//
+// Description: This function sets every count to 0.
+//
+// Parameters: PERF_COUNTS *counts - The counts.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ClearPerfCounts(PERF_COUNTS *counts) {
+	memset(counts, 0, sizeof(PERF_COUNTS));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintPerfHeader
+//
+// Description: This function prints a title and the column headings for
+//              PrintPerfCounts().
+//
+// Parameters: FILE *file - Where to print.
+//             const char *title - What the rows are.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PrintPerfHeader(FILE *file, const char *title) {
+	fprintf(file, "%-20s %8s %12s %12s %6s %11s %11s %6s\n", title, "calls",
+			"cycles/call", "instrs/call", "IPC", "cache/call", "branch/call",
+			"MPKI");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintPerfCounts
+//
+// Description: This function prints one row of counts: the averages per
+//              call, instructions per cycle and cache misses per thousand
+//              instructions.  Events the CPU hasn't are shown as "-".
+//
+// Parameters: FILE *file - Where to print.
+//             const char *name - What was counted (a stage, a robot).
+//             PERF_COUNTS *counts - The totals.
+//             int calls - How many times it ran.  Rows with none are skipped.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PrintPerfCounts(FILE *file, const char *name, PERF_COUNTS *counts,
+		int calls) {
+	long long *c = counts->counts;
+	char columns[NUM_PERF_COUNTERS][16];
+	int i;
+
+	if (calls <= 0)
+		return;
+	for (i = 0; i < NUM_PERF_COUNTERS; i++)
+		if (c[i] >= 0)
+			sprintf(columns[i], "%.0f", (double) c[i] / calls);
+		else
+			strcpy(columns[i], "-");
+
+	fprintf(file, "%-20.20s %8d %12s %12s ", name, calls, columns[PC_CYCLES],
+			columns[PC_INSTRUCTIONS]);
+	if (c[PC_INSTRUCTIONS] >= 0 && c[PC_CYCLES] > 0)
+		fprintf(file, "%6.2f ", (double) c[PC_INSTRUCTIONS] / c[PC_CYCLES]);
+	else
+		fprintf(file, "%6s ", "-");
+	fprintf(file, "%11s %11s ", columns[PC_CACHE_MISSES],
+			columns[PC_BRANCH_MISSES]);
+	if (c[PC_CACHE_MISSES] >= 0 && c[PC_INSTRUCTIONS] > 0)
+		fprintf(file, "%6.2f\n",
+				c[PC_CACHE_MISSES] * 1000.0 / c[PC_INSTRUCTIONS]);
+	else
+		fprintf(file, "%6s\n", "-");
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: perfcount.h
+//
+// Description: This file contains the hardware counters, which count the
+//              CPU cycles, instructions, cache misses and branch misses
+//              behind the stage timings (see profile.h) and each robot's
+//              orders.  Timings say a stage is slow; the counters say
+//              whether it is slow because it waits on memory (few
+//              instructions a cycle, many cache misses), as walking linked
+//              lists and reading pixels from bitmaps does, or because it
+//              simply does a lot.
+//
+//              The counters are Linux's perf_event_open() and are off unless
+//              StartPerfCounters() is called.  Only user-space events are
+//              counted, which the default perf_event_paranoid allows.  Each
+//              thread running when they are started gets its own group of
+//              counters, read together so the four numbers always agree;
+//              threads started later are not counted.  Elsewhere they are
+//              never available.
+//
+//              Note: like threads.c, perfcount.c must not include allegro.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PERFCOUNT_HEADER
+#define PERFCOUNT_HEADER 1
+
+#include <stdio.h>
+
+#define MAX_COUNTED_THREADS  64
+
+typedef enum {
+	PC_CYCLES,
+	PC_INSTRUCTIONS,
+	PC_CACHE_MISSES,             //Last level cache.
+	PC_BRANCH_MISSES,
+	NUM_PERF_COUNTERS
+} PERF_COUNTER;
+
+typedef struct {
+	long long counts[NUM_PERF_COUNTERS];     //-1 if the CPU hasn't the event.
+} PERF_COUNTS;
+
+int StartPerfCounters(void);
+void StopPerfCounters(void);
+int PerfCountersOn(void);
+int ReadThreadCounters(PERF_COUNTS *counts);
+int ReadAllCounters(PERF_COUNTS *counts);
+void AddPerfCounts(PERF_COUNTS *total, PERF_COUNTS *before,
+		PERF_COUNTS *after);
+void ClearPerfCounts(PERF_COUNTS *counts);
+void PrintPerfHeader(FILE *file, const char *title);
+void PrintPerfCounts(FILE *file, const char *name, PERF_COUNTS *counts,
+		int calls);
+
+#endif
@@ -1,22 +1,26 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: physics.h
-//
-// Description:
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 2 Apr 2006 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-#include "competition.h"
-
-void MoveRobots(t_LL listOfRobots);
-void CheckRobotCollisions(GAME *game, t_LL listOfRobots);
-void MoveWeapons(t_LL listOfWeapons);
-void CheckWeaponCollisions(GAME *game, t_LL listOfRobots, t_LL listOfWeapons);
-void UpdateSensorData(t_LL listOfRobots);
-void UpdateEnergySystems(t_LL listOfRobots);
-void CheckPixel(BITMAP *bmp, int x, int y, int data);
-int ImagesCollide(BITMAP *imgA, int xA, int yA, BITMAP *imgB, int xB, int yB);
-void ApplyDamage(GAME *game, t_LL listOfRobots, t_LL listOfDeadRobots);
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: physics.h
+//
+// Description:
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 2 Apr 2006 - Created
+//                  18 Oct 2026 - Added FreePhysicsScratch().
+//                  18 Oct 2026 - ApplyDamage() returns the damage applied.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "competition.h"
+
+void UpdateHeadingTrig(ROBOT *robot);
+void MoveRobots(t_LL listOfRobots);
+void CheckRobotCollisions(GAME *game, t_LL listOfRobots);
+void MoveWeapons(t_LL listOfWeapons);
+void CheckWeaponCollisions(GAME *game, t_LL listOfRobots, t_LL listOfWeapons);
+void UpdateSensorData(t_LL listOfRobots);
+void UpdateEnergySystems(t_LL listOfRobots);
+void CheckPixel(BITMAP *bmp, int x, int y, int data);
+int ImagesCollide(BITMAP *imgA, int xA, int yA, BITMAP *imgB, int xB, int yB);
+float ApplyDamage(GAME *game, t_LL listOfRobots, t_LL listOfDeadRobots);
+void FreePhysicsScratch(void);
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: plugins.c
+//
+// Description: This file loads robot plugins, as described in plugins.h.
+//              Windows uses LoadLibrary(), everything else dlopen().
+//
+//              A changed plugin is reloaded from a copy of its file with a
+//              name of its own, so the new library is a separate one while
+//              the old is still open, and a file being written can't be
+//              half-loaded.  If it doesn't load, the old library is kept.
+//
+//              Note: Windows keeps a loaded DLL's file locked, so to reload a
+//                    plugin there for the first time, rename the old DLL away
+//                    before copying the new one in.  Reloaded DLLs are
+//                    copies, so their plugin's file isn't locked.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - A reloaded plugin's configuration function
+//                                replaces the old one too, for ResetMatch().
+//                  18 Oct 2026 - Version 2 plugins' SaveState and LoadState
+//                                are given to their robots for snapshots.
+//                  18 Oct 2026 - Plugins are loaded in order of file name, so
+//                                their numbers don't depend on the directory.
+//                  18 Oct 2026 - Plugins are reloaded from a copy, a change of
+//                                size counts as well as the time, and a plugin
+//                                that fails to reload keeps its old library.
+//                  18 Oct 2026 - ReloadChangedPlugins() counts the plugins
+//                                that failed rather than reporting each one.
+//                  18 Oct 2026 - Plugins are loaded from a copy from the
+//                                start, so rebuilding one in place can't
+//                                crash the game.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "plugins.h"
+
+#ifdef _WIN32
+#include <winalleg.h>                 //Allegro's safe way to get windows.h.
+#define PLUGIN_EXT     ".dll"
+typedef HMODULE LIBRARY;
+#else
+#include <dirent.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#define PLUGIN_EXT     ".so"
+typedef void *LIBRARY;
+#endif
+
+#define PLUGIN_PATH_LEN  260
+
+typedef struct {
+	char path[PLUGIN_PATH_LEN];
+	time_t modified;                  //File time and size when it was loaded.
+	long long size;
+	char copy[PLUGIN_PATH_LEN];       //Copy of the file the library was
+	                                  //loaded from, to remove when it is
+	                                  //closed, or "".
+	LIBRARY library;
+	ROBOT_PLUGIN *plugin;
+} PLUGIN_ENTRY;
+
+typedef struct {                      //Files found by LoadPlugins().
+	char **names;
+	int count;
+	int room;
+} NAME_LIST;
+
+static PLUGIN_ENTRY plugins[MAX_PLUGINS];
+static int numPlugins = 0;
+
+//Internal helper prototypes
+static void AddName(NAME_LIST *list, char *name);
+static int CompareNames(const void *a, const void *b);
+static void TryPlugin(char *directory, char *fileName);
+static int CopyPlugin(PLUGIN_ENTRY *entry);
+static int OpenPlugin(PLUGIN_ENTRY *entry);
+static void ClosePlugin(PLUGIN_ENTRY *entry);
+static void SetStateFunctions(ROBOT_PLUGIN *plugin);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: LoadPlugins
+//
+// Description: This function loads every plugin in a directory, in order
+//              of file name (byte by byte, so the same on every system)
+//              rather than the order the directory lists them.  Files that
+//              aren't plugins are skipped.  A missing directory just means
+//              there are no plugins.
+//
+// Parameters: char *directory - The directory to search.
+//
+// Returns: int - The number of plugins now loaded.
+//
+////////////////////////////////////////////////////////////////////////////////
+int LoadPlugins(char *directory) {
+	NAME_LIST list = { NULL, 0, 0 };
+	int i;
+#ifdef _WIN32
+	WIN32_FIND_DATA found;
+	HANDLE search;
+	char pattern[PLUGIN_PATH_LEN];
+
+	snprintf(pattern, sizeof(pattern), "%s\\*%s", directory, PLUGIN_EXT);
+	search = FindFirstFile(pattern, &found);
+	if (search == INVALID_HANDLE_VALUE)
+		return numPlugins;
+	do
+		AddName(&list, found.cFileName);
+	while (FindNextFile(search, &found));
+	FindClose(search);
+#else
+	DIR *dir;
+	struct dirent *found;
+	size_t length;
+
+	dir = opendir(directory);
+	if (dir == NULL)
+		return numPlugins;
+	while ((found = readdir(dir)) != NULL) {
+		length = strlen(found->d_name);
+		if (length > strlen(PLUGIN_EXT) && !strcmp(found->d_name + length
+				- strlen(PLUGIN_EXT), PLUGIN_EXT))
+			AddName(&list, found->d_name);
+	}
+	closedir(dir);
+#endif
+
+	if (list.count > 0)
+		qsort(list.names, list.count, sizeof(char *), CompareNames);
+	for (i = 0; i < list.count; i++) {
+		TryPlugin(directory, list.names[i]);
+		free(list.names[i]);
+	}
+	free(list.names);
+	return numPlugins;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetNumPlugins
+//
+// Description: Reports how many plugins are loaded.
+//
+// Parameters: None.
+//
+// Returns: int - The number of plugins.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetNumPlugins(void) {
+	return numPlugins;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RegisterPluginRobot
+//
+// Description: This function registers the robot from a plugin, at a random
+//              location, just like the wrappers in rockemsockem.c.
+//
+// Parameters: int plugin - The plugin's number, from 0.
+//             ROBOTCOLORS color - The color of the robot in the game.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RegisterPluginRobot(int plugin, ROBOTCOLORS color) {
+	ROBOT_PLUGIN *robot;
+
+	if (plugin < 0 || plugin >= numPlugins)
+		AbortOnError("RegisterPluginRobot() was asked for a plugin that isn't "
+				"loaded.\nProgram will end.");
+
+	robot = plugins[plugin].plugin;
+	RegisterRobot(robot->name, color, robot->ActionsFunction,
+			robot->ConfigureFunction, robot->customImage, -1, -1, -1);
+	SetStateFunctions(robot);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReloadChangedPlugins
+//
+// Description: This function reloads every plugin whose file has changed
+//              (its time or its size), and points any robot using the old
+//              library at the new one.  A plugin that fails to reload keeps
+//              its old library; it is tried again once its file changes
+//              again.  Only call this between matches.
+//
+// Parameters: int *failed - Set to the number of plugins that failed to
+//                           reload, for the caller to report.
+//
+// Returns: int - The number of plugins reloaded.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ReloadChangedPlugins(int *failed) {
+	struct stat info;
+	PLUGIN_ENTRY fresh;
+	int i, reloaded = 0;
+
+	*failed = 0;
+
+	for (i = 0; i < numPlugins; i++) {
+		if (stat(plugins[i].path, &info) != 0
+				|| (info.st_mtime == plugins[i].modified
+						&& info.st_size == plugins[i].size))
+			continue;
+
+		fresh = plugins[i];
+		if (!CopyPlugin(&fresh) || !OpenPlugin(&fresh)) {
+			(*failed)++;
+			plugins[i].modified = info.st_mtime;      //Not again until it
+			plugins[i].size = info.st_size;           //changes again.
+			continue;
+		}
+		ReplaceRobotFunctions(plugins[i].plugin->ActionsFunction,
+				fresh.plugin->ActionsFunction, fresh.plugin->ConfigureFunction);
+		SetStateFunctions(fresh.plugin);
+		ClosePlugin(&plugins[i]);           //Nothing uses it now.
+		plugins[i] = fresh;
+		reloaded++;
+	}
+	return reloaded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: UnloadPlugins
+//
+// Description: This function unloads every plugin.  Called once the
+//              competition is over.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void UnloadPlugins(void) {
+	while (numPlugins > 0)
+		ClosePlugin(&plugins[--numPlugins]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Internal helpers.  AddName() keeps a copy of a file name LoadPlugins()
+// found, and CompareNames() sorts them for qsort().  TryPlugin() adds a file
+// to the table if it is a plugin, loading it from a copy so the file can be
+// rebuilt, even in place, while it is loaded.  CopyPlugin() copies an
+// entry's file to a new name to be loaded from.  OpenPlugin() loads the
+// library for an entry (from its copy if it has one) and checks it;
+// ClosePlugin() unloads it.  SetStateFunctions() gives a plugin's robots its
+// snapshot functions, which version 1 plugins don't have.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void AddName(NAME_LIST *list, char *name) {
+	char **grown;
+
+	if (list->count == list->room) {
+		list->room = list->room > 0 ? list->room * 2 : MAX_PLUGINS;
+		grown = realloc(list->names, list->room * sizeof(char *));
+		if (grown == NULL)
+			AbortOnError("LoadPlugins() could not allocate its file list.\n"
+					"Program will end.");
+		list->names = grown;
+	}
+	list->names[list->count] = malloc(strlen(name) + 1);
+	if (list->names[list->count] == NULL)
+		AbortOnError("LoadPlugins() could not allocate its file list.\n"
+				"Program will end.");
+	strcpy(list->names[list->count++], name);
+}
+
+static int CompareNames(const void *a, const void *b) {
+	return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+static void TryPlugin(char *directory, char *fileName) {
+	PLUGIN_ENTRY *entry;
+
+	if (numPlugins == MAX_PLUGINS)
+		return;
+	entry = &plugins[numPlugins];
+	if (snprintf(entry->path, PLUGIN_PATH_LEN, "%s/%s", directory, fileName)
+			>= PLUGIN_PATH_LEN)
+		return;
+	CopyPlugin(entry);                   //Else the file itself is loaded.
+	if (OpenPlugin(entry))
+		numPlugins++;
+}
+
+static int CopyPlugin(PLUGIN_ENTRY *entry) {
+	char buffer[4096];
+#ifdef _WIN32
+	char directory[PLUGIN_PATH_LEN];
+#else
+	int fd = -1;
+#endif
+	FILE *in, *out;
+	size_t length;
+	int ok;
+
+	in = fopen(entry->path, "rb");
+	if (in == NULL)
+		return 0;
+#ifdef _WIN32
+	if (GetTempPath(PLUGIN_PATH_LEN, directory) == 0
+			|| GetTempFileName(directory, "rwp", 0, entry->copy) == 0) {
+		fclose(in);
+		entry->copy[0] = '\0';
+		return 0;
+	}
+	out = fopen(entry->copy, "wb");
+#else
+	if (snprintf(entry->copy, PLUGIN_PATH_LEN, "%s.XXXXXX", entry->path)
+			< PLUGIN_PATH_LEN)
+		fd = mkstemp(entry->copy);
+	if (fd < 0) {
+		fclose(in);
+		entry->copy[0] = '\0';
+		return 0;
+	}
+	out = fdopen(fd, "wb");
+	if (out == NULL)
+		close(fd);
+#endif
+	ok = out != NULL;
+	while (ok && (length = fread(buffer, 1, sizeof(buffer), in)) > 0)
+		ok = fwrite(buffer, 1, length, out) == length;
+	ok = ok && !ferror(in);
+	fclose(in);
+	if (out != NULL && fclose(out) != 0)
+		ok = 0;
+	if (!ok) {
+		remove(entry->copy);
+		entry->copy[0] = '\0';
+	}
+	return ok;
+}
+
+static int OpenPlugin(PLUGIN_ENTRY *entry) {
+	char *file = entry->copy[0] != '\0' ? entry->copy : entry->path;
+	GET_ROBOT_PLUGIN getPlugin;
+	struct stat info;
+
+	entry->library = NULL;
+	if (stat(entry->path, &info) != 0) {
+		ClosePlugin(entry);
+		return 0;
+	}
+	entry->modified = info.st_mtime;
+	entry->size = info.st_size;
+
+#ifdef _WIN32
+	entry->library = LoadLibrary(file);
+	if (entry->library == NULL) {
+		ClosePlugin(entry);
+		return 0;
+	}
+	getPlugin = (GET_ROBOT_PLUGIN) GetProcAddress(entry->library,
+			ROBOT_PLUGIN_SYMBOL);
+#else
+	entry->library = dlopen(file, RTLD_NOW | RTLD_LOCAL);
+	if (entry->copy[0] != '\0') {        //The library keeps its pages, so
+		remove(entry->copy);             //the copy can go now.
+		entry->copy[0] = '\0';
+	}
+	if (entry->library == NULL)
+		return 0;
+	*(void **) &getPlugin = dlsym(entry->library, ROBOT_PLUGIN_SYMBOL);
+#endif
+
+	entry->plugin = getPlugin != NULL ? getPlugin() : NULL;
+	if (entry->plugin == NULL || entry->plugin->version < 1
+			|| entry->plugin->version > ROBOT_PLUGIN_VERSION
+			|| entry->plugin->name == NULL
+			|| entry->plugin->ActionsFunction == NULL
+			|| entry->plugin->ConfigureFunction == NULL) {
+		ClosePlugin(entry);
+		return 0;
+	}
+	return 1;
+}
+
+static void ClosePlugin(PLUGIN_ENTRY *entry) {
+#ifdef _WIN32
+	if (entry->library != NULL)
+		FreeLibrary(entry->library);
+#else
+	if (entry->library != NULL)
+		dlclose(entry->library);
+#endif
+	if (entry->copy[0] != '\0')
+		remove(entry->copy);
+	entry->copy[0] = '\0';
+	entry->library = NULL;
+	entry->plugin = NULL;
+}
+
+static void SetStateFunctions(ROBOT_PLUGIN *plugin) {
+	if (plugin->version >= 2)
+		SetRobotStateFunctions(plugin->ActionsFunction, plugin->SaveState,
+				plugin->LoadState);
+	else
+		SetRobotStateFunctions(plugin->ActionsFunction, NULL, NULL);
+}
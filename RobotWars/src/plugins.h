@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: plugins.h
+//
+// Description: This file contains the functions for robots built as shared
+//              libraries (.so/.dll) instead of being linked into the game.
+//              Every library in the plugin directory that exports the
+//              function named by ROBOT_PLUGIN_SYMBOL is loaded at startup.
+//              Plugins are numbered after the compiled-in robots, so they
+//              can be chosen on the command line the same way.
+//
+//              A plugin looks like this:
+//
+//                  #include "competition.h"
+//                  #include "plugins.h"
+//
+//                  static void MyActions(int time) { ... }
+//                  static void MySetup(void) { ... }
+//                  static ROBOT_PLUGIN plugin = { ROBOT_PLUGIN_VERSION,
+//                          "MyBot", MyActions, MySetup, NULL };
+//
+//                  ROBOT_PLUGIN *GetRobotPlugin(void) { return &plugin; }
+//
+//              The robot API (SetMotorSpeeds() etc.) is resolved against the
+//              game itself, which is why the game is linked with its symbols
+//              exported.
+//
+//              From version 2 a plugin may also give SaveState and
+//              LoadState functions so its statics are included in match
+//              snapshots (see SetRobotStateFunctions() in competition.c).
+//              Version 1 plugins, without those fields, still load.
+//
+//              ReloadChangedPlugins() reloads any library whose file has
+//              changed (its time or size) since it was loaded.  A library
+//              that fails to load is counted, for the caller to report, and
+//              the old one kept.  It must only be called between matches,
+//              before ResetMatch(), as robots' functions move when a library
+//              is reloaded.  The fork server does this before each match.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Version 2 adds SaveState and LoadState.
+//                  18 Oct 2026 - ReloadChangedPlugins() counts the plugins
+//                                that failed for its caller to report.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PLUGINS_HEADER
+#define PLUGINS_HEADER 1
+
+#include "competition.h"
+
+#define PLUGIN_DIR            "plugins"
+#define MAX_PLUGINS           32
+#define ROBOT_PLUGIN_SYMBOL   "GetRobotPlugin"
+#define ROBOT_PLUGIN_VERSION  2
+
+typedef struct {
+	int version;                   //ROBOT_PLUGIN_VERSION, or 1.
+	char *name;                    //Robot name, at most MAX_NAME_LEN long.
+	void (*ActionsFunction)(int);  //As passed to RegisterRobot().
+	void (*ConfigureFunction)(void);
+	char *customImage;             //Image file for the robot, or NULL.
+	int (*SaveState)(void *buffer, int size);  //Version 2 on.  Both NULL, or
+	int (*LoadState)(void *buffer, int size);  //see SetRobotStateFunctions().
+} ROBOT_PLUGIN;
+
+typedef ROBOT_PLUGIN *(*GET_ROBOT_PLUGIN)(void);
+
+int LoadPlugins(char *directory);
+int GetNumPlugins(void);
+void RegisterPluginRobot(int plugin, ROBOTCOLORS color);
+int ReloadChangedPlugins(int *failed);
+void UnloadPlugins(void);
+
+#endif
@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: profile.c
+//
+// Description: This file implements the stage timings described in
+//              profile.h.  Each stage and the frames have a ring of the
+//              last PROFILE_HISTORY times.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Stages and frames are traced (see trace.h).
+//                  18 Oct 2026 - Stages are counted with the hardware
+//                                counters when they're on (see perfcount.h).
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>                     //For NULL.
+#include "profile.h"
+#include "timing.h"
+#include "trace.h"
+#include "perfcount.h"
+
+typedef struct {
+	long long times[PROFILE_HISTORY];    //Nanoseconds, oldest at next once
+	int next;                            //the ring is full.
+	int count;
+} RING;
+
+static RING stageRings[NUM_TICK_STAGES];
+static RING frameRing;
+static int lastBacklog;
+static PERF_COUNTS stageCounts[NUM_TICK_STAGES];
+static int stageCalls[NUM_TICK_STAGES];
+static PERF_COUNTS lastCounts;              //At the last mark.
+static char *stageNames[NUM_TICK_STAGES] = { "Energy", "Move robots",
+		"Draw robots", "Robot hits", "Move weapons", "Weapon hits", "Damage",
+		"Draw sensors", "Sensor data", "Particles", "Orders", "Render" };
+
+//Internal helper prototypes
+static void AddTime(RING *ring, long long time);
+static void CountStage(TICK_STAGE stage);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartStage
+//
+// Description: This function records the start of a stage that doesn't
+//              follow straight on from another, so that the hardware counts
+//              in between aren't put down to it.
+//
+// Parameters: None.
+//
+// Returns: long long - The time now, for MarkStage().
+//
+////////////////////////////////////////////////////////////////////////////////
+long long StartStage(void) {
+	if (PerfCountersOn())
+		ReadAllCounters(&lastCounts);
+	return ReadTimer();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MarkStage
+//
+// Description: This function records the end of a stage, and traces it if
+//              tracing (see trace.h).
+//
+// Parameters: TICK_STAGE stage - The stage that just finished.
+//             long long since - When it started (from ReadTimer()), usually
+//                               what marking the stage before it returned.
+//
+// Returns: long long - The time now, for the start of the next stage.
+//
+////////////////////////////////////////////////////////////////////////////////
+long long MarkStage(TICK_STAGE stage, long long since) {
+	long long now = ReadTimer();
+
+	AddTime(&stageRings[stage], now - since);
+	if (PerfCountersOn())
+		CountStage(stage);
+	TraceSpan(stageNames[stage], since, now, NULL, 0);
+	return now;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MarkFrame
+//
+// Description: This function records the end of a frame, and traces it if
+//              tracing.
+//
+// Parameters: long long since - When the frame started (from ReadTimer()).
+//             int backlog - Calculations that were waiting to be caught up
+//                           when the frame started.
+//
+// Returns: long long - The time now, for the start of the next frame.
+//
+////////////////////////////////////////////////////////////////////////////////
+long long MarkFrame(long long since, int backlog) {
+	long long now = ReadTimer();
+
+	AddTime(&frameRing, now - since);
+	lastBacklog = backlog;
+	TraceSpan("Frame", since, now, "backlog", backlog);
+	return now;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetStageTimes
+//
+// Description: This function sums up the recent times of a stage.
+//
+// Parameters: TICK_STAGE stage - The stage.
+//             long long *average - Set to the average, in nanoseconds.
+//             long long *peak - Set to the longest.
+//
+// Returns: Nothing.  Both are 0 if the stage hasn't run yet.
+//
+////////////////////////////////////////////////////////////////////////////////
+void GetStageTimes(TICK_STAGE stage, long long *average, long long *peak) {
+	RING *ring = &stageRings[stage];
+	long long total = 0;
+	int i;
+
+	*peak = 0;
+	for (i = 0; i < ring->count; i++) {
+		total += ring->times[i];
+		if (ring->times[i] > *peak)
+			*peak = ring->times[i];
+	}
+	*average = ring->count > 0 ? total / ring->count : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetFrameTimes
+//
+// Description: This function gives the recent frame times, oldest first.
+//
+// Parameters: long long *times - Room for PROFILE_HISTORY times.
+//
+// Returns: int - How many there are.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetFrameTimes(long long *times) {
+	int i, first = frameRing.count < PROFILE_HISTORY ? 0 : frameRing.next;
+
+	for (i = 0; i < frameRing.count; i++)
+		times[i] = frameRing.times[(first + i) % PROFILE_HISTORY];
+	return frameRing.count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetBacklog
+//
+// Description: This function gives the calculations that were waiting to be
+//              caught up at the start of the last frame.
+//
+// Parameters: None.
+//
+// Returns: int - The backlog.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetBacklog(void) {
+	return lastBacklog;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetTickStageName
+//
+// Description: This function gives a short name for a stage, for display.
+//
+// Parameters: TICK_STAGE stage - The stage.
+//
+// Returns: char* - The name.
+//
+////////////////////////////////////////////////////////////////////////////////
+char *GetTickStageName(TICK_STAGE stage) {
+	return stageNames[stage];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintStageCounts
+//
+// Description: This function prints the hardware counts of each stage since
+//              they were last printed, then starts them again.
+//
+// Parameters: FILE *file - Where to print.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PrintStageCounts(FILE *file) {
+	int i;
+
+	PrintPerfHeader(file, "Stage");
+	for (i = 0; i < NUM_TICK_STAGES; i++) {
+		PrintPerfCounts(file, stageNames[i], &stageCounts[i], stageCalls[i]);
+		ClearPerfCounts(&stageCounts[i]);
+		stageCalls[i] = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddTime
+//
+// Description: This function puts a time in a ring, over the oldest once it
+//              is full.
+//
+// Parameters: RING *ring - The ring.
+//             long long time - The time.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void AddTime(RING *ring, long long time) {
+	ring->times[ring->next] = time;
+	ring->next = (ring->next + 1) % PROFILE_HISTORY;
+	if (ring->count < PROFILE_HISTORY)
+		ring->count++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CountStage
+//
+// Description: This function adds the hardware counts since the last mark,
+//              on every thread, to a stage.
+//
+// Parameters: TICK_STAGE stage - The stage that just finished.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void CountStage(TICK_STAGE stage) {
+	PERF_COUNTS now;
+
+	ReadAllCounters(&now);
+	AddPerfCounts(&stageCounts[stage], &lastCounts, &now);
+	stageCalls[stage]++;
+	lastCounts = now;
+}
@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: profile.h
+//
+// Description: This file contains the stage timings, a rolling record of how
+//              long each stage of the last PROFILE_HISTORY calculations took,
+//              and of the last PROFILE_HISTORY frames.  RunCalculation() and
+//              Fight() in competition.c mark the end of each stage as they
+//              go, and the timing overlay (see RenderScene()) shows the
+//              results, so a stutter can be put down to a stage at a glance.
+//
+//              Marking a stage only reads the clock and stores the time, so
+//              it is always done.  The timings are for the main thread and
+//              are not locked.
+//
+//              With the hardware counters on (see perfcount.h), each stage
+//              is counted too, on every thread, from the mark before it or
+//              StartStage().  PrintStageCounts() reports them.
+//
+//              Note: like threads.c, profile.c must not include allegro.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Added StartStage() and PrintStageCounts().
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef PROFILE_HEADER
+#define PROFILE_HEADER 1
+
+#include <stdio.h>
+
+#define PROFILE_HISTORY  128           //Samples kept for each stage.
+
+typedef enum {                   //The stages of a calculation, in the order
+	TS_ENERGY,                   //RunCalculation() runs them, then drawing.
+	TS_MOVE_ROBOTS,
+	TS_DRAW_ROBOTS,
+	TS_ROBOT_COLLISIONS,
+	TS_MOVE_WEAPONS,
+	TS_WEAPON_COLLISIONS,
+	TS_DAMAGE,
+	TS_DRAW_SENSORS,
+	TS_SENSOR_DATA,
+	TS_PARTICLES,
+	TS_ORDERS,                   //Only on order ticks.
+	TS_RENDER,
+	NUM_TICK_STAGES
+} TICK_STAGE;
+
+long long StartStage(void);
+long long MarkStage(TICK_STAGE stage, long long since);
+long long MarkFrame(long long since, int backlog);
+void GetStageTimes(TICK_STAGE stage, long long *average, long long *peak);
+int GetFrameTimes(long long *times);
+int GetBacklog(void);
+char *GetTickStageName(TICK_STAGE stage);
+void PrintStageCounts(FILE *file);
+
+#endif
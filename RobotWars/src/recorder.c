@@ -0,0 +1,701 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: recorder.c
+//
+// Description: This file implements the match recorder described in
+//              recorder.h.
+//
+//              Each calculation is encoded into a frame buffer, then copied
+//              into fixed size blocks.  Full blocks go to the writer thread
+//              through a single producer, single consumer ring; the writer
+//              hands them back through a second ring so they can be reused.
+//              Neither side ever takes a lock.  The simulation only waits if
+//              every slot of the ring is full, and only allocates when no
+//              written block has come back yet.  A semaphore posted once for
+//              each block, and once more to stop, wakes the writer.
+//
+//              The recorder keeps the state it last recorded, which is what
+//              each delta frame is coded against.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "recorder.h"
+#include "threads.h"
+
+#define RECORD_BLOCK_SIZE  65536
+#define RECORD_QUEUE_LEN   64             //Blocks waiting to be written.
+
+typedef struct {
+	int used;
+	unsigned char data[RECORD_BLOCK_SIZE];
+} RECORD_BLOCK;
+
+typedef struct {                 //Ring of blocks with one thread putting them
+	RECORD_BLOCK *slots[RECORD_QUEUE_LEN];  //in and another taking them out.
+	volatile int head;           //Next to take out; changed by the taker.
+	volatile int tail;           //Next to put in; changed by the putter.
+} BLOCK_QUEUE;
+
+typedef struct {                 //A weapon as of the last frame.
+	int id;
+	int x;                       //Scaled.
+	int y;
+	int dx;                      //Movement in the last frame.
+	int dy;
+} RECORD_WEAPON;
+
+struct RECORDER_TAG {
+	FILE *file;
+	THREAD *writer;
+	SEMAPHORE *blocksReady;
+	BLOCK_QUEUE full;            //Blocks for the writer,
+	BLOCK_QUEUE empty;           //and blocks it has written.
+	RECORD_BLOCK *block;         //Being filled.
+	volatile int failed;         //Set by the writer if a write fails.
+	unsigned int written;        //Bytes given to the writer so far.
+	int numRobots;
+	int lastTick;                //Tick of the last frame, -1 before the first.
+	int fields[MAX_ROBOTS][RF_NUM_FIELDS];           //As of the last frame.
+	char statusMessage[MAX_ROBOTS][STATUS_MSG_LEN];
+	RECORD_WEAPON *weapons;      //As of the last frame, in the order fired.
+	RECORD_WEAPON *newWeapons;   //This frame's, swapped with weapons after.
+	int numWeapons;
+	int weaponCapacity;
+	unsigned char *frame;        //The frame being encoded.
+	int frameCapacity;
+	RECORD_INDEX_ENTRY *index;   //Keyframes so far.
+	int numKeyframes;
+	int indexCapacity;
+};
+
+//Internal helper prototypes
+static void WriteBlocks(void *data);
+static int PutBlock(BLOCK_QUEUE *queue, RECORD_BLOCK *block);
+static RECORD_BLOCK *TakeBlock(BLOCK_QUEUE *queue);
+static RECORD_BLOCK *NewBlock(RECORDER *recorder);
+static void SendBlock(RECORDER *recorder);
+static void AppendBytes(RECORDER *recorder, const void *data, int length);
+static unsigned char *ReserveFrame(RECORDER *recorder, int length);
+static unsigned char *PutNumber(unsigned char *out, unsigned int value);
+static unsigned char *PutSigned(unsigned char *out, int value);
+static int Scale(double value);
+static void TakeFields(ROBOT *robot, int alive, int *fields);
+static void GetRobots(t_LL robots, t_LL deadRobots, ROBOT **byNumber,
+		int *alive);
+static unsigned char *EncodeRobot(RECORDER *recorder, unsigned char *out,
+		ROBOT *robot, int alive);
+static unsigned char *EncodeWeapons(RECORDER *recorder, unsigned char *out,
+		t_LL weapons, int keyframe);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartRecorder
+//
+// Description: This function creates a recording and starts its writer
+//              thread.  The header is taken from the robots as they are now,
+//              so it must be called once they are all registered and set up.
+//
+// Parameters: char *fileName - The file to record to.  It is replaced.
+//             t_LL robots - The robots still fighting.
+//             t_LL deadRobots - The destroyed robots.
+//
+// Returns: RECORDER* - The recorder, or NULL if the file can't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+RECORDER *StartRecorder(char *fileName, t_LL robots, t_LL deadRobots) {
+	RECORDER *recorder;
+	RECORD_HEADER header;
+	ROBOT *byNumber[MAX_ROBOTS];
+	int alive[MAX_ROBOTS], i, j;
+
+	recorder = calloc(1, sizeof(RECORDER));
+	if (recorder == NULL)
+		AbortOnError("StartRecorder() could not allocate a recorder.\n"
+				"Program will end.");
+	recorder->file = fopen(fileName, "wb");
+	if (recorder->file == NULL) {
+		free(recorder);
+		return NULL;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.magic = RECORD_MAGIC;
+	header.version = RECORD_VERSION;
+	header.numRobots = SizeLL(robots) + SizeLL(deadRobots);
+	header.keyframeCalcs = RECORD_KEYFRAME_CALCS;
+	GetRobots(robots, deadRobots, byNumber, alive);
+	for (i = 0; i < header.numRobots; i++) {
+		strncpy(header.names[i], byNumber[i]->name, MAX_NAME_LEN);
+		header.colors[i] = byNumber[i]->color;
+		for (j = 0; j < MAX_SENSORS; j++) {
+			header.sensors[i][j].type = byNumber[i]->sensorArray[j].type;
+			header.sensors[i][j].angle = byNumber[i]->sensorArray[j].angle;
+			header.sensors[i][j].width = byNumber[i]->sensorArray[j].width;
+			header.sensors[i][j].range = byNumber[i]->sensorArray[j].range;
+		}
+	}
+
+	recorder->numRobots = header.numRobots;
+	recorder->lastTick = -1;
+	recorder->blocksReady = NewSemaphore(0);
+	recorder->block = NewBlock(recorder);
+	AppendBytes(recorder, &header, sizeof(header));
+	recorder->writer = StartThread(WriteBlocks, recorder);
+	return recorder;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RecordCalculation
+//
+// Description: This function records the state of the match after a
+//              calculation.  It only encodes; the writing is done by the
+//              writer thread.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             int tick - The calculation just done.
+//             t_LL robots - The robots still fighting.
+//             t_LL deadRobots - The destroyed robots.
+//             t_LL weapons - The weapons in flight.
+//             int *playSound - The sounds the calculation played.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RecordCalculation(RECORDER *recorder, int tick, t_LL robots,
+		t_LL deadRobots, t_LL weapons, int *playSound) {
+	ROBOT *byNumber[MAX_ROBOTS];
+	int alive[MAX_ROBOTS], keyframe, sounds = 0, i;
+	unsigned char *out;
+
+	keyframe = recorder->lastTick < 0 || tick != recorder->lastTick + 1
+			|| tick % RECORD_KEYFRAME_CALCS == 0;
+	recorder->lastTick = tick;
+
+	out = ReserveFrame(recorder, 3 * 5 + recorder->numRobots
+			* ((RF_NUM_FIELDS + 2) * 5 + STATUS_MSG_LEN)
+			+ (SizeLL(weapons) + recorder->numWeapons + 2) * 6 * 5);
+
+	if (keyframe) {
+		if (recorder->numKeyframes == recorder->indexCapacity) {
+			recorder->indexCapacity = recorder->indexCapacity * 2 + 64;
+			recorder->index = realloc(recorder->index,
+					recorder->indexCapacity * sizeof(RECORD_INDEX_ENTRY));
+			if (recorder->index == NULL)
+				AbortOnError("RecordCalculation() could not grow the "
+						"keyframe index.\nProgram will end.");
+		}
+		recorder->index[recorder->numKeyframes].tick = tick;
+		recorder->index[recorder->numKeyframes++].offset = recorder->written;
+
+		memset(recorder->fields, 0, sizeof(recorder->fields));  //Changes are
+		memset(recorder->statusMessage, 0,                  //coded from zero.
+				sizeof(recorder->statusMessage));
+		*out++ = RECORD_KEYFRAME;
+		out = PutNumber(out, tick);
+	} else
+		*out++ = RECORD_DELTA;
+
+	for (i = 0; i < NUM_SOUNDS; i++)
+		if (playSound[i])
+			sounds |= 1 << i;
+	out = PutNumber(out, sounds);
+
+	GetRobots(robots, deadRobots, byNumber, alive);
+	for (i = 0; i < recorder->numRobots; i++)
+		out = EncodeRobot(recorder, out, byNumber[i], alive[i]);
+	out = EncodeWeapons(recorder, out, weapons, keyframe);
+
+	AppendBytes(recorder, recorder->frame, out - recorder->frame);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopRecorder
+//
+// Description: This function ends a recording: the end frame, if there is a
+//              result, then the index once the writer has written everything
+//              else.  The recorder is freed.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             MATCH_RESULT *result - How the match ended, or NULL to leave
+//                                    the end frame out.
+//
+// Returns: int - 1 if the whole recording was written, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int StopRecorder(RECORDER *recorder, MATCH_RESULT *result) {
+	RECORD_FOOTER footer;
+	RECORD_BLOCK *block;
+	unsigned char *out;
+	int success;
+
+	if (result != NULL) {
+		out = ReserveFrame(recorder, 4 * 5);
+		*out++ = RECORD_END;
+		out = PutNumber(out, result->end);
+		out = PutNumber(out, result->calcs);
+		out = PutSigned(out, result->winner);
+		AppendBytes(recorder, recorder->frame, out - recorder->frame);
+	}
+
+	if (recorder->block->used > 0)
+		SendBlock(recorder);
+	PostSemaphore(recorder->blocksReady);      //Nothing more: stop.
+	JoinThread(recorder->writer);
+
+	footer.magic = RECORD_MAGIC;
+	footer.numKeyframes = recorder->numKeyframes;
+	footer.indexOffset = recorder->written;
+	success = !recorder->failed
+			&& fwrite(recorder->index, sizeof(RECORD_INDEX_ENTRY),
+					recorder->numKeyframes, recorder->file)
+					== (size_t) recorder->numKeyframes
+			&& fwrite(&footer, sizeof(footer), 1, recorder->file) == 1;
+	success = fclose(recorder->file) == 0 && success;
+
+	free(recorder->block);
+	while ((block = TakeBlock(&recorder->empty)) != NULL)
+		free(block);
+	FreeSemaphore(recorder->blocksReady);
+	free(recorder->weapons);
+	free(recorder->newWeapons);
+	free(recorder->frame);
+	free(recorder->index);
+	free(recorder);
+	return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: WriteBlocks
+//
+// Description: This is the writer thread.  It writes each block sent to it
+//              and gives it back, until it is woken with none to write.
+//              After a failed write the rest are only given back.
+//
+// Parameters: void *data - The RECORDER.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void WriteBlocks(void *data) {
+	RECORDER *recorder = data;
+	RECORD_BLOCK *block;
+
+	for (;;) {
+		WaitSemaphore(recorder->blocksReady);
+		block = TakeBlock(&recorder->full);
+		if (block == NULL)
+			return;                    //The post to stop comes after the
+		                               //last block's, so all are written.
+		if (!recorder->failed && fwrite(block->data, 1, block->used,
+				recorder->file) != (size_t) block->used)
+			recorder->failed = 1;
+		block->used = 0;
+		if (!PutBlock(&recorder->empty, block))
+			free(block);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PutBlock / TakeBlock
+//
+// Description: These functions put a block into a ring and take the oldest
+//              one out.  Only one thread may put and only one may take.  The
+//              barriers make sure the slot is filled before the taker can
+//              see it, and emptied before the putter can reuse it.
+//
+// Returns: PutBlock: int - 1 if successful, 0 if the ring is full.
+//          TakeBlock: RECORD_BLOCK* - The block, or NULL if the ring is empty.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int PutBlock(BLOCK_QUEUE *queue, RECORD_BLOCK *block) {
+	int tail = queue->tail;
+
+	if (tail - queue->head == RECORD_QUEUE_LEN)
+		return 0;
+	queue->slots[tail % RECORD_QUEUE_LEN] = block;
+	MemoryBarrier_M();
+	queue->tail = tail + 1;
+	return 1;
+}
+
+static RECORD_BLOCK *TakeBlock(BLOCK_QUEUE *queue) {
+	RECORD_BLOCK *block;
+	int head = queue->head;
+
+	if (head == queue->tail)
+		return NULL;
+	MemoryBarrier_M();
+	block = queue->slots[head % RECORD_QUEUE_LEN];
+	MemoryBarrier_M();
+	queue->head = head + 1;
+	return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NewBlock
+//
+// Description: This function gets an empty block to fill, reusing one the
+//              writer has finished with if it can.
+//
+// Parameters: RECORDER *recorder - The recording.
+//
+// Returns: RECORD_BLOCK* - The block.
+//
+////////////////////////////////////////////////////////////////////////////////
+static RECORD_BLOCK *NewBlock(RECORDER *recorder) {
+	RECORD_BLOCK *block = TakeBlock(&recorder->empty);
+
+	if (block == NULL) {
+		block = malloc(sizeof(RECORD_BLOCK));
+		if (block == NULL)
+			AbortOnError("NewBlock() could not allocate a recording block.\n"
+					"Program will end.");
+		block->used = 0;
+	}
+	return block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SendBlock
+//
+// Description: This function gives the block being filled to the writer and
+//              starts another.  If the ring is full the disk has fallen far
+//              behind, and the simulation has to wait for it.
+//
+// Parameters: RECORDER *recorder - The recording.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SendBlock(RECORDER *recorder) {
+	while (!PutBlock(&recorder->full, recorder->block))
+		YieldThread();
+	PostSemaphore(recorder->blocksReady);
+	recorder->block = NewBlock(recorder);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AppendBytes
+//
+// Description: This function adds bytes to the recording, sending each block
+//              to the writer as it fills.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             const void *data - The bytes.
+//             int length - Number of bytes.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void AppendBytes(RECORDER *recorder, const void *data, int length) {
+	const unsigned char *bytes = data;
+	int space;
+
+	recorder->written += length;
+	while (length > 0) {
+		space = RECORD_BLOCK_SIZE - recorder->block->used;
+		if (space > length)
+			space = length;
+		memcpy(recorder->block->data + recorder->block->used, bytes, space);
+		recorder->block->used += space;
+		bytes += space;
+		length -= space;
+		if (recorder->block->used == RECORD_BLOCK_SIZE)
+			SendBlock(recorder);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReserveFrame
+//
+// Description: This function makes sure the frame buffer holds at least
+//              length bytes, so a frame can be encoded without checking as
+//              it goes.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             int length - The most the frame can need.
+//
+// Returns: unsigned char* - The start of the frame buffer.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned char *ReserveFrame(RECORDER *recorder, int length) {
+	if (length > recorder->frameCapacity) {
+		free(recorder->frame);
+		recorder->frameCapacity = length * 2;
+		recorder->frame = malloc(recorder->frameCapacity);
+		if (recorder->frame == NULL)
+			AbortOnError("ReserveFrame() could not grow the frame buffer.\n"
+					"Program will end.");
+	}
+	return recorder->frame;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PutNumber / PutSigned
+//
+// Description: These functions write a number as a varint, 5 bytes at most.
+//              Signed numbers are zigzag coded first so small changes either
+//              way stay short.
+//
+// Parameters: unsigned char *out - Where to write it.
+//             value - The number.
+//
+// Returns: unsigned char* - Just after it.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned char *PutNumber(unsigned char *out, unsigned int value) {
+	while (value >= 0x80) {
+		*out++ = (unsigned char) (value | 0x80);
+		value >>= 7;
+	}
+	*out++ = (unsigned char) value;
+	return out;
+}
+
+static unsigned char *PutSigned(unsigned char *out, int value) {
+	return PutNumber(out, value < 0 ? ~((unsigned int) value << 1)
+			: (unsigned int) value << 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Scale
+//
+// Description: This function converts a value to fixed point for recording.
+//
+// Parameters: double value - The value.
+//
+// Returns: int - The value times RECORD_SCALE, rounded.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int Scale(double value) {
+	return (int) floor(value * RECORD_SCALE + 0.5);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TakeFields
+//
+// Description: This function reads the recorded state of a robot.
+//
+// Parameters: ROBOT *robot - The robot.
+//             int alive - 1 if it is still fighting.
+//             int *fields - Filled with its RF_NUM_FIELDS fields.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void TakeFields(ROBOT *robot, int alive, int *fields) {
+	int i;
+
+	fields[RF_ALIVE] = alive;
+	fields[RF_X] = Scale(robot->x);
+	fields[RF_Y] = Scale(robot->y);
+	fields[RF_HEADING] = Scale(robot->heading);
+	fields[RF_SHIELDS] = Scale(robot->shields);
+	fields[RF_STRUCTURE] = robot->generatorStructure;
+	fields[RF_TURBO] = robot->turboTime;
+	fields[RF_LASER_CHARGE] = Scale(robot->weaponArray[LASER_PORT].chargeEnergy);
+	fields[RF_MISSILE_CHARGE] =
+			Scale(robot->weaponArray[MISSILE_PORT].chargeEnergy);
+	fields[RF_BUMPED] = robot->bumped;
+	fields[RF_SENSORS] = 0;
+	for (i = 0; i < MAX_SENSORS; i++) {
+		if (robot->sensorArray[i].on)
+			fields[RF_SENSORS] |= 1 << i;
+		if (robot->sensorArray[i].powered)
+			fields[RF_SENSORS] |= 1 << (MAX_SENSORS + i);
+		fields[RF_SENSOR_DATA + i] = robot->sensorArray[i].data;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetRobots
+//
+// Description: This function lists the robots by number, and whether each
+//              is still fighting.
+//
+// Parameters: t_LL robots - The robots still fighting.
+//             t_LL deadRobots - The destroyed robots.
+//             ROBOT **byNumber - Filled with the robots.
+//             int *alive - Filled with 1 for each robot still fighting.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void GetRobots(t_LL robots, t_LL deadRobots, ROBOT **byNumber,
+		int *alive) {
+	ROBOT *robot;
+
+	ForeachLL_M(robots, robot)
+	{
+		byNumber[robot->number] = robot;
+		alive[robot->number] = 1;
+	}
+	ForeachLL_M(deadRobots, robot)
+	{
+		byNumber[robot->number] = robot;
+		alive[robot->number] = 0;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: EncodeRobot
+//
+// Description: This function encodes what has changed about a robot since
+//              the last frame, and remembers its state for the next.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             unsigned char *out - Where to encode it.
+//             ROBOT *robot - The robot.
+//             int alive - 1 if it is still fighting.
+//
+// Returns: unsigned char* - Just after it.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned char *EncodeRobot(RECORDER *recorder, unsigned char *out,
+		ROBOT *robot, int alive) {
+	int fields[RF_NUM_FIELDS], *last = recorder->fields[robot->number];
+	char *lastMessage = recorder->statusMessage[robot->number];
+	int mask = 0, length, i;
+
+	TakeFields(robot, alive, fields);
+	for (i = 0; i < RF_NUM_FIELDS; i++)
+		if (fields[i] != last[i])
+			mask |= 1 << i;
+	if (strncmp(robot->statusMessage, lastMessage, STATUS_MSG_LEN) != 0)
+		mask |= 1 << RF_NUM_FIELDS;
+
+	out = PutNumber(out, mask);
+	for (i = 0; i < RF_NUM_FIELDS; i++)
+		if (mask & (1 << i)) {
+			out = PutSigned(out, fields[i] - last[i]);
+			last[i] = fields[i];
+		}
+	if (mask & (1 << RF_NUM_FIELDS)) {
+		for (length = 0; length < STATUS_MSG_LEN - 1
+				&& robot->statusMessage[length] != '\0'; length++)
+			;
+		out = PutNumber(out, length);
+		memcpy(out, robot->statusMessage, length);
+		out += length;
+		memset(lastMessage, 0, STATUS_MSG_LEN);
+		memcpy(lastMessage, robot->statusMessage, length);
+	}
+	return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: EncodeWeapons
+//
+// Description: This function encodes the weapons destroyed and fired since
+//              the last frame, and how the others moved.  Weapons are fired
+//              onto the end of the list and keep their order, so the
+//              weapons still flying are matched to the last frame's by
+//              walking the two lists together.  If the list is out of id
+//              order (a match restored from a snapshot) nothing is matched:
+//              the last frame's weapons are all destroyed and these fired.
+//
+// Parameters: RECORDER *recorder - The recording.
+//             unsigned char *out - Where to encode them.
+//             t_LL weapons - The weapons in flight.
+//             int keyframe - 1 to code every weapon as fired.
+//
+// Returns: unsigned char* - Just after them.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned char *EncodeWeapons(RECORDER *recorder, unsigned char *out,
+		t_LL weapons, int keyframe) {
+	RECORD_WEAPON *last = recorder->weapons, *now, *swap;
+	WEAPON *weapon;
+	int count = SizeLL(weapons), numNow = 0, lastId = 0, i, j, fired;
+	int match = 1;
+
+	if (count > recorder->weaponCapacity) {
+		recorder->weaponCapacity = count * 2;
+		free(recorder->newWeapons);
+		recorder->newWeapons = malloc(recorder->weaponCapacity
+				* sizeof(RECORD_WEAPON));
+		recorder->weapons = realloc(recorder->weapons,
+				recorder->weaponCapacity * sizeof(RECORD_WEAPON));
+		if (recorder->newWeapons == NULL || recorder->weapons == NULL)
+			AbortOnError("EncodeWeapons() could not grow the weapon list.\n"
+					"Program will end.");
+		last = recorder->weapons;
+	}
+	now = recorder->newWeapons;
+
+	ForeachLL_M(weapons, weapon)
+	{
+		if (numNow > 0 && weapon->id <= now[numNow - 1].id)
+			match = 0;
+		now[numNow].id = weapon->id;
+		now[numNow].x = Scale(weapon->x);
+		now[numNow].y = Scale(weapon->y);
+		numNow++;
+	}
+	if (keyframe)
+		recorder->numWeapons = 0;       //Nothing to match: all are fired.
+
+	//Destroyed: in the last frame but not matched in this one.
+	for (i = j = 0; i < recorder->numWeapons; i++)
+		if (match && j < numNow && now[j].id == last[i].id)
+			j++;
+	out = PutNumber(out, recorder->numWeapons - j);
+	for (i = j = 0; i < recorder->numWeapons; i++)
+		if (match && j < numNow && now[j].id == last[i].id)
+			j++;
+		else {
+			out = PutSigned(out, last[i].id - lastId);
+			lastId = last[i].id;
+		}
+
+	fired = numNow - j;                //Fired: everything after them.
+	out = PutNumber(out, fired);
+	i = 0;
+	ForeachLL_M(weapons, weapon)
+	{
+		if (i++ < j)
+			continue;
+		out = PutSigned(out, weapon->id - lastId);
+		lastId = weapon->id;
+		out = PutNumber(out, weapon->type);
+		out = PutNumber(out, weapon->owner->number);
+		out = PutSigned(out, now[i - 1].x);
+		out = PutSigned(out, now[i - 1].y);
+		out = PutSigned(out, Scale(weapon->heading));
+		now[i - 1].dx = now[i - 1].dy = 0;
+	}
+
+	for (i = j = 0; i < recorder->numWeapons; i++) //Still flying.
+		if (match && j < numNow && now[j].id == last[i].id) {
+			now[j].dx = now[j].x - last[i].x;
+			now[j].dy = now[j].y - last[i].y;
+			out = PutSigned(out, now[j].dx - last[i].dx);
+			out = PutSigned(out, now[j].dy - last[i].dy);
+			j++;
+		}
+
+	swap = recorder->weapons;
+	recorder->weapons = now;
+	recorder->newWeapons = swap;
+	recorder->numWeapons = numNow;
+	return out;
+}
@@ -0,0 +1,125 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: recorder.h
+//
+// Description: This file contains the match recorder, which writes a compact
+//              binary record of every calculation of a match so it can be
+//              studied or replayed later.  RecordMatch() in competition.c
+//              starts one; the match feeds it each calculation and stops it
+//              with the result when the match ends.
+//
+//              The simulation only encodes each calculation into memory
+//              blocks.  A writer thread takes full blocks from a lock-free
+//              queue and writes them out, so a calculation never waits on
+//              the disk unless the disk falls a whole queue behind.
+//
+//              A recording is, in host byte order:
+//
+//                  RECORD_HEADER
+//                  frames...
+//                  RECORD_INDEX_ENTRY for each keyframe
+//                  RECORD_FOOTER
+//
+//              Each frame starts with its type.  A RECORD_KEYFRAME gives its
+//              tick and the whole state; the RECORD_DELTA frames after it
+//              are for the following ticks, one each, and give only what
+//              changed.  A keyframe is written every RECORD_KEYFRAME_CALCS
+//              and whenever the ticks don't follow on (after RestoreMatch()).
+//              A RECORD_END frame says how the match ended.  The index and
+//              footer are written last, so a recording cut short by a crash
+//              still has every frame up to the crash but no index.
+//
+//              Numbers in frames are varints: 7 bits a byte, low bits first,
+//              the top bit set on every byte but the last.  Signed numbers
+//              are zigzag coded first (0, -1, 1, -2 ... become 0, 1, 2, 3).
+//              Positions, angles and energies are fixed point, scaled by
+//              RECORD_SCALE.  A frame holds:
+//
+//                  type, tick (keyframes only), sounds played (a bit each)
+//                  for each robot, by number:
+//                      mask of the RECORD_FIELDS that changed, plus bit
+//                      RF_NUM_FIELDS if the status message did
+//                      the change in each of those fields (signed)
+//                      the status message length and text, if it changed
+//                  weapons destroyed, then the id of each
+//                  weapons fired, then the id, type, owner, x, y and heading
+//                      (signed) of each
+//                  for each other weapon, in the order they were fired, the
+//                      change in its x and y movement since the last frame
+//                      (signed)
+//                  (RECORD_END frames instead give the MATCH_END, the
+//                      calculations and the winner, signed)
+//
+//              Weapon ids are signed, from the id before them in the frame
+//              (or 0).  In a keyframe the changes are from zero and every
+//              weapon is given as fired.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef RECORDER_HEADER
+#define RECORDER_HEADER 1
+
+#include "competition.h"
+
+#define RECORD_MAGIC           0x43525752   //"RWRC"
+#define RECORD_VERSION         1
+#define RECORD_KEYFRAME_CALCS  (CALCS_PER_SEC * 2)
+#define RECORD_SCALE           16           //Fixed point scale.
+
+#define RECORD_KEYFRAME        1            //Frame types.
+#define RECORD_DELTA           2
+#define RECORD_END             3
+
+typedef enum {                   //The state recorded for each robot.
+	RF_ALIVE,
+	RF_X,                        //Scaled.
+	RF_Y,                        //Scaled.
+	RF_HEADING,                  //Scaled.
+	RF_SHIELDS,                  //Scaled.
+	RF_STRUCTURE,
+	RF_TURBO,
+	RF_LASER_CHARGE,             //Scaled.
+	RF_MISSILE_CHARGE,           //Scaled.
+	RF_BUMPED,
+	RF_SENSORS,                  //Bit i: sensor i on, MAX_SENSORS + i: powered.
+	RF_SENSOR_DATA,              //One for each sensor.
+	RF_NUM_FIELDS = RF_SENSOR_DATA + MAX_SENSORS
+} RECORD_FIELDS;
+
+typedef struct {
+	SENSORTYPE type;
+	int angle;
+	int width;
+	int range;
+} RECORD_SENSOR;
+
+typedef struct {
+	int magic;
+	int version;
+	int numRobots;
+	int keyframeCalcs;
+	char names[MAX_ROBOTS][MAX_NAME_LEN + 1];       //By robot number.
+	int colors[MAX_ROBOTS];
+	RECORD_SENSOR sensors[MAX_ROBOTS][MAX_SENSORS];
+} RECORD_HEADER;
+
+typedef struct {
+	int tick;
+	unsigned int offset;         //From the start of the file.
+} RECORD_INDEX_ENTRY;
+
+typedef struct {
+	int magic;
+	int numKeyframes;
+	unsigned int indexOffset;
+} RECORD_FOOTER;
+
+typedef struct RECORDER_TAG RECORDER;
+
+RECORDER *StartRecorder(char *fileName, t_LL robots, t_LL deadRobots);
+void RecordCalculation(RECORDER *recorder, int tick, t_LL robots,
+		t_LL deadRobots, t_LL weapons, int *playSound);
+int StopRecorder(RECORDER *recorder, MATCH_RESULT *result);
+
+#endif
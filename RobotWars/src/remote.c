@@ -0,0 +1,501 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: remote.c
+//
+// Description: This file implements the remote robot connections described in
+//              remote.h.  Outgoing messages are collected in a buffer and sent
+//              with one write per order tick.  Incoming orders for robots or
+//              ticks other than the one being waited for are kept in a small
+//              inbox until they are asked for.
+//
+//              A connection that fails (brain exits, bad message, or no
+//              reply within REMOTE_TIMEOUT_MS) is marked failed.  Its robots
+//              then give no further orders, but the match carries on.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - New function NextRemoteMatch().  Messages
+//                                left over from an earlier match are skipped.
+//                  18 Oct 2026 - New functions SetRemoteLatency() and
+//                                GetRemoteLatency().  The inbox has room for
+//                                REMOTE_MAX_LATENCY.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "remote.h"
+
+static int latency = 1;               //Order ticks.  See SetRemoteLatency().
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetRemoteLatency
+//
+// Description: This function sets how many order ticks after an observation
+//              the orders answering it are applied.  0 waits for the brain
+//              at every order tick.  Set it before a match starts, as the
+//              orders already waited for stay where they are.
+//
+// Parameters: int ticks - The latency, from 0 to REMOTE_MAX_LATENCY.  1 by
+//                         default.  Anything else is clamped to that range.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetRemoteLatency(int ticks) {
+	if (ticks < 0)
+		ticks = 0;
+	else if (ticks > REMOTE_MAX_LATENCY)
+		ticks = REMOTE_MAX_LATENCY;
+	latency = ticks;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetRemoteLatency
+//
+// Description: This function gives the latency set by SetRemoteLatency().
+//
+// Parameters: None.
+//
+// Returns: int - The latency in order ticks.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetRemoteLatency(void) {
+	return latency;
+}
+
+#ifndef _WIN32
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define REMOTE_TIMEOUT_MS    5000     //Longest wait for a brain's reply.
+#define REMOTE_INBOX_SIZE    (MAX_ROBOTS * (REMOTE_MAX_LATENCY + 2))
+
+typedef struct {                      //Orders that arrived before they were
+	int used;                         //needed.
+	int robot;
+	int tick;
+	int count;
+	REMOTE_COMMAND commands[MAX_COMMANDS];
+} REMOTE_ORDERS;
+
+struct REMOTE_TAG {
+	char path[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+	int fd;
+	int users;                        //Robots sharing the connection.
+	int failed;
+	char *outBuffer;                  //Messages waiting to be sent.
+	int outCount;
+	int outCapacity;
+	REMOTE_ORDERS inbox[REMOTE_INBOX_SIZE];
+};
+
+static REMOTE *remotes[MAX_ROBOTS];   //Open connections.
+static int matchNumber = 0;           //Sent in every header.
+static REMOTE_COMMAND readBuffer[MAX_COMMANDS];
+
+//Internal helper prototypes
+static void QueueMessage(REMOTE *remote, int type, int robot, int tick,
+		void *payload, int length);
+static int ReadMessage(REMOTE *remote, REMOTE_MSG_HEADER *header, void *payload,
+		int maxLength);
+static int ReadAll(REMOTE *remote, void *buffer, int length);
+static int KeepOrders(REMOTE *remote, REMOTE_MSG_HEADER *header);
+static void WriteAll(REMOTE *remote, void *buffer, int length);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ConnectRemote
+//
+// Description: This function returns the connection to a brain, connecting
+//              if no robot is using that socket yet.
+//
+// Parameters: char *socketPath - Path of the brain's Unix domain socket.
+//
+// Returns: REMOTE* - The connection, or NULL if it could not be made.
+//
+////////////////////////////////////////////////////////////////////////////////
+REMOTE *ConnectRemote(char *socketPath) {
+	struct sockaddr_un address;
+	REMOTE *remote;
+	int i, slot = -1;
+
+	for (i = 0; i < MAX_ROBOTS; i++)
+		if (remotes[i] == NULL)
+			slot = slot < 0 ? i : slot;
+		else if (!strcmp(remotes[i]->path, socketPath)) {
+			remotes[i]->users++;
+			return remotes[i];
+		}
+	if (slot < 0 || strlen(socketPath) >= sizeof(address.sun_path))
+		return NULL;
+
+	remote = calloc(1, sizeof(REMOTE));
+	if (remote == NULL)
+		return NULL;
+	strcpy(remote->path, socketPath);
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+	remote->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (remote->fd < 0 || connect(remote->fd, (struct sockaddr *) &address,
+			sizeof(address)) != 0) {
+		if (remote->fd >= 0)
+			close(remote->fd);
+		free(remote);
+		return NULL;
+	}
+
+	signal(SIGPIPE, SIG_IGN);        //A brain exiting must not end the match.
+	remote->users = 1;
+	remotes[slot] = remote;
+	return remote;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RemoteHello
+//
+// Description: This function introduces a robot to its brain and waits for
+//              the robot's sensor configuration.
+//
+// Parameters: REMOTE *remote - The robot's connection.
+//             int robot - The robot's number.
+//             char *name - The robot's name.
+//             REMOTE_SENSOR *sensors - Filled out with the sensors to add.
+//             int maxSensors - Size of the sensors array.
+//
+// Returns: int - The number of sensors, or -1 if the brain didn't answer.
+//
+////////////////////////////////////////////////////////////////////////////////
+int RemoteHello(REMOTE *remote, int robot, char *name,
+		REMOTE_SENSOR *sensors, int maxSensors) {
+	REMOTE_MSG_HEADER header;
+
+	QueueMessage(remote, REMOTE_MSG_HELLO, robot, 0, name, strlen(name) + 1);
+	FlushObservations(remote);
+
+	for (;;) {
+		if (!ReadMessage(remote, &header, readBuffer, sizeof(readBuffer)))
+			return -1;
+		if (header.type == REMOTE_MSG_CONFIGURE && header.robot == robot) {
+			if (header.length > maxSensors * (int) sizeof(REMOTE_SENSOR)) {
+				remote->failed = 1;
+				return -1;
+			}
+			memcpy(sensors, readBuffer, header.length);
+			return header.length / sizeof(REMOTE_SENSOR);
+		}
+		if (header.type == REMOTE_MSG_ORDERS         //Orders sent early for
+				&& !KeepOrders(remote, &header))         //the first tick.
+			return -1;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SendObservation
+//
+// Description: This function queues a robot's observation.  It is sent by
+//              the next FlushObservations().
+//
+// Parameters: REMOTE *remote - The robot's connection.
+//             int robot - The robot's number.
+//             int tick - The order tick.
+//             ROBOT *theRobot - The robot, with its view taken.
+//             int gpsValid - Whether to fill in the robot's position.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SendObservation(REMOTE *remote, int robot, int tick, ROBOT *theRobot,
+		int gpsValid) {
+	REMOTE_OBSERVATION observation;
+	ROBOT_VIEW *view = &theRobot->view;
+	int i;
+
+	memset(&observation, 0, sizeof(observation));
+	observation.gpsValid = gpsValid;
+	if (gpsValid) {
+		observation.x = view->x;
+		observation.y = view->y;
+		observation.heading = view->heading;
+	}
+	observation.shields = view->shields;
+	observation.laserEnergy = view->chargeEnergy[LASER_PORT];
+	observation.missileEnergy = view->chargeEnergy[MISSILE_PORT];
+	observation.generatorStructure = view->generatorStructure;
+	observation.turboTime = view->turboTime;
+	observation.bumped = view->bumped;
+	for (i = 0; i < MAX_SENSORS; i++)
+		if (view->sensorType[i] != SENSOR_NONE && view->sensorOn[i]
+				&& view->sensorPowered[i])
+			observation.sensorData[i] = view->sensorData[i];
+		else
+			observation.sensorData[i] = -1;
+	observation.mailCount = view->mailCount;
+	for (i = 0; i < view->mailCount; i++)
+		observation.mail[i] = view->mail[i];
+
+	QueueMessage(remote, REMOTE_MSG_OBSERVE, robot, tick, &observation,
+			sizeof(observation));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FlushObservations
+//
+// Description: This function sends every queued message in one write.
+//
+// Parameters: REMOTE *remote - The connection.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void FlushObservations(REMOTE *remote) {
+	if (remote->outCount > 0 && !remote->failed)
+		WriteAll(remote, remote->outBuffer, remote->outCount);
+	remote->outCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReceiveOrders
+//
+// Description: This function returns a robot's orders for an order tick,
+//              waiting for them if they haven't arrived yet.
+//
+// Parameters: REMOTE *remote - The robot's connection.
+//             int robot - The robot's number.
+//             int tick - The order tick the orders answer.
+//             REMOTE_COMMAND *commands - Filled out with the commands.
+//             int maxCommands - Size of the commands array.
+//
+// Returns: int - The number of commands.  0 if the connection has failed.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ReceiveOrders(REMOTE *remote, int robot, int tick,
+		REMOTE_COMMAND *commands, int maxCommands) {
+	REMOTE_MSG_HEADER header;
+	int i, count;
+
+	for (i = 0; i < REMOTE_INBOX_SIZE; i++)          //Already arrived?
+		if (remote->inbox[i].used && remote->inbox[i].robot == robot
+				&& remote->inbox[i].tick == tick) {
+			count = remote->inbox[i].count;
+			if (count > maxCommands)
+				count = maxCommands;
+			memcpy(commands, remote->inbox[i].commands,
+					count * sizeof(REMOTE_COMMAND));
+			remote->inbox[i].used = 0;
+			return count;
+		}
+
+	while (!remote->failed) {
+		if (!ReadMessage(remote, &header, readBuffer, sizeof(readBuffer)))
+			return 0;
+		if (header.type != REMOTE_MSG_ORDERS)
+			continue;
+
+		if (header.robot == robot && header.tick == tick) {
+			count = header.length / sizeof(REMOTE_COMMAND);
+			if (count > maxCommands)
+				count = maxCommands;
+			memcpy(commands, readBuffer, count * sizeof(REMOTE_COMMAND));
+			return count;
+		}
+		if (!KeepOrders(remote, &header))     //For another robot or tick.
+			return 0;
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DisconnectRemote
+//
+// Description: This function is called once for each robot using a
+//              connection.  When the last one is done the brain is told the
+//              match is over and the connection is closed.
+//
+// Parameters: REMOTE *remote - The connection.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void DisconnectRemote(REMOTE *remote) {
+	int i;
+
+	if (--remote->users > 0)
+		return;
+
+	QueueMessage(remote, REMOTE_MSG_END, -1, 0, NULL, 0);
+	FlushObservations(remote);
+	close(remote->fd);
+	for (i = 0; i < MAX_ROBOTS; i++)
+		if (remotes[i] == remote)
+			remotes[i] = NULL;
+	free(remote->outBuffer);
+	free(remote);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NextRemoteMatch
+//
+// Description: This function ends the match on every open connection and
+//              moves on to the next match number.  The connections stay
+//              open for the robots' next HELLO.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void NextRemoteMatch(void) {
+	int i, j;
+
+	for (i = 0; i < MAX_ROBOTS; i++)
+		if (remotes[i] != NULL) {
+			QueueMessage(remotes[i], REMOTE_MSG_END, -1, 0, NULL, 0);
+			FlushObservations(remotes[i]);
+			for (j = 0; j < REMOTE_INBOX_SIZE; j++)
+				remotes[i]->inbox[j].used = 0;
+		}
+	matchNumber++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Internal helpers.  QueueMessage() adds a message to the outgoing buffer,
+// ReadMessage() reads one whole message of this match (failing the connection
+// if the payload is too big), KeepOrders() puts the orders just read in the
+// inbox, and ReadAll()/WriteAll() move bytes, marking the connection failed
+// on any error or timeout.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void QueueMessage(REMOTE *remote, int type, int robot, int tick,
+		void *payload, int length) {
+	REMOTE_MSG_HEADER header;
+	char *buffer;
+	int needed = remote->outCount + sizeof(header) + length;
+
+	if (needed > remote->outCapacity) {
+		buffer = realloc(remote->outBuffer, needed * 2);
+		if (buffer == NULL)
+			AbortOnError("QueueMessage() could not grow a remote robot's "
+					"buffer.\nProgram will end.");
+		remote->outBuffer = buffer;
+		remote->outCapacity = needed * 2;
+	}
+
+	header.type = type;
+	header.match = matchNumber;
+	header.robot = robot;
+	header.tick = tick;
+	header.length = length;
+	memcpy(remote->outBuffer + remote->outCount, &header, sizeof(header));
+	remote->outCount += sizeof(header);
+	if (length > 0)
+		memcpy(remote->outBuffer + remote->outCount, payload, length);
+	remote->outCount += length;
+}
+
+static int ReadMessage(REMOTE *remote, REMOTE_MSG_HEADER *header, void *payload,
+		int maxLength) {
+	do {
+		if (!ReadAll(remote, header, sizeof(REMOTE_MSG_HEADER)))
+			return 0;
+		if (header->length < 0 || header->length > maxLength
+				|| header->match > matchNumber) {
+			remote->failed = 1;                //Can't resynchronise: give up.
+			return 0;
+		}
+		if (!ReadAll(remote, payload, header->length))
+			return 0;
+	} while (header->match < matchNumber);   //Sent before the last END.
+	return 1;
+}
+
+static int KeepOrders(REMOTE *remote, REMOTE_MSG_HEADER *header) {
+	int i;
+
+	for (i = 0; i < REMOTE_INBOX_SIZE; i++)
+		if (!remote->inbox[i].used) {
+			remote->inbox[i].used = 1;
+			remote->inbox[i].robot = header->robot;
+			remote->inbox[i].tick = header->tick;
+			remote->inbox[i].count = header->length / sizeof(REMOTE_COMMAND);
+			memcpy(remote->inbox[i].commands, readBuffer,
+					remote->inbox[i].count * sizeof(REMOTE_COMMAND));
+			return 1;
+		}
+	remote->failed = 1;          //Brain is running too far ahead or is lost.
+	return 0;
+}
+
+static int ReadAll(REMOTE *remote, void *buffer, int length) {
+	struct pollfd ready;
+	int got;
+
+	ready.fd = remote->fd;
+	ready.events = POLLIN;
+	while (length > 0 && !remote->failed) {
+		if (poll(&ready, 1, REMOTE_TIMEOUT_MS) != 1
+				|| (got = read(remote->fd, buffer, length)) <= 0) {
+			remote->failed = 1;
+			break;
+		}
+		buffer = (char *) buffer + got;
+		length -= got;
+	}
+	return !remote->failed;
+}
+
+static void WriteAll(REMOTE *remote, void *buffer, int length) {
+	int sent;
+
+	while (length > 0 && !remote->failed) {
+		if ((sent = write(remote->fd, buffer, length)) <= 0) {
+			remote->failed = 1;
+			break;
+		}
+		buffer = (char *) buffer + sent;
+		length -= sent;
+	}
+}
+
+#else
+
+REMOTE *ConnectRemote(char *socketPath) {
+	return NULL;                    //No Unix domain sockets on this platform.
+}
+
+int RemoteHello(REMOTE *remote, int robot, char *name,
+		REMOTE_SENSOR *sensors, int maxSensors) {
+	return -1;
+}
+
+void SendObservation(REMOTE *remote, int robot, int tick, ROBOT *theRobot,
+		int gpsValid) {
+}
+
+void FlushObservations(REMOTE *remote) {
+}
+
+int ReceiveOrders(REMOTE *remote, int robot, int tick,
+		REMOTE_COMMAND *commands, int maxCommands) {
+	return 0;
+}
+
+void DisconnectRemote(REMOTE *remote) {
+}
+
+void NextRemoteMatch(void) {
+}
+
+#endif
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: remote.h
+//
+// Description: This file contains the functions and protocol for remote
+//              robots: robots whose orders come from another process on the
+//              same machine over a Unix domain socket.  The other process
+//              (the "brain") listens on the socket and the engine connects.
+//              Every remote robot using the same socket path shares one
+//              connection.
+//
+//              Every message is a REMOTE_MSG_HEADER followed by length bytes
+//              of payload.  All fields are in host byte order as both ends
+//              are on the same machine.
+//
+//                 Engine                           Brain
+//                 HELLO (name)          ----->
+//                                       <-----     CONFIGURE (sensors)
+//                                       <-----     ORDERS, tick 0
+//                 OBSERVE, tick 1       ----->
+//                 ...                             (tick 1 - latency)
+//                                       <-----     ORDERS, tick 1
+//                 OBSERVE, tick 2       ----->
+//                 ...
+//                 END                   ----->
+//                 HELLO, next match     ----->     (after ResetMatch())
+//                 ...
+//
+//              Ticks count order ticks.  At each order tick the engine sends
+//              the observations of all the connection's robots in one write
+//              and then waits for the orders answering the observations of
+//              latency order ticks ago (see SetRemoteLatency()).  With a
+//              latency above 0 the brain has a whole order period (or more) to
+//              think while the engine simulates, and the orders are still
+//              applied at a fixed tick.  Replies may arrive in any order.
+//
+//              After END a brain may be sent HELLO again with the next match
+//              number.  Anything it sends for the old match after END is
+//              ignored.
+//
+//              Commands use the COMMANDTYPE numbering and arguments, except
+//              that CMD_STATUS_MESSAGE is ignored and CMD_SEND_MESSAGE takes
+//              the robot number rather than a name.  They are checked by the
+//              same robot API functions compiled-in robots use.  GPS data is
+//              only filled in (gpsValid) after a CMD_USE_GPS in the previous
+//              orders succeeded, so it costs what it costs everyone else.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Added NextRemoteMatch().
+//                  18 Oct 2026 - The message header is REMOTE_MSG_HEADER, so
+//                                REMOTE_HEADER can guard this file.
+//                  18 Oct 2026 - The latency is set at run time, with
+//                                SetRemoteLatency().
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef REMOTE_HEADER
+#define REMOTE_HEADER 1
+
+#include "competition.h"
+
+#define REMOTE_MSG_HELLO      1   //Engine: robot joined.  Payload: the name.
+#define REMOTE_MSG_CONFIGURE  2   //Brain: payload REMOTE_SENSOR[].
+#define REMOTE_MSG_OBSERVE    3   //Engine: payload REMOTE_OBSERVATION.
+#define REMOTE_MSG_ORDERS     4   //Brain: payload REMOTE_COMMAND[].
+#define REMOTE_MSG_END        5   //Engine: the match is over.  No payload.
+
+typedef struct {
+	INT_32 type;                  //One of the REMOTE_MSG_ values.
+	INT_32 match;                 //Lets one brain serve several matches.
+	INT_32 robot;                 //Robot number within the match.
+	INT_32 tick;                  //Order tick the message belongs to.
+	INT_32 length;                //Bytes of payload that follow.
+} REMOTE_MSG_HEADER;
+
+typedef struct {                  //Arguments to AddSensor().
+	INT_32 port;
+	INT_32 type;
+	INT_32 angle;
+	INT_32 width;
+	INT_32 range;
+} REMOTE_SENSOR;
+
+typedef struct {
+	INT_32 type;                  //A COMMANDTYPE value.
+	INT_32 args[NUM_ENERGY_SYSTEMS];
+} REMOTE_COMMAND;
+
+typedef struct {
+	INT_32 gpsValid;              //x, y and heading are only valid if set.
+	float x;
+	float y;
+	float heading;
+	float shields;
+	float laserEnergy;
+	float missileEnergy;
+	INT_32 generatorStructure;
+	INT_32 turboTime;
+	INT_32 bumped;
+	INT_32 sensorData[MAX_SENSORS];   //-1 if off, unpowered or no sensor.
+	INT_32 mailCount;
+	INT_32 mail[MAILBOX_VIEW_SIZE];
+} REMOTE_OBSERVATION;
+
+REMOTE *ConnectRemote(char *socketPath);
+int RemoteHello(REMOTE *remote, int robot, char *name,
+		REMOTE_SENSOR *sensors, int maxSensors);
+void SendObservation(REMOTE *remote, int robot, int tick, ROBOT *theRobot,
+		int gpsValid);
+void FlushObservations(REMOTE *remote);
+int ReceiveOrders(REMOTE *remote, int robot, int tick,
+		REMOTE_COMMAND *commands, int maxCommands);
+void DisconnectRemote(REMOTE *remote);
+void NextRemoteMatch(void);
+void SetRemoteLatency(int ticks);
+int GetRemoteLatency(void);
+
+#endif
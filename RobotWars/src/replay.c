@@ -0,0 +1,850 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: replay.c
+//
+// Description: This file implements the replay viewer described in
+//              replay.h.
+//
+//              The decoder keeps the state as of one tick, just as the
+//              recorder does, and each frame is applied to it in turn.  A
+//              recording can be damaged or cut short, so every read is
+//              checked against the end of the frames; a frame that runs
+//              past it ends the recording there.
+//
+//              The viewer builds a ROBOT and a WEAPON for everything in the
+//              recording and fills them from the decoded state, so the
+//              normal bitmap drawing and RenderScene() are used unchanged.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - The viewer's lists and bitmaps are counted in
+//                                the memory accounts (see memstats.h).
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "replay.h"
+#include "graphics.h"
+#include "particles.h"
+#include "physics.h"
+#include "memstats.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define REPLAY_SKIP_CALCS  (CALCS_PER_SEC * 10)     //PGUP/PGDN.
+
+extern volatile int calcCounter;       //The calculation timer, shared with
+void AddCalc(void);                    //Fight().  See competition.c.
+
+static char *endNames[] = { "running", "knockout", "time limit",
+		"stalemate" };
+static int speeds[] = { -64, -32, -16, -8, -4, -2, -1, 1, 2, 4, 8, 16, 32,
+		64 };                          //Quarter ticks a calculation.
+#define NUM_SPEEDS  (int) (sizeof(speeds) / sizeof(speeds[0]))
+#define NORMAL_SPEED  9
+
+typedef struct {                 //A weapon as of the current tick.
+	int id;
+	WEAPONTYPE type;
+	int owner;
+	int x;                       //Scaled.
+	int y;
+	int heading;
+	int dx;                      //Movement in the last frame.
+	int dy;
+} REPLAY_WEAPON;
+
+typedef struct {                 //Reads through frames, never past the end.
+	const unsigned char *at;
+	const unsigned char *end;
+	int bad;                     //Set if a read ran past the end.
+} FRAME_READER;
+
+struct REPLAY_TAG {
+	const unsigned char *data;   //The whole file.
+	long size;
+	const RECORD_HEADER *header;
+	const unsigned char *frames; //First frame,
+	const unsigned char *framesEnd;           //and just after the last.
+	RECORD_INDEX_ENTRY *index;
+	int numKeyframes;
+	int endTick;                 //Last tick in the recording.
+	int ended;                   //1 if there is an end frame,
+	MATCH_END end;               //saying how the match ended
+	int winner;                  //and who won.
+	const unsigned char *next;   //Frame after the current tick's.
+	int tick;                    //Tick decoded, -1 if none.
+	int fields[MAX_ROBOTS][RF_NUM_FIELDS];
+	char statusMessage[MAX_ROBOTS][STATUS_MSG_LEN];
+	REPLAY_WEAPON *weapons;      //In the order fired.
+	int numWeapons;
+	int weaponCapacity;
+};
+
+//Internal helper prototypes
+static const unsigned char *MapFile(char *fileName, long *size);
+static void UnmapFile(const unsigned char *data, long size);
+static int ReadIndex(REPLAY *replay);
+static int ScanKeyframes(REPLAY *replay);
+static int FindEnd(REPLAY *replay);
+static int DecodeFrame(REPLAY *replay);
+static void DecodeRobot(FRAME_READER *in, int *fields, char *statusMessage);
+static void DecodeWeapons(REPLAY *replay, FRAME_READER *in);
+static unsigned int GetNumber(FRAME_READER *in);
+static int GetSigned(FRAME_READER *in);
+static void ShowTick(REPLAY *replay, ROBOT **byNumber, t_LL robots,
+		t_LL deadRobots, t_LL weapons);
+static void ShowWeapons(REPLAY *replay, t_LL weapons);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: OpenReplay
+//
+// Description: This function maps a recording and finds its keyframes and
+//              its last tick.  Nothing is decoded until SeekReplay().
+//
+// Parameters: char *fileName - The recording.
+//
+// Returns: REPLAY* - The replay, or NULL if the file can't be read, isn't a
+//                    recording or has no complete frame.
+//
+////////////////////////////////////////////////////////////////////////////////
+REPLAY *OpenReplay(char *fileName) {
+	REPLAY *replay = calloc(1, sizeof(REPLAY));
+
+	if (replay == NULL)
+		AbortOnError("OpenReplay() could not allocate a replay.\n"
+				"Program will end.");
+	replay->data = MapFile(fileName, &replay->size);
+	if (replay->data == NULL) {
+		free(replay);
+		return NULL;
+	}
+
+	replay->header = (const RECORD_HEADER *) replay->data;
+	replay->frames = replay->data + sizeof(RECORD_HEADER);
+	replay->tick = -1;
+	if (replay->size < (long) sizeof(RECORD_HEADER)
+			|| replay->header->magic != RECORD_MAGIC
+			|| replay->header->version != RECORD_VERSION
+			|| replay->header->numRobots < 1
+			|| replay->header->numRobots > MAX_ROBOTS
+			|| (!ReadIndex(replay) && !ScanKeyframes(replay))
+			|| !FindEnd(replay)) {
+		CloseReplay(replay);
+		return NULL;
+	}
+	return replay;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CloseReplay
+//
+// Description: This function unmaps a recording and frees the replay.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void CloseReplay(REPLAY *replay) {
+	UnmapFile(replay->data, replay->size);
+	free(replay->index);
+	free(replay->weapons);
+	free(replay);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetReplayStart / GetReplayEnd
+//
+// Description: These functions give the first and last ticks of the
+//              recording.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: int - The tick.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetReplayStart(REPLAY *replay) {
+	return replay->index[0].tick;
+}
+
+int GetReplayEnd(REPLAY *replay) {
+	return replay->endTick;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SeekReplay
+//
+// Description: This function decodes the state of the match at a tick.
+//              Going forward it carries on from the current tick if there is
+//              no keyframe in between; otherwise it starts from the keyframe
+//              before the tick.
+//
+// Parameters: REPLAY *replay - The replay.
+//             int tick - The tick.  It is kept within the recording.
+//
+// Returns: int - The tick decoded, which is only different from the one
+//                asked for if the recording is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+int SeekReplay(REPLAY *replay, int tick) {
+	RECORD_INDEX_ENTRY *index = replay->index;
+	int low = 0, high = replay->numKeyframes - 1, middle;
+
+	if (tick < index[0].tick)
+		tick = index[0].tick;
+	if (tick > replay->endTick)
+		tick = replay->endTick;
+
+	while (low < high) {              //Last keyframe at or before the tick.
+		middle = (low + high + 1) / 2;
+		if (index[middle].tick <= tick)
+			low = middle;
+		else
+			high = middle - 1;
+	}
+
+	if (replay->tick > tick || replay->tick < index[low].tick) {
+		replay->next = replay->data + index[low].offset;
+		replay->tick = -1;
+	}
+	while (replay->tick < tick && DecodeFrame(replay))
+		;
+	return replay->tick;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PlayReplay
+//
+// Description: This function shows the recording in the game window until
+//              ESC is pressed.  It is used instead of Fight(), after
+//              InitCompetition() with no robots registered.  The keys are
+//              listed in replay.h.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PlayReplay(REPLAY *replay) {
+	ROBOT robot, *byNumber[MAX_ROBOTS], *nextRobot, *shown;
+	WEAPON *weapon, *nextWeapon;
+	t_LL robots = ConsLL(), deadRobots = ConsLL(), weapons = ConsLL();
+	int start = GetReplayStart(replay), end = GetReplayEnd(replay);
+	int position = start * 4, speed = NORMAL_SPEED, paused = 0;
+	int showing = -1, tick, i, j;
+
+	AccountLL(robots, MA_ROBOT_NODES);
+	AccountLL(deadRobots, MA_ROBOT_NODES);
+	AccountLL(weapons, MA_WEAPON_NODES);
+	char message[255], speedText[16];
+
+	for (i = 0; i < replay->header->numRobots; i++) {
+		memset(&robot, 0, sizeof(robot));
+		robot.name = (char *) replay->header->names[i];
+		robot.number = i;
+		robot.color = replay->header->colors[i];
+		robot.image = CreateBitmap(MA_SHIELD_BITMAPS, SHIELD_BMP_SZ,
+				SHIELD_BMP_SZ);
+		for (j = 0; j < MAX_SENSORS; j++) {
+			robot.sensorArray[j].type = replay->header->sensors[i][j].type;
+			robot.sensorArray[j].angle = replay->header->sensors[i][j].angle;
+			robot.sensorArray[j].width = replay->header->sensors[i][j].width;
+			robot.sensorArray[j].range = replay->header->sensors[i][j].range;
+			if (robot.sensorArray[j].type == SENSOR_RADAR)
+				robot.sensorArray[j].image = CreateBitmap(MA_RADAR_BITMAPS,
+						RADAR_IMAGE_PX, RADAR_IMAGE_PX);
+		}
+		InsLastLL(robots, robot);
+		byNumber[i] = LastElmLL(robots);
+		if (byNumber[i]->image == NULL)
+			AbortOnError("PlayReplay() failed to create a robot image.\n"
+					"Program will end.");
+	}
+
+	ClearParticles();                 //Particles aren't recorded.
+	LOCK_VARIABLE(calcCounter);
+	LOCK_FUNCTION(AddCalc);
+	if (install_int_ex(AddCalc, BPS_TO_TIMER(CALCS_PER_SEC)) != 0)
+		AbortOnError("PlayReplay() failed to create calcs timer.\n"
+				"Program will exit.");
+	calcCounter = 0;
+
+	while (!key[KEY_ESC]) {
+		while (keypressed())
+			switch (readkey() >> 8) {
+			case KEY_SPACE:
+				paused = !paused;
+				break;
+			case KEY_UP:
+				if (speed < NUM_SPEEDS - 1)
+					speed++;
+				break;
+			case KEY_DOWN:
+				if (speed > 0)
+					speed--;
+				break;
+			case KEY_LEFT:
+				paused = 1;
+				position = (position / 4 - 1) * 4;
+				break;
+			case KEY_RIGHT:
+				paused = 1;
+				position = (position / 4 + 1) * 4;
+				break;
+			case KEY_PGUP:
+				position -= REPLAY_SKIP_CALCS * 4;
+				break;
+			case KEY_PGDN:
+				position += REPLAY_SKIP_CALCS * 4;
+				break;
+			case KEY_HOME:
+				position = start * 4;
+				break;
+			case KEY_END:
+				position = end * 4;
+				break;
+			}
+
+		while (calcCounter) {
+			calcCounter--;
+			if (!paused)
+				position += speeds[speed];
+		}
+		if (position < start * 4)
+			position = start * 4;
+		if (position > end * 4)
+			position = end * 4;
+
+		tick = position / 4;
+		if (tick != showing) {
+			SeekReplay(replay, tick);
+			ShowTick(replay, byNumber, robots, deadRobots, weapons);
+			showing = tick;
+		}
+
+		if (speeds[speed] % 4 == 0)
+			sprintf(speedText, "%d", speeds[speed] / 4);
+		else
+			sprintf(speedText, "%s1/%d", speeds[speed] < 0 ? "-" : "",
+					4 / abs(speeds[speed]));
+		if (replay->ended && replay->tick == end)
+			sprintf(message, "Replay %d/%d: over (%s).", replay->tick, end,
+					endNames[replay->end]);
+		else
+			sprintf(message, "Replay %d/%d  x%s%s", replay->tick, end,
+					speedText, paused ? "  paused" : "");
+		RenderScene(robots, deadRobots, weapons, message);
+	}
+
+	SafeForeachLL_M(weapons, weapon, nextWeapon)
+	{
+		nextWeapon = NextElmLL(weapon);
+		DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+		DelElmLL(weapon);
+	}
+	while (!IsEmptyLL(deadRobots))
+		LinkAftLL(LastElmLL(robots), UnlinkLL(FirstElmLL(deadRobots)));
+	SafeForeachLL_M(robots, shown, nextRobot)
+	{
+		nextRobot = NextElmLL(shown);
+		for (j = 0; j < MAX_SENSORS; j++)
+			if (shown->sensorArray[j].image != NULL)
+				DestroyBitmap(MA_RADAR_BITMAPS, shown->sensorArray[j].image);
+		DestroyBitmap(MA_SHIELD_BITMAPS, shown->image);
+		DelElmLL(shown);
+	}
+	DestLL(robots);
+	DestLL(deadRobots);
+	DestLL(weapons);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MapFile / UnmapFile
+//
+// Description: These functions map a whole file into memory, read only, and
+//              unmap it.  Where there is no mmap() the file is read instead.
+//
+// Parameters: char *fileName - The file.
+//             long *size - Set to its size.
+//
+// Returns: MapFile: unsigned char* - The file, or NULL if it can't be read
+//                                    or is empty.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _WIN32
+
+static const unsigned char *MapFile(char *fileName, long *size) {
+	struct stat info;
+	void *data;
+	int file = open(fileName, O_RDONLY);
+
+	if (file < 0)
+		return NULL;
+	if (fstat(file, &info) != 0 || info.st_size == 0) {
+		close(file);
+		return NULL;
+	}
+	data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);                         //The mapping outlives the file.
+	if (data == MAP_FAILED)
+		return NULL;
+	*size = info.st_size;
+	return data;
+}
+
+static void UnmapFile(const unsigned char *data, long size) {
+	munmap((void *) data, size);
+}
+
+#else
+
+static const unsigned char *MapFile(char *fileName, long *size) {
+	FILE *file = fopen(fileName, "rb");
+	unsigned char *data = NULL;
+
+	if (file == NULL)
+		return NULL;
+	fseek(file, 0, SEEK_END);
+	*size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	if (*size > 0)
+		data = malloc(*size);
+	if (data != NULL && fread(data, 1, *size, file) != (size_t) *size) {
+		free(data);
+		data = NULL;
+	}
+	fclose(file);
+	return data;
+}
+
+static void UnmapFile(const unsigned char *data, long size) {
+	free((void *) data);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadIndex
+//
+// Description: This function reads the keyframe index from the end of the
+//              recording.  The entries are copied out, as the index isn't
+//              aligned within the file.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: int - 1 if successful, 0 if there is no good index.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ReadIndex(REPLAY *replay) {
+	RECORD_FOOTER footer;
+	long indexSize;
+	int i;
+
+	if (replay->size < (long) (sizeof(RECORD_HEADER) + sizeof(footer)))
+		return 0;
+	memcpy(&footer, replay->data + replay->size - sizeof(footer),
+			sizeof(footer));
+	indexSize = (long) footer.numKeyframes * sizeof(RECORD_INDEX_ENTRY);
+	if (footer.magic != RECORD_MAGIC || footer.numKeyframes < 1
+			|| footer.indexOffset < sizeof(RECORD_HEADER)
+			|| footer.indexOffset + indexSize + sizeof(footer)
+					!= (unsigned long) replay->size)
+		return 0;
+
+	replay->index = malloc(indexSize);
+	if (replay->index == NULL)
+		AbortOnError("ReadIndex() could not allocate the keyframe index.\n"
+				"Program will end.");
+	memcpy(replay->index, replay->data + footer.indexOffset, indexSize);
+	replay->numKeyframes = footer.numKeyframes;
+	replay->framesEnd = replay->data + footer.indexOffset;
+
+	for (i = 0; i < replay->numKeyframes; i++)
+		if (replay->index[i].offset < sizeof(RECORD_HEADER)
+				|| replay->index[i].offset >= footer.indexOffset
+				|| replay->data[replay->index[i].offset] != RECORD_KEYFRAME) {
+			free(replay->index);
+			replay->index = NULL;
+			replay->numKeyframes = 0;
+			return 0;
+		}
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ScanKeyframes
+//
+// Description: This function builds the keyframe index of a recording that
+//              has none by decoding every frame.  The recording ends at the
+//              first frame that can't be decoded.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: int - 1 if a keyframe was found, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ScanKeyframes(REPLAY *replay) {
+	int capacity = 0;
+	unsigned int offset;
+
+	replay->framesEnd = replay->data + replay->size;
+	replay->next = replay->frames;
+	replay->tick = -1;
+	for (;;) {
+		offset = replay->next - replay->data;
+		if (!DecodeFrame(replay))
+			break;
+		if (replay->data[offset] != RECORD_KEYFRAME)
+			continue;
+		if (replay->numKeyframes == capacity) {
+			capacity = capacity * 2 + 64;
+			replay->index = realloc(replay->index,
+					capacity * sizeof(RECORD_INDEX_ENTRY));
+			if (replay->index == NULL)
+				AbortOnError("ScanKeyframes() could not grow the keyframe "
+						"index.\nProgram will end.");
+		}
+		replay->index[replay->numKeyframes].tick = replay->tick;
+		replay->index[replay->numKeyframes++].offset = offset;
+	}
+	replay->tick = -1;
+	return replay->numKeyframes > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FindEnd
+//
+// Description: This function finds the last tick by decoding on from the
+//              last keyframe, and how the match ended if it says.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: int - 1 if successful, 0 if the last keyframe is damaged.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int FindEnd(REPLAY *replay) {
+	FRAME_READER in;
+
+	replay->next = replay->data
+			+ replay->index[replay->numKeyframes - 1].offset;
+	replay->tick = -1;
+	replay->endTick = -1;
+	while (DecodeFrame(replay))
+		replay->endTick = replay->tick;
+
+	in.at = replay->next;
+	in.end = replay->framesEnd;
+	in.bad = 0;
+	if (in.at < in.end && *in.at++ == RECORD_END) {
+		replay->end = GetNumber(&in);
+		GetNumber(&in);                          //Calculations.
+		replay->winner = GetSigned(&in);
+		replay->ended = !in.bad && replay->end <= MATCH_STALEMATE;
+	}
+	return replay->endTick >= 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DecodeFrame
+//
+// Description: This function applies the next frame to the state.  A delta
+//              frame needs the state of the tick before it.
+//
+// Parameters: REPLAY *replay - The replay.
+//
+// Returns: int - 1 if a frame was decoded.  0 at the end frame, the end of
+//                the frames or a damaged frame, after which the state is
+//                gone and the tick is -1.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int DecodeFrame(REPLAY *replay) {
+	FRAME_READER in;
+	int tick, i;
+
+	in.at = replay->next;
+	in.end = replay->framesEnd;
+	in.bad = 0;
+	if (in.at >= in.end)
+		return 0;
+
+	switch (*in.at++) {
+	case RECORD_KEYFRAME:
+		tick = GetNumber(&in);
+		memset(replay->fields, 0, sizeof(replay->fields));
+		memset(replay->statusMessage, 0, sizeof(replay->statusMessage));
+		replay->numWeapons = 0;
+		break;
+	case RECORD_DELTA:
+		if (replay->tick < 0)
+			return 0;
+		tick = replay->tick + 1;
+		break;
+	default:
+		return 0;
+	}
+
+	GetNumber(&in);                            //Sounds aren't played back.
+	for (i = 0; i < replay->header->numRobots; i++)
+		DecodeRobot(&in, replay->fields[i], replay->statusMessage[i]);
+	DecodeWeapons(replay, &in);
+
+	if (in.bad) {
+		replay->tick = -1;
+		return 0;
+	}
+	replay->tick = tick;
+	replay->next = in.at;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DecodeRobot
+//
+// Description: This function applies the changes to one robot.
+//
+// Parameters: FRAME_READER *in - The frame.
+//             int *fields - The robot's fields.
+//             char *statusMessage - Its status message.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void DecodeRobot(FRAME_READER *in, int *fields, char *statusMessage) {
+	unsigned int mask = GetNumber(in), length;
+	int i;
+
+	for (i = 0; i < RF_NUM_FIELDS; i++)
+		if (mask & (1 << i))
+			fields[i] += GetSigned(in);
+
+	if (mask & (1 << RF_NUM_FIELDS)) {
+		length = GetNumber(in);
+		if (length >= STATUS_MSG_LEN || length > (unsigned) (in->end - in->at)) {
+			in->bad = 1;
+			return;
+		}
+		memset(statusMessage, 0, STATUS_MSG_LEN);
+		memcpy(statusMessage, in->at, length);
+		in->at += length;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: DecodeWeapons
+//
+// Description: This function removes the weapons destroyed, adds those
+//              fired and moves the rest.
+//
+// Parameters: REPLAY *replay - The replay.
+//             FRAME_READER *in - The frame.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void DecodeWeapons(REPLAY *replay, FRAME_READER *in) {
+	REPLAY_WEAPON *weapon;
+	unsigned int count;
+	int id = 0, flying, i;
+
+	count = GetNumber(in);                    //Destroyed.
+	while (count-- > 0 && !in->bad) {
+		id += GetSigned(in);
+		for (i = 0; i < replay->numWeapons && replay->weapons[i].id != id; i++)
+			;
+		if (i == replay->numWeapons) {
+			in->bad = 1;
+			return;
+		}
+		memmove(&replay->weapons[i], &replay->weapons[i + 1],
+				(replay->numWeapons - i - 1) * sizeof(REPLAY_WEAPON));
+		replay->numWeapons--;
+	}
+
+	flying = replay->numWeapons;
+	count = GetNumber(in);                    //Fired.
+	if (count > (unsigned) (in->end - in->at)) {
+		in->bad = 1;                          //Each takes several bytes.
+		return;
+	}
+	if (replay->numWeapons + (int) count > replay->weaponCapacity) {
+		replay->weaponCapacity = (replay->numWeapons + count) * 2;
+		replay->weapons = realloc(replay->weapons,
+				replay->weaponCapacity * sizeof(REPLAY_WEAPON));
+		if (replay->weapons == NULL)
+			AbortOnError("DecodeWeapons() could not grow the weapon list.\n"
+					"Program will end.");
+	}
+	while (count-- > 0) {
+		weapon = &replay->weapons[replay->numWeapons++];
+		id += GetSigned(in);
+		weapon->id = id;
+		weapon->type = GetNumber(in);
+		weapon->owner = GetNumber(in);
+		weapon->x = GetSigned(in);
+		weapon->y = GetSigned(in);
+		weapon->heading = GetSigned(in);
+		weapon->dx = weapon->dy = 0;
+	}
+
+	for (i = 0; i < flying; i++) {            //Still flying.
+		weapon = &replay->weapons[i];
+		weapon->dx += GetSigned(in);
+		weapon->dy += GetSigned(in);
+		weapon->x += weapon->dx;
+		weapon->y += weapon->dy;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetNumber / GetSigned
+//
+// Description: These functions read a varint written by the recorder.
+//
+// Parameters: FRAME_READER *in - The frame.
+//
+// Returns: The number, or 0 if it runs past the end of the frames.
+//
+////////////////////////////////////////////////////////////////////////////////
+static unsigned int GetNumber(FRAME_READER *in) {
+	unsigned int value = 0, shift = 0, byte;
+
+	do {
+		if (in->at >= in->end || shift > 28) {
+			in->bad = 1;
+			return 0;
+		}
+		byte = *in->at++;
+		value |= (byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return value;
+}
+
+static int GetSigned(FRAME_READER *in) {
+	unsigned int value = GetNumber(in);
+
+	return value & 1 ? (int) ~(value >> 1) : (int) (value >> 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ShowTick
+//
+// Description: This function sets the viewer's robots and weapons from the
+//              decoded state and draws their bitmaps, ready for
+//              RenderScene().
+//
+// Parameters: REPLAY *replay - The replay.
+//             ROBOT **byNumber - The viewer's robots.
+//             t_LL robots - Robots shown fighting.
+//             t_LL deadRobots - Robots shown destroyed.
+//             t_LL weapons - Weapons shown.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ShowTick(REPLAY *replay, ROBOT **byNumber, t_LL robots,
+		t_LL deadRobots, t_LL weapons) {
+	ROBOT *robot;
+	int *fields, i, j;
+
+	for (i = 0; i < replay->header->numRobots; i++) {
+		robot = byNumber[i];
+		fields = replay->fields[i];
+		robot->x = fields[RF_X] / (float) RECORD_SCALE;
+		robot->y = fields[RF_Y] / (float) RECORD_SCALE;
+		robot->heading = fields[RF_HEADING] / (float) RECORD_SCALE;
+		robot->shields = fields[RF_SHIELDS] / (float) RECORD_SCALE;
+		robot->generatorStructure = fields[RF_STRUCTURE];
+		robot->turboTime = fields[RF_TURBO];
+		robot->weaponArray[LASER_PORT].chargeEnergy =
+				fields[RF_LASER_CHARGE] / (float) RECORD_SCALE;
+		robot->weaponArray[MISSILE_PORT].chargeEnergy =
+				fields[RF_MISSILE_CHARGE] / (float) RECORD_SCALE;
+		robot->bumped = fields[RF_BUMPED];
+		for (j = 0; j < MAX_SENSORS; j++) {
+			robot->sensorArray[j].on = (fields[RF_SENSORS] >> j) & 1;
+			robot->sensorArray[j].powered =
+					(fields[RF_SENSORS] >> (MAX_SENSORS + j)) & 1;
+			robot->sensorArray[j].data = fields[RF_SENSOR_DATA + j];
+		}
+		memcpy(robot->statusMessage, replay->statusMessage[i],
+				STATUS_MSG_LEN);
+		UpdateHeadingTrig(robot);
+
+		UnlinkLL(robot);                 //Keep both lists in number order.
+		LinkAftLL(LastElmLL(fields[RF_ALIVE] ? robots : deadRobots), robot);
+	}
+
+	DrawRobotBitmaps(robots);
+	DrawSensorBitmaps(robots);
+	ShowWeapons(replay, weapons);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ShowWeapons
+//
+// Description: This function makes the viewer's weapon list match the
+//              decoded weapons, reusing its elements and their bitmaps.
+//
+// Parameters: REPLAY *replay - The replay.
+//             t_LL weapons - Weapons shown.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ShowWeapons(REPLAY *replay, t_LL weapons) {
+	WEAPON shown, *weapon;
+	REPLAY_WEAPON *decoded = replay->weapons;
+	int size;
+
+	while (SizeLL(weapons) > replay->numWeapons) {
+		weapon = LastElmLL(weapons);
+		DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+		DelElmLL(weapon);
+	}
+	memset(&shown, 0, sizeof(shown));
+	while (SizeLL(weapons) < replay->numWeapons)
+		InsLastLL(weapons, shown);
+
+	ForeachLL_M(weapons, weapon)
+	{
+		if (weapon->image == NULL || weapon->type != decoded->type) {
+			if (weapon->image != NULL)
+				DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+			size = decoded->type == WEAPON_LASER ? LASER_BMP_SZ
+					: MISSILE_BMP_SZ;
+			weapon->image = CreateBitmap(MA_WEAPON_BITMAPS, size, size);
+			if (weapon->image == NULL)
+				AbortOnError("ShowWeapons() failed to create a weapon "
+						"image.\nProgram will end.");
+		}
+		weapon->id = decoded->id;
+		weapon->type = decoded->type;
+		weapon->x = decoded->x / (float) RECORD_SCALE;
+		weapon->y = decoded->y / (float) RECORD_SCALE;
+		weapon->heading = decoded->heading / (float) RECORD_SCALE;
+		DrawWeaponBitmap(weapon);
+		decoded++;
+	}
+}
@@ -0,0 +1,49 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: replay.h
+//
+// Description: This file contains the replay viewer, which plays back a
+//              recording made by RecordMatch() (see recorder.h) through
+//              RenderScene() without running any robot code.
+//
+//              The recording is memory mapped rather than read, so opening
+//              even a long one only touches its header, keyframe index and
+//              last few frames.  Any tick can be shown by decoding forward
+//              from the keyframe before it, so seeking costs at most
+//              RECORD_KEYFRAME_CALCS frames whichever way it goes.  A
+//              recording cut short has no index; it is found by reading the
+//              recording through once when it is opened.
+//
+//              PlayReplay() shows the recording in the game window:
+//
+//                  SPACE          - Pause or carry on.
+//                  UP/DOWN        - Faster or slower, through reverse.
+//                  LEFT/RIGHT     - Pause and step back or forward a tick.
+//                  PGUP/PGDN      - Back or forward 10 seconds.
+//                  HOME/END       - The start or the end.
+//                  ESC            - Leave.
+//
+//              Robots are drawn with the default robot graphic and no
+//              particles, as neither is recorded.
+//
+//              On POSIX systems the file is mapped with mmap(); elsewhere it
+//              is read into memory when opened.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef REPLAY_HEADER
+#define REPLAY_HEADER 1
+
+#include "recorder.h"
+
+typedef struct REPLAY_TAG REPLAY;
+
+REPLAY *OpenReplay(char *fileName);
+void CloseReplay(REPLAY *replay);
+int GetReplayStart(REPLAY *replay);
+int GetReplayEnd(REPLAY *replay);
+int SeekReplay(REPLAY *replay, int tick);
+void PlayReplay(REPLAY *replay);
+
+#endif
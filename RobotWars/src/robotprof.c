@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: robotprof.c
+//
+// Description: This file implements the robot profiles described in
+//              robotprof.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <string.h>
+#include "robotprof.h"
+
+#define REPORT_WIDTH  78                 //Wrap the call counts here.
+
+static long long orderBudget = 0;        //Nanoseconds a turn, 0 for none.
+static FILE *reportFile = NULL;          //See SetProfileReport().
+static char *callNames[NUM_ROBOT_CALLS] = { "AddSensor", "SetMotorSpeeds",
+		"TurboBoost", "IsTurboOn", "GetGPSInfo", "GetSensorData",
+		"SetSensorStatus", "FireWeapon", "GetSystemEnergy",
+		"SetSystemChargeRate", "SetSystemChargePriorites", "GetBumpInfo",
+		"GetGeneratorStructure", "GetGeneratorOutput", "SetStatusMessage",
+		"SendMessage", "GetMessage", "GetRandomNumber" };
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetOrderBudget
+//
+// Description: This function sets the soft budget for a robot's turn.
+//
+// Parameters: int microseconds - The most wall time a turn should take, or 0
+//                                for no budget.  0 by default.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetOrderBudget(int microseconds) {
+	orderBudget = microseconds > 0 ? microseconds * 1000LL : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetOrderBudget
+//
+// Description: This function gives the soft budget for a robot's turn.
+//
+// Parameters: None.
+//
+// Returns: int - The budget in microseconds, or 0 if there isn't one.
+//
+////////////////////////////////////////////////////////////////////////////////
+int GetOrderBudget(void) {
+	return (int) (orderBudget / 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetProfileReport
+//
+// Description: This function sets where the profiles are printed when a
+//              match ends.
+//
+// Parameters: FILE *file - Where to print, or NULL not to.  NULL by default.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void SetProfileReport(FILE *file) {
+	reportFile = file;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetProfileReport
+//
+// Description: This function gives where the profiles are printed.
+//
+// Parameters: None.
+//
+// Returns: FILE* - The file given to SetProfileReport(), or NULL.
+//
+////////////////////////////////////////////////////////////////////////////////
+FILE *GetProfileReport(void) {
+	return reportFile;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AddRobotTurn
+//
+// Description: This function adds a turn to a robot's profile and checks it
+//              against the budget.
+//
+// Parameters: ROBOT_PROFILE *profile - The robot's profile.
+//             long long wallTime - How long the turn took, in nanoseconds.
+//             long long cpuTime - The CPU time it used, or -1 if unknown.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void AddRobotTurn(ROBOT_PROFILE *profile, long long wallTime,
+		long long cpuTime) {
+	long long limit = 1000;              //Top of the first bucket, 1us.
+	int bucket = 0;
+
+	profile->turns++;
+	profile->wallTime += wallTime;
+	if (wallTime > profile->maxWallTime)
+		profile->maxWallTime = wallTime;
+	if (cpuTime >= 0) {
+		profile->cpuTurns++;
+		profile->cpuTime += cpuTime;
+	}
+	if (orderBudget > 0 && wallTime > orderBudget)
+		profile->overBudget++;
+
+	while (bucket < ROBOT_TIME_BUCKETS - 1 && wallTime >= limit) {
+		bucket++;
+		limit *= 2;
+	}
+	profile->histogram[bucket]++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ClearRobotProfile
+//
+// Description: This function empties a robot's profile.
+//
+// Parameters: ROBOT_PROFILE *profile - The profile.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ClearRobotProfile(ROBOT_PROFILE *profile) {
+	memset(profile, 0, sizeof(ROBOT_PROFILE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetMicrosPerTurn
+//
+// Description: This function gives a robot's average wall time a turn.
+//
+// Parameters: ROBOT_PROFILE *profile - The robot's profile.
+//
+// Returns: double - The average in microseconds, or 0 if it took no turns.
+//
+////////////////////////////////////////////////////////////////////////////////
+double GetMicrosPerTurn(ROBOT_PROFILE *profile) {
+	return profile->turns > 0 ? profile->wallTime / 1000.0 / profile->turns
+			: 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintProfileHeader
+//
+// Description: This function prints a title, the budget and the column
+//              headings for PrintRobotProfile().
+//
+// Parameters: FILE *file - Where to print.
+//             const char *title - What the rows are.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PrintProfileHeader(FILE *file, const char *title) {
+	if (orderBudget > 0)
+		fprintf(file, "%s (budget %d us a turn):\n", title, GetOrderBudget());
+	else
+		fprintf(file, "%s:\n", title);
+	fprintf(file, "%-20s %8s %10s %10s %10s %8s\n", "Robot", "turns",
+			"wall us", "CPU us", "max us", "over");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintRobotProfile
+//
+// Description: This function prints a robot's profile: its average and
+//              longest turn, the turns over budget, the histogram of turn
+//              lengths and the API calls it made, with the calls a turn.
+//              Empty buckets, calls never made and no dropped commands are
+//              left out.
+//
+// Parameters: FILE *file - Where to print.
+//             const char *name - The robot's name.
+//             ROBOT_PROFILE *profile - Its profile.  Robots that took no
+//                                      turns are skipped.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void PrintRobotProfile(FILE *file, const char *name, ROBOT_PROFILE *profile) {
+	char cpu[16], item[64];
+	int i, column;
+
+	if (profile->turns <= 0)
+		return;
+	if (profile->cpuTurns > 0)
+		sprintf(cpu, "%.1f", profile->cpuTime / 1000.0 / profile->cpuTurns);
+	else
+		strcpy(cpu, "-");
+	fprintf(file, "%-20.20s %8d %10.1f %10s %10.1f %8d%s\n", name,
+			profile->turns, GetMicrosPerTurn(profile), cpu,
+			profile->maxWallTime / 1000.0, profile->overBudget,
+			profile->overBudget > 0 ? "  OVER BUDGET" : "");
+
+	fprintf(file, "    turns by us:");
+	for (i = 0; i < ROBOT_TIME_BUCKETS; i++)
+		if (profile->histogram[i] > 0) {
+			if (i < ROBOT_TIME_BUCKETS - 1)
+				fprintf(file, " <%d:%d", 1 << i, profile->histogram[i]);
+			else
+				fprintf(file, " %d+:%d", 1 << (i - 1), profile->histogram[i]);
+		}
+	fprintf(file, "\n");
+
+	column = fprintf(file, "    calls:");
+	for (i = 0; i < NUM_ROBOT_CALLS; i++)
+		if (profile->calls[i] > 0) {
+			sprintf(item, " %s %d (%.2f)", callNames[i], profile->calls[i],
+					(double) profile->calls[i] / profile->turns);
+			if (column + (int) strlen(item) > REPORT_WIDTH)
+				column = fprintf(file, "\n          ");
+			column += fprintf(file, "%s", item);
+		}
+	fprintf(file, "\n");
+	if (profile->dropped > 0)
+		fprintf(file, "    dropped commands: %d\n", profile->dropped);
+}
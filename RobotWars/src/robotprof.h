@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: robotprof.h
+//
+// Description: This file contains the robot profiles, which say what each
+//              robot's code costs the match.  Every turn a robot takes (one
+//              call of its orders function) is timed by the wall clock and
+//              by the CPU time of the thread it ran on, and put in a
+//              histogram of turn lengths.  Each call it makes to the robot
+//              API is counted as well, so a slow robot can be told apart
+//              from one that simply asks for its sensors a hundred times a
+//              turn.  The order phase waits for the slowest robot, so a
+//              robot's wall time is what it costs everyone else; CPU time
+//              well below it means the robot was waiting or preempted.
+//
+//              A soft budget, set with SetOrderBudget(), is the most wall
+//              time a turn should take.  Turns over it are counted and
+//              flagged in the report, but nothing is done to the robot.
+//
+//              Profiling is always on, and costs two reads of the thread's
+//              CPU clock a turn and an add a call.  competition.c keeps a
+//              ROBOT_PROFILE for each robot, prints them to the file given
+//              to SetProfileReport() when a match ends, and gives them out
+//              with GetRobotProfile() (the fork server puts each robot's
+//              time in its results).  Only the thread giving a robot's
+//              orders, and then the main thread applying them, write its
+//              profile, so they are not locked.  A robot in a sandbox is
+//              timed from outside: it has no CPU time and its calls are
+//              made, and not counted, in the child.  Remote robots take no
+//              turns of their own.  Commands dropped because a robot gave
+//              too many in a turn are counted for every robot.
+//
+//              Note: like timing.c, robotprof.c must not include allegro.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef ROBOTPROF_HEADER
+#define ROBOTPROF_HEADER 1
+
+#include <stdio.h>
+
+#define ROBOT_TIME_BUCKETS  12   //Under 1us, under 2us, ... under 1024us, more.
+
+typedef enum {                   //The robot API, as counted.
+	RC_ADD_SENSOR,
+	RC_SET_MOTOR_SPEEDS,
+	RC_TURBO_BOOST,
+	RC_IS_TURBO_ON,
+	RC_GET_GPS_INFO,
+	RC_GET_SENSOR_DATA,
+	RC_SET_SENSOR_STATUS,
+	RC_FIRE_WEAPON,
+	RC_GET_SYSTEM_ENERGY,
+	RC_SET_CHARGE_RATE,
+	RC_SET_CHARGE_PRIORITIES,
+	RC_GET_BUMP_INFO,
+	RC_GET_GENERATOR_STRUCTURE,
+	RC_GET_GENERATOR_OUTPUT,
+	RC_SET_STATUS_MESSAGE,
+	RC_SEND_MESSAGE,
+	RC_GET_MESSAGE,
+	RC_GET_RANDOM_NUMBER,
+	NUM_ROBOT_CALLS
+} ROBOT_CALL;
+
+typedef struct {
+	int turns;
+	int cpuTurns;                //Turns with a CPU time.
+	int overBudget;              //Turns longer than the budget.
+	long long wallTime;          //Nanoseconds, over all the turns.
+	long long cpuTime;           //Over the cpuTurns.
+	long long maxWallTime;       //Of the longest turn.
+	int histogram[ROBOT_TIME_BUCKETS];     //Turns by wall time.
+	int calls[NUM_ROBOT_CALLS];  //Including those made during configuration.
+	int dropped;                 //Commands that didn't fit in a turn.
+} ROBOT_PROFILE;
+
+#define CountRobotCall_M(profile, call)  ((profile)->calls[call]++)
+
+void SetOrderBudget(int microseconds);
+int GetOrderBudget(void);
+void SetProfileReport(FILE *file);
+FILE *GetProfileReport(void);
+void AddRobotTurn(ROBOT_PROFILE *profile, long long wallTime,
+		long long cpuTime);
+void ClearRobotProfile(ROBOT_PROFILE *profile);
+double GetMicrosPerTurn(ROBOT_PROFILE *profile);
+void PrintProfileHeader(FILE *file, const char *title);
+void PrintRobotProfile(FILE *file, const char *name, ROBOT_PROFILE *profile);
+
+#endif
@@ -1,126 +1,376 @@
-////////////////////////////////////////////////////////////////////////////////
-//
-// File: rockemsockem.c
-//
-// Description: This is the main game file for Robot Wars.  It sets up the
-//              environment, registers the robots, and runs the game.
-//
-// Author: Capt. Mike LeSauvage
-//
-// Revision History: 6 Mar 2006 - Created
-//
-////////////////////////////////////////////////////////////////////////////////
-#include <stdlib.h>
-#include "competition.h"
-#include "..\robots\bender.h"                   //0
-#include "..\robots\maximilian.h"               //1
-#include "..\robots\6R4V3 D1663R.h"             //2
-#include "..\robots\capsule1337.h"              //3
-#include "..\robots\JR.h"               		//4
-#include "..\robots\Lopez.h"               		//5
-#include "..\robots\Teemo.h"					//6
-#include "..\robots\Juan.h"
-
-
-// Bender - Testbot with source code			ROBOT 0
-void BENDERBOT(ROBOTCOLORS color) {
-	RegisterRobot("Bender", color, &BenderActions, &PimpOutBender,
-			"resources\\images\\basic_robot.bmp", -1, -1, -1);
-}
-// Maximillian - Testbot with source code		ROBOT 1
-void MAXMILLIAN(ROBOTCOLORS color) {
-	RegisterRobot("Maximillian", color, &MaxWillCrushYou, &EquipMax,
-			"resources\\images\\artillery_small.bmp", -1, -1, -1);
-}
-// Teemo - Testbot with source code				ROBOT 2
-void TEEMO(ROBOTCOLORS color) {
-	RegisterRobot("Teemo", color, &TeemoActions, &TeemosEquipement,
-			"resources\\images\\teemo.bmp", -1, -1, -1);
-}
-
-//----------------------------------------- Pre-Compilled Robots -----------------
-
- // Grave Digger - Testbot with object code 	ROBOT 3
- void GRAVEDIGGER(ROBOTCOLORS color) {
- RegisterRobot("6R4V3 DI663R", color, &GraveDiggerActions,
- &GraveDiggerSkillz, "resources\\images\\grave_digger.bmp", -1, -1,
- -1);
- }
-
-
- // Capsule1337 - Testbot with object code		ROBOT 4
- void CAPSULE(ROBOTCOLORS color) {
- RegisterRobot("capsule1337", color, &capsule1337_AI, &capsule1337_SETUP,
- "resources\\images\\capsule1337.bmp", -1, -1, -1);
- }
-
-
-// JR - Testbot with object code				ROBOT 5
-void JR(ROBOTCOLORS color) {
-RegisterRobot("JR", color, &JRActions, &KitOut,
-"resources\\images\\Coke.bmp", -1, -1, -1);
-}
-
-
-// Lopez - Testbot with object code			ROBOT 6
-void LOPEZ(ROBOTCOLORS color) {
-RegisterRobot("Lopez", color, &LopezActions, &PimpOutLopez,
-"resources\\images\\benny_lek.bmp", -1, -1, -1);
-}
-
-void JUAN(ROBOTCOLORS color) {
-    RegisterRobot("Juan", color, &juan_actions, &juan_setup,
-                  "resources\\images\\benny_lek.bmp", -1, -1, -1);
-}
-
-//----------------------------------------------------------------------------
-
-typedef void (*fpRegister)(ROBOTCOLORS);
-
-//typedef void (*)(ROBOTCOLORS) fpREG;                  
-fpRegister fpREG[] = { &BENDERBOT, &MAXMILLIAN, &TEEMO
-		,&GRAVEDIGGER, &CAPSULE, &JR, &LOPEZ, &JUAN 	// Pre-compilled robots
-		};
-
-int registeredRobots[4];
-int numInCompetition = 0;
-
-void ProcessCommandLine(int argc, char **argv);
-//   ROBOT_RED, ROBOT_GREEN, ROBOT_BLUE, ROBOT_YELLOW,
-// ROBOT_PURPLE, ROBOT_TURQUOISE, ROBOT_WHITE
-
-int main(int argc, char *argv[]) {
-	ROBOTCOLORS colours[4] = { ROBOT_RED, ROBOT_GREEN, ROBOT_YELLOW,
-			ROBOT_PURPLE };
-	int cnt;
-
-	ProcessCommandLine(argc, argv);
-	InitCompetition();
-
-	for (cnt = 0; cnt < numInCompetition; cnt++) {
-		(*fpREG[registeredRobots[cnt]])(colours[cnt]);
-	}
-
-	Fight();
-	EndCompetition();
-
-	return EXIT_SUCCESS;
-}
-END_OF_MAIN()          //Macro required for Allegro graphics library in Windows.
-
-void ProcessCommandLine(int argc, char *argv[]) {
-	int cnt;
-
-	if (argc <= 1) {
-		AbortOnError("No Robot Registers on command line\nProgram will exit.");
-	}
-
-	if (argc > 5) {
-		AbortOnError("More then 4 robots registered\nProgram will exit.");
-	}
-
-	for (cnt = 1; cnt < argc; cnt++) {
-		sscanf(argv[cnt], "%d", &registeredRobots[cnt - 1]);
-		numInCompetition++;
-	}
-}
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: rockemsockem.c
+//
+// Description: This is the main game file for Robot Wars.  It sets up the
+//              environment, registers the robots, and runs the game.
+//
+// Author: Capt. Mike LeSauvage
+//
+// Revision History: 6 Mar 2006 - Created
+//                  18 Oct 2026 - A command line argument of the form
+//                                name@socket registers a remote robot whose
+//                                brain listens on the given Unix socket.
+//                  18 Oct 2026 - Robot plugins are loaded from PLUGIN_DIR and
+//                                numbered after the robots in fpREG[].
+//                  18 Oct 2026 - --serve [children] runs the fork server on
+//                                the job file given on stdin (see
+//                                forkserver.h).  Robots are registered by
+//                                RegisterEntrant() for both modes.
+//                  18 Oct 2026 - --record file before the robots records the
+//                                match.  --serve takes a directory to record
+//                                every match in after the number of children.
+//                  18 Oct 2026 - --replay file plays back a recording.
+//                  18 Oct 2026 - --log file before the robots logs the
+//                                commands applied to them (with or without
+//                                --record).  --resim file [runs] plays the
+//                                log back headless, timing it and checking
+//                                the result against the log's.
+//                  18 Oct 2026 - --checksum file before the robots writes
+//                                the state checksums.  --resim takes a
+//                                checksum file after the number of runs.
+//                  18 Oct 2026 - The stress robots (see stress.c) follow the
+//                                bundled robots in fpREG[], and a robot given
+//                                as number:percent registers a stress robot
+//                                at that intensity.
+//                  18 Oct 2026 - --trace file before the robots writes a
+//                                Chrome trace of the match (see trace.h).
+//                  18 Oct 2026 - --counters first turns on the hardware
+//                                counters (see perfcount.h), for a match or
+//                                --resim.
+//                  18 Oct 2026 - --memstats first reports the memory accounts
+//                                (see memstats.h) at the end.
+//                  18 Oct 2026 - --profile first prints each robot's turn
+//                                times and API calls when the match ends
+//                                (see robotprof.h).  --budget us sets the
+//                                order budget they are checked against,
+//                                here and in the fork server's results.
+//                  18 Oct 2026 - The fork server reloads rebuilt plugins
+//                                before each match, with ReloadPlugins().
+//                  18 Oct 2026 - --latency ticks first sets the remote
+//                                robots' latency (see SetRemoteLatency()).
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "competition.h"
+#include "plugins.h"
+#include "forkserver.h"
+#include "replay.h"
+#include "cmdlog.h"
+#include "trace.h"
+#include "perfcount.h"
+#include "memstats.h"
+#include "remote.h"
+#include "..\robots\bender.h"                   //0
+#include "..\robots\maximilian.h"               //1
+#include "..\robots\6R4V3 D1663R.h"             //2
+#include "..\robots\capsule1337.h"              //3
+#include "..\robots\JR.h"               		//4
+#include "..\robots\Lopez.h"               		//5
+#include "..\robots\Teemo.h"					//6
+#include "..\robots\Juan.h"
+#include "..\robots\stress.h"
+
+
+// Bender - Testbot with source code			ROBOT 0
+void BENDERBOT(ROBOTCOLORS color) {
+	RegisterRobot("Bender", color, &BenderActions, &PimpOutBender,
+			"resources\\images\\basic_robot.bmp", -1, -1, -1);
+}
+// Maximillian - Testbot with source code		ROBOT 1
+void MAXMILLIAN(ROBOTCOLORS color) {
+	RegisterRobot("Maximillian", color, &MaxWillCrushYou, &EquipMax,
+			"resources\\images\\artillery_small.bmp", -1, -1, -1);
+}
+// Teemo - Testbot with source code				ROBOT 2
+void TEEMO(ROBOTCOLORS color) {
+	RegisterRobot("Teemo", color, &TeemoActions, &TeemosEquipement,
+			"resources\\images\\teemo.bmp", -1, -1, -1);
+}
+
+//----------------------------------------- Pre-Compilled Robots -----------------
+
+ // Grave Digger - Testbot with object code 	ROBOT 3
+ void GRAVEDIGGER(ROBOTCOLORS color) {
+ RegisterRobot("6R4V3 DI663R", color, &GraveDiggerActions,
+ &GraveDiggerSkillz, "resources\\images\\grave_digger.bmp", -1, -1,
+ -1);
+ }
+
+
+ // Capsule1337 - Testbot with object code		ROBOT 4
+ void CAPSULE(ROBOTCOLORS color) {
+ RegisterRobot("capsule1337", color, &capsule1337_AI, &capsule1337_SETUP,
+ "resources\\images\\capsule1337.bmp", -1, -1, -1);
+ }
+
+
+// JR - Testbot with object code				ROBOT 5
+void JR(ROBOTCOLORS color) {
+RegisterRobot("JR", color, &JRActions, &KitOut,
+"resources\\images\\Coke.bmp", -1, -1, -1);
+}
+
+
+// Lopez - Testbot with object code			ROBOT 6
+void LOPEZ(ROBOTCOLORS color) {
+RegisterRobot("Lopez", color, &LopezActions, &PimpOutLopez,
+"resources\\images\\benny_lek.bmp", -1, -1, -1);
+}
+
+void JUAN(ROBOTCOLORS color) {
+    RegisterRobot("Juan", color, &juan_actions, &juan_setup,
+                  "resources\\images\\benny_lek.bmp", -1, -1, -1);
+}
+
+//----------------------------------------- Stress Robots ----------------------
+
+void STRESSLASER(ROBOTCOLORS color) {
+	RegisterRobot("Stress Laser", color, &StressLaserActions,
+			&EquipStressLaser, "resources\\images\\basic_robot.bmp", -1, -1,
+			-1);
+}
+
+void STRESSSPIN(ROBOTCOLORS color) {
+	RegisterRobot("Stress Spin", color, &StressSpinActions, &EquipStressSpin,
+			"resources\\images\\basic_robot.bmp", -1, -1, -1);
+}
+
+void STRESSRAM(ROBOTCOLORS color) {
+	RegisterRobot("Stress Ram", color, &StressRamActions, &EquipStressRam,
+			"resources\\images\\basic_robot.bmp", -1, -1, -1);
+}
+
+void STRESSMAIL(ROBOTCOLORS color) {
+	RegisterRobot("Stress Mail", color, &StressMailActions, &EquipStressMail,
+			"resources\\images\\basic_robot.bmp", -1, -1, -1);
+}
+
+//----------------------------------------------------------------------------
+
+typedef void (*fpRegister)(ROBOTCOLORS);
+
+//typedef void (*)(ROBOTCOLORS) fpREG;                  
+fpRegister fpREG[] = { &BENDERBOT, &MAXMILLIAN, &TEEMO
+		,&GRAVEDIGGER, &CAPSULE, &JR, &LOPEZ, &JUAN 	// Pre-compilled robots
+		,&STRESSLASER, &STRESSSPIN, &STRESSRAM, &STRESSMAIL  //In STRESS_ROBOT
+		};                                                    //order, last.
+#define NUM_BUILT_IN  (int) (sizeof(fpREG) / sizeof(fpREG[0]))
+#define FIRST_STRESS  (NUM_BUILT_IN - NUM_STRESS_ROBOTS)
+
+char *entrants[4];               //Robots as given on the command line.
+int numInCompetition = 0;
+char *recordFile = NULL;         //--record file, or NULL.
+char *logFile = NULL;            //--log file, or NULL.
+char *checksumFile = NULL;       //--checksum file, or NULL.
+char *traceFile = NULL;          //--trace file, or NULL.
+int countHardware = 0;           //1 with --counters.
+
+//   ROBOT_RED, ROBOT_GREEN, ROBOT_BLUE, ROBOT_YELLOW,
+// ROBOT_PURPLE, ROBOT_TURQUOISE, ROBOT_WHITE
+ROBOTCOLORS colours[4] = { ROBOT_RED, ROBOT_GREEN, ROBOT_YELLOW,
+		ROBOT_PURPLE };
+
+void ProcessCommandLine(int argc, char **argv);
+void RegisterEntrant(char *entrant, int slot);
+int Resimulate(char *fileName, int runs, char *checksumFile);
+void StartCounting(void);
+void ReloadPlugins(void);
+
+int main(int argc, char *argv[]) {
+	int cnt;
+	REPLAY *replay;
+
+	while (argc > 1 && (strcmp(argv[1], "--counters") == 0
+			|| strcmp(argv[1], "--memstats") == 0
+			|| strcmp(argv[1], "--profile") == 0
+			|| (argc > 2 && strcmp(argv[1], "--budget") == 0)
+			|| (argc > 2 && strcmp(argv[1], "--latency") == 0))) {
+		if (strcmp(argv[1], "--counters") == 0)
+			countHardware = 1;
+		else if (strcmp(argv[1], "--memstats") == 0)
+			SetMemReport(stdout);
+		else if (strcmp(argv[1], "--profile") == 0)
+			SetProfileReport(stdout);
+		else {
+			if (strcmp(argv[1], "--budget") == 0)
+				SetOrderBudget(atoi(argv[2]));
+			else
+				SetRemoteLatency(atoi(argv[2]));
+			argc--;
+			argv++;
+		}
+		argc--;                          //The rest of the command line is
+		argv++;                          //as without them.
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+		SetHeadless();                   //Batch of matches from the job file
+		InitCompetition();               //on stdin, results on stdout.
+		LoadPlugins(PLUGIN_DIR);
+		RunForkServer(stdin, stdout, argc > 2 ? atoi(argv[2]) : 0,
+				argc > 3 ? argv[3] : NULL, RegisterEntrant, ReloadPlugins);
+		EndCompetition();
+		UnloadPlugins();
+		return EXIT_SUCCESS;
+	}
+
+	if (argc == 3 && strcmp(argv[1], "--replay") == 0) {
+		InitCompetition();               //Shown without any robot code.
+		replay = OpenReplay(argv[2]);
+		if (replay == NULL)
+			AbortOnError("Could not open the recording.\nProgram will exit.");
+		PlayReplay(replay);
+		CloseReplay(replay);
+		EndCompetition();
+		return EXIT_SUCCESS;
+	}
+
+	if (argc >= 3 && argc <= 5 && strcmp(argv[1], "--resim") == 0) {
+		SetHeadless();                   //A logged match, without the
+		InitCompetition();               //robots' code, as fast as it goes.
+		StartCounting();
+		return Resimulate(argv[2], argc > 3 ? atoi(argv[3]) : 1,
+				argc > 4 ? argv[4] : NULL);
+	}
+
+	ProcessCommandLine(argc, argv);
+	InitCompetition();
+	LoadPlugins(PLUGIN_DIR);
+
+	for (cnt = 0; cnt < numInCompetition; cnt++)
+		RegisterEntrant(entrants[cnt], cnt);
+	if (recordFile != NULL && !RecordMatch(recordFile))
+		AbortOnError("Could not create the recording file.\nProgram will exit.");
+	if (logFile != NULL && !LogMatchCommands(logFile))
+		AbortOnError("Could not create the command log.\nProgram will exit.");
+	if (checksumFile != NULL && !ChecksumMatch(checksumFile))
+		AbortOnError("Could not create the checksum file.\nProgram will exit.");
+	if (traceFile != NULL && !StartTrace(traceFile))
+		AbortOnError("Could not create the trace file.\nProgram will exit.");
+	StartCounting();
+
+	Fight();
+	EndCompetition();
+	UnloadPlugins();
+
+	return EXIT_SUCCESS;
+}
+END_OF_MAIN()          //Macro required for Allegro graphics library in Windows.
+
+void ProcessCommandLine(int argc, char *argv[]) {
+	int cnt = 1;
+
+	while (argc > cnt + 1 && (strcmp(argv[cnt], "--record") == 0
+			|| strcmp(argv[cnt], "--log") == 0
+			|| strcmp(argv[cnt], "--checksum") == 0
+			|| strcmp(argv[cnt], "--trace") == 0)) {
+		if (strcmp(argv[cnt], "--record") == 0)
+			recordFile = argv[cnt + 1];
+		else if (strcmp(argv[cnt], "--log") == 0)
+			logFile = argv[cnt + 1];
+		else if (strcmp(argv[cnt], "--trace") == 0)
+			traceFile = argv[cnt + 1];
+		else
+			checksumFile = argv[cnt + 1];
+		cnt += 2;
+	}
+
+	if (argc <= cnt) {
+		AbortOnError("No Robot Registers on command line\nProgram will exit.");
+	}
+
+	if (argc > cnt + 4) {
+		AbortOnError("More then 4 robots registered\nProgram will exit.");
+	}
+
+	for (; cnt < argc; cnt++)
+		entrants[numInCompetition++] = argv[cnt];
+}
+
+void RegisterEntrant(char *entrant, int slot) {
+	char *socketPath = strchr(entrant, '@');
+	int robot = 0, intensity;
+
+	if (socketPath != NULL) {                       //name@socket: a remote
+		*socketPath++ = '\0';                       //robot.
+		RegisterRemoteRobot(entrant, colours[slot], socketPath);
+		return;
+	}
+
+	if (sscanf(entrant, "%d:%d", &robot, &intensity) == 2
+			&& robot >= FIRST_STRESS && robot < NUM_BUILT_IN)
+		SetStressIntensity(robot - FIRST_STRESS, intensity);
+	if (robot >= NUM_BUILT_IN)                      //Plugins follow the
+		RegisterPluginRobot(robot - NUM_BUILT_IN, colours[slot]); //compiled-
+	else                                                        //in robots.
+		(*fpREG[robot])(colours[slot]);
+}
+
+int Resimulate(char *fileName, int runs, char *checksumFile) {
+	COMMAND_LOG *log;
+	MATCH_RESULT logged, result;
+	clock_t start, ticks = 0;
+	int run, i, calcs = 0, ended, same = 1;
+
+	log = OpenCommandLog(fileName);
+	if (log == NULL || !ResimulateMatch(fileName))
+		AbortOnError("Could not read the command log.\nProgram will exit.");
+	ended = GetLoggedResult(log, &logged);
+	CloseCommandLog(log);
+
+	for (run = 0; run < runs; run++) {
+		if (run > 0)
+			ResetMatch(0);                     //The same match again.
+		if (run == 0 && checksumFile != NULL && !ChecksumMatch(checksumFile))
+			AbortOnError("Could not create the checksum file.\n"
+					"Program will exit.");
+		start = clock();
+		RunMatch(&result);
+		ticks += clock() - start;
+		calcs += result.calcs;
+
+		if (ended && (result.end != logged.end || result.calcs != logged.calcs
+				|| result.winner != logged.winner))
+			same = 0;
+		for (i = 0; ended && i < result.numRobots; i++)
+			if (result.alive[i] != logged.alive[i]
+					|| result.shields[i] != logged.shields[i]
+					|| result.generatorStructure[i]
+							!= logged.generatorStructure[i])
+				same = 0;
+	}
+
+	printf("%d calculations in %.3f s, %.0f a second.\n", calcs,
+			(double) ticks / CLOCKS_PER_SEC,
+			ticks > 0 ? calcs * (double) CLOCKS_PER_SEC / ticks : 0.0);
+	if (!ended)
+		printf("The log has no result to check against.\n");
+	else
+		printf("The result %s the logged one.\n",
+				same ? "matches" : "differs from");
+	EndCompetition();
+	return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void StartCounting(void) {
+	if (countHardware && !StartPerfCounters())
+		AbortOnError("The hardware counters are not available.  They need "
+				"Linux, a CPU\nthat counts cycles, and perf_event_paranoid "
+				"at most 2.\nProgram will exit.");
+}
+
+void ReloadPlugins(void) {
+	char message[100];
+	int failed;
+
+	ReloadChangedPlugins(&failed);
+	if (failed > 0) {
+		sprintf(message, "%d plugin(s) could not be reloaded.\n"
+				"The old versions will be used.", failed);
+		allegro_message(message);
+	}
+}
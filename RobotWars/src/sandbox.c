@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: sandbox.c
+//
+// Description: This file runs robots' orders functions in child processes so
+//              a robot that hangs, crashes or calls AbortOnError() only stops
+//              itself, not the competition.
+//
+//              Each robot gets a block of shared memory holding its
+//              ROBOT_VIEW, COMMAND_BUFFER (with a fixed store of
+//              SANDBOX_MESSAGES messages, as the child can't allocate) and
+//              random number state, and a pair of pipes.  Each turn the engine copies the view into the
+//              block and writes one byte to the child.  The child gives its
+//              orders against the view, copies the results back and writes
+//              one byte in reply.  The engine waits at most SANDBOX_TURN_MS
+//              for that reply.
+//
+//              The child is forked from the engine once every robot has been
+//              registered, so it already holds the robot and its statics.
+//              Before its first turn it:
+//                - closes every file it inherited except its two pipes,
+//                - sets RLIMIT_CPU to SANDBOX_CPU_SECS as a backstop for the
+//                  whole match,
+//                - asks to be killed if the engine dies, and
+//                - enters seccomp strict mode, which only allows read(),
+//                  write(), exit() and sigreturn().  Anything else (opening
+//                  files, allocating memory, exit_group() from exit()) kills
+//                  it.
+//
+//              A robot that misses its deadline or dies is killed and gives
+//              no further orders.  Its treads are stopped.  So is one that
+//              leaves impossible counts in its command buffer; nothing else
+//              in the buffer but the commands themselves is trusted.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Messages sent have a store of their own.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "sandbox.h"
+
+#ifdef __linux__
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <linux/seccomp.h>
+
+typedef struct {                     //Memory shared with the child.
+	ROBOT_VIEW view;
+	COMMAND_BUFFER orders;
+	SENT_MESSAGE messages[SANDBOX_MESSAGES];  //The child's message store.
+	unsigned int randomState;
+} SANDBOX_SHARED;
+
+struct SANDBOX_TAG {
+	pid_t pid;
+	int toChild;                     //Write end of the engine->child pipe.
+	int fromChild;                   //Read end of the child->engine pipe.
+	int failed;                      //Set once the child has been stopped.
+	SANDBOX_SHARED *shared;
+};
+
+//Internal helper prototypes
+static void SandboxMain(SANDBOX *sandbox, int readFd, int writeFd,
+		ROBOT *robot, void (*giveOrders)(ROBOT *));
+static void FailSandbox(SANDBOX *sandbox, ROBOT *robot);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartSandbox
+//
+// Description: This function creates the shared memory and pipes for a robot
+//              and forks the child process that will give its orders.
+//
+// Parameters: ROBOT *robot - The robot to run in the sandbox.
+//             giveOrders - Called in the child to run the robot's orders
+//                          function against robot->view.
+//
+// Returns: SANDBOX* - The sandbox, or NULL if it couldn't be created, in
+//                     which case the robot gives its orders in-process.
+//
+////////////////////////////////////////////////////////////////////////////////
+SANDBOX *StartSandbox(ROBOT *robot, void (*giveOrders)(ROBOT *)) {
+	SANDBOX *sandbox;
+	int toChild[2], fromChild[2];
+
+	sandbox = malloc(sizeof(SANDBOX));
+	if (sandbox == NULL)
+		return NULL;
+	sandbox->shared = mmap(NULL, sizeof(SANDBOX_SHARED),
+			PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sandbox->shared == MAP_FAILED) {
+		free(sandbox);
+		return NULL;
+	}
+	if (pipe(toChild) != 0) {
+		munmap(sandbox->shared, sizeof(SANDBOX_SHARED));
+		free(sandbox);
+		return NULL;
+	}
+	if (pipe(fromChild) != 0) {
+		close(toChild[0]);
+		close(toChild[1]);
+		munmap(sandbox->shared, sizeof(SANDBOX_SHARED));
+		free(sandbox);
+		return NULL;
+	}
+
+	signal(SIGPIPE, SIG_IGN);        //A dead child must not kill the engine.
+
+	sandbox->pid = fork();
+	if (sandbox->pid == 0)
+		SandboxMain(sandbox, toChild[0], fromChild[1], robot, giveOrders);
+
+	close(toChild[0]);
+	close(fromChild[1]);
+	sandbox->toChild = toChild[1];
+	sandbox->fromChild = fromChild[0];
+	sandbox->failed = 0;
+	if (sandbox->pid < 0) {
+		close(toChild[1]);
+		close(fromChild[0]);
+		munmap(sandbox->shared, sizeof(SANDBOX_SHARED));
+		free(sandbox);
+		return NULL;
+	}
+	return sandbox;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunSandboxTurn
+//
+// Description: This function has the child give the robot's orders.  The
+//              robot's view must already have been taken.  On return the
+//              robot's command buffer (copied into its own store), view and
+//              random state hold what the child left in them.
+//
+// Parameters: SANDBOX *sandbox - The robot's sandbox.
+//             ROBOT *robot - The robot.
+//
+// Returns: int - 1 if the child gave its orders in time, 0 if it has failed
+//                (now or on an earlier turn).
+//
+////////////////////////////////////////////////////////////////////////////////
+int RunSandboxTurn(SANDBOX *sandbox, ROBOT *robot) {
+	SANDBOX_SHARED *shared = sandbox->shared;
+	struct pollfd reply;
+	char token = 0;
+
+	if (sandbox->failed) {
+		FailSandbox(sandbox, robot);
+		return 0;
+	}
+
+	shared->view = robot->view;
+	shared->randomState = robot->randomState;
+	if (write(sandbox->toChild, &token, 1) != 1) {
+		FailSandbox(sandbox, robot);
+		return 0;
+	}
+
+	reply.fd = sandbox->fromChild;
+	reply.events = POLLIN;
+	if (poll(&reply, 1, SANDBOX_TURN_MS) != 1
+			|| read(sandbox->fromChild, &token, 1) != 1) {
+		FailSandbox(sandbox, robot);          //Timed out, or the child died.
+		return 0;
+	}
+
+	shared->orders.messages = shared->messages;  //Not the child's pointer.
+	if (shared->orders.count < 0 || shared->orders.count > MAX_COMMANDS
+			|| shared->orders.dropped < 0
+			|| shared->orders.messageCount < 0
+			|| shared->orders.messageCount > SANDBOX_MESSAGES) {
+		FailSandbox(sandbox, robot);
+		return 0;
+	}
+	robot->view = shared->view;
+	CopyOrders(&robot->orders, &shared->orders);
+	robot->randomState = shared->randomState;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopSandbox
+//
+// Description: This function ends the child process and frees the sandbox.
+//
+// Parameters: SANDBOX *sandbox - The sandbox to stop.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void StopSandbox(SANDBOX *sandbox) {
+	if (!sandbox->failed) {
+		kill(sandbox->pid, SIGKILL);
+		waitpid(sandbox->pid, NULL, 0);
+	}
+	close(sandbox->toChild);
+	close(sandbox->fromChild);
+	munmap(sandbox->shared, sizeof(SANDBOX_SHARED));
+	free(sandbox);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SandboxMain
+//
+// Description: This is the child process.  It locks itself down and then
+//              gives the robot's orders each time the engine asks.  It never
+//              returns.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SandboxMain(SANDBOX *sandbox, int readFd, int writeFd,
+		ROBOT *robot, void (*giveOrders)(ROBOT *)) {
+	SANDBOX_SHARED *shared = sandbox->shared;
+	struct rlimit limit;
+	long fd, maxFd;
+	char token;
+
+	maxFd = sysconf(_SC_OPEN_MAX);
+	if (maxFd < 0 || maxFd > 65536)
+		maxFd = 65536;
+	for (fd = 3; fd < maxFd; fd++)          //Keep stdio for error messages.
+		if (fd != readFd && fd != writeFd)
+			close(fd);
+
+	limit.rlim_cur = SANDBOX_CPU_SECS;
+	limit.rlim_max = SANDBOX_CPU_SECS + 1;
+	setrlimit(RLIMIT_CPU, &limit);
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+	if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT) != 0)
+		syscall(SYS_exit, 1);       //No sandbox: fail the robot rather than
+	                                //run it unprotected.
+	InitOrders(&robot->orders, shared->messages, SANDBOX_MESSAGES);
+	while (read(readFd, &token, 1) == 1) {
+		robot->view = shared->view;
+		robot->randomState = shared->randomState;
+		ClearOrders(&robot->orders);
+		giveOrders(robot);
+		shared->view = robot->view;
+		shared->orders = robot->orders;
+		shared->randomState = robot->randomState;
+		if (write(writeFd, &token, 1) != 1)
+			break;
+	}
+	syscall(SYS_exit, 0);           //exit() would call exit_group().
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FailSandbox
+//
+// Description: This function kills a child that missed its deadline or died,
+//              and replaces the robot's orders with stopping its treads.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void FailSandbox(SANDBOX *sandbox, ROBOT *robot) {
+	if (!sandbox->failed) {
+		kill(sandbox->pid, SIGKILL);
+		waitpid(sandbox->pid, NULL, 0);
+		sandbox->failed = 1;
+	}
+
+	ClearOrders(&robot->orders);
+	robot->orders.count = 1;
+	robot->orders.commands[0].type = CMD_MOTOR_SPEEDS;
+	robot->orders.commands[0].args[0] = 0;
+	robot->orders.commands[0].args[1] = 0;
+}
+
+#else
+
+SANDBOX *StartSandbox(ROBOT *robot, void (*giveOrders)(ROBOT *)) {
+	return NULL;                     //Not supported: give orders in-process.
+}
+
+int RunSandboxTurn(SANDBOX *sandbox, ROBOT *robot) {
+	return 0;
+}
+
+void StopSandbox(SANDBOX *sandbox) {
+}
+
+#endif
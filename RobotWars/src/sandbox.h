@@ -0,0 +1,22 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: sandbox.h
+//
+// Description: This file contains the functions that run a robot's orders
+//              function in a child process.  Only Linux is supported; on
+//              other platforms StartSandbox() returns NULL and the robot
+//              simply gives its orders in-process as before.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef SANDBOX_HEADER
+#define SANDBOX_HEADER 1
+
+#include "competition.h"
+
+SANDBOX *StartSandbox(ROBOT *robot, void (*giveOrders)(ROBOT *));
+int RunSandboxTurn(SANDBOX *sandbox, ROBOT *robot);
+void StopSandbox(SANDBOX *sandbox);
+
+#endif
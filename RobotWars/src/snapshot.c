@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: snapshot.c
+//
+// Description: This file implements the snapshot buffer described in
+//              snapshot.h.  Writes append to the buffer, growing it when
+//              needed; reads move through it from the start.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+
+void AbortOnError(char *message);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: InitSnapshot / FreeSnapshot / ClearSnapshot
+//
+// Description: A snapshot starts empty.  ClearSnapshot() empties it for the
+//              next save but keeps its memory; FreeSnapshot() releases it.
+//
+////////////////////////////////////////////////////////////////////////////////
+void InitSnapshot(SNAPSHOT *snapshot) {
+	snapshot->data = NULL;
+	snapshot->size = snapshot->capacity = snapshot->position = 0;
+}
+
+void FreeSnapshot(SNAPSHOT *snapshot) {
+	free(snapshot->data);
+	InitSnapshot(snapshot);
+}
+
+void ClearSnapshot(SNAPSHOT *snapshot) {
+	snapshot->size = snapshot->position = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReserveSnapshot
+//
+// Description: This function adds length bytes to the end of the snapshot
+//              for the caller to fill in place.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being written.
+//             int length - Number of bytes.
+//
+// Returns: void* - Where to write them.
+//
+////////////////////////////////////////////////////////////////////////////////
+void *ReserveSnapshot(SNAPSHOT *snapshot, int length) {
+	char *data;
+	int needed = snapshot->size + length;
+
+	if (needed > snapshot->capacity) {
+		data = realloc(snapshot->data, needed * 2);
+		if (data == NULL)
+			AbortOnError("ReserveSnapshot() could not grow a snapshot.\n"
+					"Program will end.");
+		snapshot->data = data;
+		snapshot->capacity = needed * 2;
+	}
+	data = snapshot->data + snapshot->size;
+	snapshot->size = needed;
+	return data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: WriteSnapshot
+//
+// Description: This function appends bytes to the snapshot.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being written.
+//             const void *data - The bytes.
+//             int length - Number of bytes.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void WriteSnapshot(SNAPSHOT *snapshot, const void *data, int length) {
+	memcpy(ReserveSnapshot(snapshot, length), data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadSnapshot
+//
+// Description: This function reads the next bytes of the snapshot.
+//
+// Parameters: SNAPSHOT *snapshot - The snapshot being read.
+//             void *data - Where to copy the bytes, or NULL to only skip
+//                          over them.
+//             int length - Number of bytes.
+//
+// Returns: void* - The bytes within the snapshot, or NULL if it is too short.
+//
+////////////////////////////////////////////////////////////////////////////////
+void *ReadSnapshot(SNAPSHOT *snapshot, void *data, int length) {
+	char *bytes;
+
+	if (length < 0 || snapshot->position + length > snapshot->size)
+		return NULL;
+	bytes = snapshot->data + snapshot->position;
+	snapshot->position += length;
+	if (data != NULL)
+		memcpy(data, bytes, length);
+	return bytes;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SaveSnapshotFile / LoadSnapshotFile
+//
+// Description: These functions write a snapshot to a file and read it back,
+//              so a moment of interest can be restored in another process.
+//
+// Returns: int - 1 if successful, 0 otherwise.
+//
+////////////////////////////////////////////////////////////////////////////////
+int SaveSnapshotFile(SNAPSHOT *snapshot, char *fileName) {
+	FILE *file = fopen(fileName, "wb");
+	int success;
+
+	if (file == NULL)
+		return 0;
+	success = fwrite(snapshot->data, 1, snapshot->size, file)
+			== (size_t) snapshot->size;
+	return fclose(file) == 0 && success;
+}
+
+int LoadSnapshotFile(SNAPSHOT *snapshot, char *fileName) {
+	FILE *file = fopen(fileName, "rb");
+	long length;
+	int success;
+
+	if (file == NULL)
+		return 0;
+	fseek(file, 0, SEEK_END);
+	length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	ClearSnapshot(snapshot);
+	success = length >= 0 && fread(ReserveSnapshot(snapshot, length), 1,
+			length, file) == (size_t) length;
+	fclose(file);
+	return success;
+}
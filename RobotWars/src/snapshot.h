@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: snapshot.h
+//
+// Description: This file contains the buffer that match snapshots are built
+//              in.  SaveMatch() in competition.c fills a SNAPSHOT with the
+//              complete state of the match and RestoreMatch() puts it back,
+//              so analysis tools can branch many what-if runs from one tick.
+//
+//              A snapshot is a flat binary blob in host byte order, only
+//              meant to be restored by the same build with the same robots
+//              registered.  The buffer keeps its capacity between saves, so
+//              after the first few no allocation is done.
+//
+//              Robots built as plugins may opt in to having their statics
+//              saved too; see ROBOT_PLUGIN in plugins.h.  Statics of robots
+//              linked into the game, and the state of remote robots' brains,
+//              are not saved.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - Version 2 saves the tick of the last damage
+//                                or shot, for stalemate detection.
+//                  18 Oct 2026 - Version 3 saves the next weapon id.
+//                  18 Oct 2026 - Version 4 saves robots' messages apart from
+//                                their commands, and the commands dropped.
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef SNAPSHOT_HEADER
+#define SNAPSHOT_HEADER 1
+
+#define SNAPSHOT_MAGIC    0x4E535752   //"RWSN"
+#define SNAPSHOT_VERSION  4
+
+typedef struct {
+	char *data;
+	int size;                     //Bytes written.
+	int capacity;
+	int position;                 //Next byte to read.
+} SNAPSHOT;
+
+void InitSnapshot(SNAPSHOT *snapshot);
+void FreeSnapshot(SNAPSHOT *snapshot);
+void ClearSnapshot(SNAPSHOT *snapshot);
+void *ReserveSnapshot(SNAPSHOT *snapshot, int length);
+void WriteSnapshot(SNAPSHOT *snapshot, const void *data, int length);
+void *ReadSnapshot(SNAPSHOT *snapshot, void *data, int length);
+int SaveSnapshotFile(SNAPSHOT *snapshot, char *fileName);
+int LoadSnapshotFile(SNAPSHOT *snapshot, char *fileName);
+
+#endif
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: threads.c
+//
+// Description: This file implements the portable thread layer described in
+//              threads.h.  The Win32 section is used by the MinGW build; the
+//              POSIX section by everything else.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include "threads.h"
+
+//competition.h can't be included here (see threads.h), so the one function
+//needed from it is declared directly.
+void AbortOnError(char *message);
+
+#ifdef _WIN32
+#include <windows.h>
+
+struct THREAD_TAG {
+	HANDLE handle;
+	void (*threadFunc)(void *);
+	void *data;
+};
+
+struct MUTEX_TAG {
+	CRITICAL_SECTION section;
+};
+
+struct SEMAPHORE_TAG {
+	HANDLE handle;
+};
+
+static DWORD WINAPI ThreadEntry(LPVOID param) {
+	THREAD *thread = param;
+	thread->threadFunc(thread->data);
+	return 0;
+}
+
+THREAD *StartThread(void (*threadFunc)(void *), void *data) {
+	THREAD *thread = malloc(sizeof(THREAD));
+
+	if (thread == NULL)
+		AbortOnError("StartThread() could not allocate a thread.\n"
+				"Program will end.");
+	thread->threadFunc = threadFunc;
+	thread->data = data;
+	thread->handle = CreateThread(NULL, 0, ThreadEntry, thread, 0, NULL);
+	if (thread->handle == NULL)
+		AbortOnError("StartThread() failed to create a thread.\n"
+				"Program will end.");
+	return thread;
+}
+
+void JoinThread(THREAD *thread) {
+	WaitForSingleObject(thread->handle, INFINITE);
+	CloseHandle(thread->handle);
+	free(thread);
+}
+
+MUTEX *NewMutex(void) {
+	MUTEX *mutex = malloc(sizeof(MUTEX));
+
+	if (mutex == NULL)
+		AbortOnError("NewMutex() could not allocate a mutex.\n"
+				"Program will end.");
+	InitializeCriticalSection(&mutex->section);
+	return mutex;
+}
+
+void LockMutex(MUTEX *mutex) {
+	EnterCriticalSection(&mutex->section);
+}
+
+void UnlockMutex(MUTEX *mutex) {
+	LeaveCriticalSection(&mutex->section);
+}
+
+void FreeMutex(MUTEX *mutex) {
+	DeleteCriticalSection(&mutex->section);
+	free(mutex);
+}
+
+SEMAPHORE *NewSemaphore(int count) {
+	SEMAPHORE *semaphore = malloc(sizeof(SEMAPHORE));
+
+	if (semaphore == NULL)
+		AbortOnError("NewSemaphore() could not allocate a semaphore.\n"
+				"Program will end.");
+	semaphore->handle = CreateSemaphore(NULL, count, 0x7fffffff, NULL);
+	if (semaphore->handle == NULL)
+		AbortOnError("NewSemaphore() failed to create a semaphore.\n"
+				"Program will end.");
+	return semaphore;
+}
+
+void WaitSemaphore(SEMAPHORE *semaphore) {
+	WaitForSingleObject(semaphore->handle, INFINITE);
+}
+
+int WaitSemaphoreTimeout(SEMAPHORE *semaphore, int milliseconds) {
+	return WaitForSingleObject(semaphore->handle, milliseconds)
+			== WAIT_OBJECT_0;
+}
+
+void PostSemaphore(SEMAPHORE *semaphore) {
+	ReleaseSemaphore(semaphore->handle, 1, NULL);
+}
+
+void FreeSemaphore(SEMAPHORE *semaphore) {
+	CloseHandle(semaphore->handle);
+	free(semaphore);
+}
+
+void YieldThread(void) {
+	Sleep(0);
+}
+
+int GetNumProcessors(void) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors;
+}
+
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+struct THREAD_TAG {
+	pthread_t handle;
+	void (*threadFunc)(void *);
+	void *data;
+};
+
+struct MUTEX_TAG {
+	pthread_mutex_t lock;
+};
+
+//POSIX unnamed semaphores aren't available everywhere, so a semaphore is
+//built from a mutex and a condition variable.
+struct SEMAPHORE_TAG {
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	int count;
+};
+
+static void *ThreadEntry(void *param) {
+	THREAD *thread = param;
+	thread->threadFunc(thread->data);
+	return NULL;
+}
+
+THREAD *StartThread(void (*threadFunc)(void *), void *data) {
+	THREAD *thread = malloc(sizeof(THREAD));
+
+	if (thread == NULL)
+		AbortOnError("StartThread() could not allocate a thread.\n"
+				"Program will end.");
+	thread->threadFunc = threadFunc;
+	thread->data = data;
+	if (pthread_create(&thread->handle, NULL, ThreadEntry, thread) != 0)
+		AbortOnError("StartThread() failed to create a thread.\n"
+				"Program will end.");
+	return thread;
+}
+
+void JoinThread(THREAD *thread) {
+	pthread_join(thread->handle, NULL);
+	free(thread);
+}
+
+MUTEX *NewMutex(void) {
+	MUTEX *mutex = malloc(sizeof(MUTEX));
+
+	if (mutex == NULL)
+		AbortOnError("NewMutex() could not allocate a mutex.\n"
+				"Program will end.");
+	pthread_mutex_init(&mutex->lock, NULL);
+	return mutex;
+}
+
+void LockMutex(MUTEX *mutex) {
+	pthread_mutex_lock(&mutex->lock);
+}
+
+void UnlockMutex(MUTEX *mutex) {
+	pthread_mutex_unlock(&mutex->lock);
+}
+
+void FreeMutex(MUTEX *mutex) {
+	pthread_mutex_destroy(&mutex->lock);
+	free(mutex);
+}
+
+SEMAPHORE *NewSemaphore(int count) {
+	SEMAPHORE *semaphore = malloc(sizeof(SEMAPHORE));
+
+	if (semaphore == NULL)
+		AbortOnError("NewSemaphore() could not allocate a semaphore.\n"
+				"Program will end.");
+	pthread_mutex_init(&semaphore->lock, NULL);
+	pthread_cond_init(&semaphore->changed, NULL);
+	semaphore->count = count;
+	return semaphore;
+}
+
+void WaitSemaphore(SEMAPHORE *semaphore) {
+	pthread_mutex_lock(&semaphore->lock);
+	while (semaphore->count == 0)
+		pthread_cond_wait(&semaphore->changed, &semaphore->lock);
+	semaphore->count--;
+	pthread_mutex_unlock(&semaphore->lock);
+}
+
+int WaitSemaphoreTimeout(SEMAPHORE *semaphore, int milliseconds) {
+	struct timespec deadline;
+	int result = 0;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += milliseconds / 1000;
+	deadline.tv_nsec += (milliseconds % 1000) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	pthread_mutex_lock(&semaphore->lock);
+	while (semaphore->count == 0 && result != ETIMEDOUT)
+		result = pthread_cond_timedwait(&semaphore->changed, &semaphore->lock,
+				&deadline);
+	if (semaphore->count > 0) {
+		semaphore->count--;
+		result = 1;
+	} else
+		result = 0;
+	pthread_mutex_unlock(&semaphore->lock);
+	return result;
+}
+
+void PostSemaphore(SEMAPHORE *semaphore) {
+	pthread_mutex_lock(&semaphore->lock);
+	semaphore->count++;
+	pthread_cond_signal(&semaphore->changed);
+	pthread_mutex_unlock(&semaphore->lock);
+}
+
+void FreeSemaphore(SEMAPHORE *semaphore) {
+	pthread_cond_destroy(&semaphore->changed);
+	pthread_mutex_destroy(&semaphore->lock);
+	free(semaphore);
+}
+
+void YieldThread(void) {
+	sched_yield();
+}
+
+int GetNumProcessors(void) {
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (int) count : 1;
+}
+
+#endif
@@ -0,0 +1,53 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: threads.h
+//
+// Description: A thin, portable layer over the platform's threads.  Windows
+//              builds use the Win32 API directly and everything else uses
+//              POSIX threads.  Only the handful of primitives needed by the
+//              job system and its users are provided.
+//
+//              Note: threads.c must not include allegro.h as on Windows it
+//                    needs <windows.h>, which clashes with Allegro's names.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef THREADS_HEADER
+#define THREADS_HEADER 1
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread           //GCC/MinGW thread-local storage.
+#endif
+
+//Atomic integer helpers.  These are full memory barriers.
+#define AtomicAdd(ptr, value)  __sync_add_and_fetch((ptr), (value))
+#define AtomicSub(ptr, value)  __sync_sub_and_fetch((ptr), (value))
+#define AtomicSwap(ptr, oldValue, newValue) \
+	__sync_bool_compare_and_swap((ptr), (oldValue), (newValue))
+#define MemoryBarrier_M()      __sync_synchronize()
+
+typedef struct THREAD_TAG THREAD;
+typedef struct MUTEX_TAG MUTEX;
+typedef struct SEMAPHORE_TAG SEMAPHORE;
+
+THREAD *StartThread(void (*threadFunc)(void *), void *data);
+void JoinThread(THREAD *thread);
+
+MUTEX *NewMutex(void);
+void LockMutex(MUTEX *mutex);
+void UnlockMutex(MUTEX *mutex);
+void FreeMutex(MUTEX *mutex);
+
+SEMAPHORE *NewSemaphore(int count);
+void WaitSemaphore(SEMAPHORE *semaphore);
+int WaitSemaphoreTimeout(SEMAPHORE *semaphore, int milliseconds);
+void PostSemaphore(SEMAPHORE *semaphore);
+void FreeSemaphore(SEMAPHORE *semaphore);
+
+void YieldThread(void);
+int GetNumProcessors(void);
+
+#endif
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: timing.c
+//
+// Description: This file implements the clock described in timing.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//                   18 Oct 2026 - Added ReadMemoryUse().
+//                   18 Oct 2026 - Added ReadThreadTime().
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "timing.h"
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2                //GetProcessMemoryInfo() in kernel32.
+#include <windows.h>
+#include <psapi.h>
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadTimer
+//
+// Description: This function reads a monotonic clock.  Only differences
+//              between readings mean anything.
+//
+// Parameters: None.
+//
+// Returns: long long - The time in nanoseconds.
+//
+////////////////////////////////////////////////////////////////////////////////
+long long ReadTimer(void) {
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER count;
+
+	if (frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&count);
+	return (long long) (count.QuadPart / frequency.QuadPart) * 1000000000LL
+			+ (count.QuadPart % frequency.QuadPart) * 1000000000LL
+					/ frequency.QuadPart;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadThreadTime
+//
+// Description: This function reads the CPU time the calling thread has used,
+//              in user and kernel mode together.  Only differences between
+//              readings on the same thread mean anything.  Windows counts it
+//              in scheduler ticks, so short spans may read as 0.
+//
+// Parameters: None.
+//
+// Returns: long long - The time in nanoseconds, or -1 if it can't be read.
+//
+////////////////////////////////////////////////////////////////////////////////
+long long ReadThreadTime(void) {
+	FILETIME creation, exit, kernel, user;
+
+	if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+		return -1;
+	return ((((long long) kernel.dwHighDateTime << 32) + kernel.dwLowDateTime)
+			+ (((long long) user.dwHighDateTime << 32) + user.dwLowDateTime))
+			* 100;                                  //In 100ns units.
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadMemoryUse
+//
+// Description: This function reads how much of the process is in memory
+//              (its working set on Windows, resident set elsewhere).
+//
+// Parameters: long long *resident - Set to the bytes in memory now, or -1 if
+//                                   it can't be read.
+//             long long *peak - Set to the most there have ever been, or -1.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ReadMemoryUse(long long *resident, long long *peak) {
+	PROCESS_MEMORY_COUNTERS counters;
+
+	*resident = *peak = -1;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+			sizeof(counters))) {
+		*resident = counters.WorkingSetSize;
+		*peak = counters.PeakWorkingSetSize;
+	}
+}
+
+#else
+#include <stdio.h>
+#include <time.h>
+#include <sys/resource.h>
+
+long long ReadTimer(void) {
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+long long ReadThreadTime(void) {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	struct timespec now;
+
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0)
+		return (long long) now.tv_sec * 1000000000LL + now.tv_nsec;
+#endif
+	return -1;
+}
+
+void ReadMemoryUse(long long *resident, long long *peak) {
+	struct rusage usage;
+	char line[128];
+	FILE *status;
+
+	*resident = *peak = -1;
+	status = fopen("/proc/self/status", "r");       //Linux only.
+	if (status != NULL) {
+		while (fgets(line, sizeof(line), status) != NULL) {
+			sscanf(line, "VmRSS: %lld", resident);
+			sscanf(line, "VmHWM: %lld", peak);
+		}
+		fclose(status);
+		if (*resident >= 0)
+			*resident *= 1024;                      //They are in kB.
+		if (*peak >= 0)
+			*peak *= 1024;
+	}
+	if (*peak < 0 && getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+		*peak = usage.ru_maxrss;                    //In bytes on Mac OS,
+#else
+		*peak = usage.ru_maxrss * 1024LL;           //kB elsewhere.
+#endif
+}
+
+#endif
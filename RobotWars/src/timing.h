@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: timing.h
+//
+// Description: A high resolution clock for benchmarks and profiling.
+//              clock() only ticks every few milliseconds on Windows, which is
+//              far too coarse to time a single stage of a calculation.
+//              Windows builds use QueryPerformanceCounter() and everything
+//              else uses clock_gettime(CLOCK_MONOTONIC).
+//
+//              ReadThreadTime() is the CPU time used by the calling thread
+//              alone, so work can be told apart from time spent waiting or
+//              preempted.
+//
+//              ReadMemoryUse() gives the process's resident memory, now and
+//              at its peak, for the benchmarks to report alongside times.
+//
+//              Note: like threads.c, timing.c must not include allegro.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//                   18 Oct 2026 - Added ReadMemoryUse().
+//                   18 Oct 2026 - Added ReadThreadTime().
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef TIMING_HEADER
+#define TIMING_HEADER 1
+
+long long ReadTimer(void);
+long long ReadThreadTime(void);
+void ReadMemoryUse(long long *resident, long long *peak);
+
+#endif
@@ -0,0 +1,340 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: trace.c
+//
+// Description: This file implements the timeline trace described in
+//              trace.h.  A thread's buffer is a list of chunks of events; a
+//              thread claims a slot in the buffer table the first time it
+//              records and keeps a pointer to it in thread-local storage.
+//              The trace generation tells a thread its buffer is from an
+//              earlier trace (and has been freed).
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace.h"
+#include "threads.h"
+#include "timing.h"
+
+#define TRACE_CHUNK_EVENTS  4096
+#define TRACE_LABEL_LEN     32          //Robot names are cut to fit.
+
+typedef struct {
+	const char *name;
+	const char *argName;         //NULL if none.
+	long long start;             //Nanoseconds (ReadTimer()).
+	long long end;               //< 0 for an instant.
+	int arg;
+	char label[TRACE_LABEL_LEN]; //The robot, if not empty.
+} TRACE_EVENT;
+
+typedef struct TRACE_CHUNK_TAG {
+	TRACE_EVENT events[TRACE_CHUNK_EVENTS];
+	int count;
+	struct TRACE_CHUNK_TAG *next;
+} TRACE_CHUNK;
+
+typedef struct {
+	TRACE_CHUNK *first;
+	TRACE_CHUNK *last;
+} TRACE_BUFFER;
+
+static volatile int tracing = 0;
+static int generation = 0;
+static char *traceFileName = NULL;
+static long long traceStart;
+static TRACE_BUFFER *buffers[MAX_TRACE_THREADS];
+static int numBuffers = 0;                  //Slots claimed, may pass the max.
+static int dropped = 0;
+static THREAD_LOCAL TRACE_BUFFER *threadBuffer = NULL;
+static THREAD_LOCAL int threadGeneration = 0;  //The trace threadBuffer is in.
+
+//Internal helper prototypes
+static TRACE_EVENT *NewEvent(void);
+static void WriteString(FILE *file, const char *string);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StartTrace
+//
+// Description: This function starts recording a trace.  Any trace being
+//              recorded is written first.
+//
+// Parameters: char *fileName - The file StopTrace() writes.  It is replaced.
+//
+// Returns: int - 1 if tracing, 0 if the file can't be created.
+//
+////////////////////////////////////////////////////////////////////////////////
+int StartTrace(char *fileName) {
+	FILE *file;
+
+	StopTrace();
+	file = fopen(fileName, "w");             //Find out now, not at the end.
+	if (file == NULL)
+		return 0;
+	fclose(file);
+	traceFileName = malloc(strlen(fileName) + 1);
+	if (traceFileName == NULL)
+		return 0;
+	strcpy(traceFileName, fileName);
+
+	generation++;
+	numBuffers = 0;
+	dropped = 0;
+	traceStart = ReadTimer();
+	MemoryBarrier_M();
+	tracing = 1;
+	TraceInstant("Trace started", NULL, 0);  //Makes this thread track 0.
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: StopTrace
+//
+// Description: This function stops recording and writes the trace, then
+//              frees it.  No other thread may be recording.
+//
+// Parameters: None.
+//
+// Returns: int - 1 if the trace was written, 0 if not tracing or the file
+//                couldn't be written.
+//
+////////////////////////////////////////////////////////////////////////////////
+int StopTrace(void) {
+	TRACE_CHUNK *chunk, *next;
+	TRACE_EVENT *event;
+	FILE *file;
+	int i, j, success, separator = 0;
+
+	if (!tracing)
+		return 0;
+	tracing = 0;
+	MemoryBarrier_M();
+
+	file = fopen(traceFileName, "w");
+	if (file != NULL) {
+		fprintf(file, "{\"traceEvents\":[\n");
+		fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+				"\"args\":{\"name\":\"Robot Wars\"}}");
+		for (i = 0; i < numBuffers && i < MAX_TRACE_THREADS; i++) {
+			fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\","
+					"\"pid\":1,\"tid\":%d,\"args\":{\"name\":", i);
+			if (i == 0)                           //See StartTrace().
+				fprintf(file, "\"main\"}}");
+			else
+				fprintf(file, "\"thread %d\"}}", i);
+			for (chunk = buffers[i]->first; chunk != NULL; chunk = chunk->next)
+				for (j = 0; j < chunk->count; j++) {
+					event = &chunk->events[j];
+					fprintf(file, ",\n{\"name\":");
+					WriteString(file, event->name);
+					fprintf(file, ",\"pid\":1,\"tid\":%d,\"ts\":%.3f", i,
+							(event->start - traceStart) / 1e3);
+					if (event->end >= 0)
+						fprintf(file, ",\"ph\":\"X\",\"dur\":%.3f",
+								(event->end - event->start) / 1e3);
+					else
+						fprintf(file, ",\"ph\":\"i\",\"s\":\"t\"");
+					separator = 0;
+					fprintf(file, ",\"args\":{");
+					if (event->argName != NULL) {
+						WriteString(file, event->argName);
+						fprintf(file, ":%d", event->arg);
+						separator = 1;
+					}
+					if (event->label[0] != '\0') {
+						fprintf(file, "%s\"robot\":", separator ? "," : "");
+						WriteString(file, event->label);
+					}
+					fprintf(file, "}}");
+				}
+		}
+		fprintf(file, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":"
+				"{\"droppedEvents\":%d}}\n", dropped);
+		success = !ferror(file);
+		success = fclose(file) == 0 && success;
+	} else
+		success = 0;
+
+	for (i = 0; i < numBuffers && i < MAX_TRACE_THREADS; i++) {
+		for (chunk = buffers[i]->first; chunk != NULL; chunk = next) {
+			next = chunk->next;
+			free(chunk);
+		}
+		free(buffers[i]);
+		buffers[i] = NULL;
+	}
+	numBuffers = 0;
+	free(traceFileName);
+	traceFileName = NULL;
+	return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TraceSpan
+//
+// Description: This function records something that took a while.
+//
+// Parameters: const char *name - What it was.  The string must last until
+//                                the trace is written.
+//             long long start - When it started (from ReadTimer()).
+//             long long end - When it ended.
+//             const char *argName - The name of a number to show with it, or
+//                                   NULL.  It must last like the name.
+//             int arg - The number.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void TraceSpan(const char *name, long long start, long long end,
+		const char *argName, int arg) {
+	TRACE_EVENT *event;
+
+	if (!tracing || (event = NewEvent()) == NULL)
+		return;
+	event->name = name;
+	event->argName = argName;
+	event->start = start;
+	event->end = end;
+	event->arg = arg;
+	event->label[0] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TraceRobotSpan
+//
+// Description: This function records something a robot took a while over.
+//              The robot's name is copied.
+//
+// Parameters: const char *name - What it was, as for TraceSpan().
+//             long long start, end - As for TraceSpan().
+//             const char *robotName - The robot.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void TraceRobotSpan(const char *name, long long start, long long end,
+		const char *robotName) {
+	TRACE_EVENT *event;
+
+	if (!tracing || (event = NewEvent()) == NULL)
+		return;
+	event->name = name;
+	event->argName = NULL;
+	event->start = start;
+	event->end = end;
+	strncpy(event->label, robotName, TRACE_LABEL_LEN - 1);
+	event->label[TRACE_LABEL_LEN - 1] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TraceInstant
+//
+// Description: This function records something that happened now.
+//
+// Parameters: As for TraceSpan().
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void TraceInstant(const char *name, const char *argName, int arg) {
+	TRACE_EVENT *event;
+
+	if (!tracing || (event = NewEvent()) == NULL)
+		return;
+	event->name = name;
+	event->argName = argName;
+	event->start = ReadTimer();
+	event->end = -1;
+	event->arg = arg;
+	event->label[0] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: NewEvent
+//
+// Description: This function makes room for an event in the calling thread's
+//              buffer, claiming a buffer for the thread the first time it
+//              records in a trace.
+//
+// Parameters: None.
+//
+// Returns: TRACE_EVENT* - The event to fill in, or NULL if it is dropped.
+//
+////////////////////////////////////////////////////////////////////////////////
+static TRACE_EVENT *NewEvent(void) {
+	TRACE_BUFFER *buffer = threadBuffer;
+	TRACE_CHUNK *chunk;
+	int slot;
+
+	if (threadGeneration != generation) {
+		threadGeneration = generation;
+		threadBuffer = NULL;
+		buffer = calloc(1, sizeof(TRACE_BUFFER));
+		if (buffer == NULL) {
+			AtomicAdd(&dropped, 1);
+			return NULL;
+		}
+		slot = AtomicAdd(&numBuffers, 1) - 1;
+		if (slot >= MAX_TRACE_THREADS) {
+			free(buffer);
+			AtomicAdd(&dropped, 1);
+			return NULL;
+		}
+		buffers[slot] = buffer;
+		threadBuffer = buffer;
+	} else if (buffer == NULL) {                //No slot was left for it.
+		AtomicAdd(&dropped, 1);
+		return NULL;
+	}
+
+	chunk = buffer->last;
+	if (chunk == NULL || chunk->count == TRACE_CHUNK_EVENTS) {
+		chunk = malloc(sizeof(TRACE_CHUNK));
+		if (chunk == NULL) {
+			AtomicAdd(&dropped, 1);
+			return NULL;
+		}
+		chunk->count = 0;
+		chunk->next = NULL;
+		if (buffer->last != NULL)
+			buffer->last->next = chunk;
+		else
+			buffer->first = chunk;
+		buffer->last = chunk;
+	}
+	return &chunk->events[chunk->count++];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: WriteString
+//
+// Description: This function writes a JSON string.
+//
+// Parameters: FILE *file - The file.
+//             const char *string - The string, quoted and escaped as it's
+//                                  written.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void WriteString(FILE *file, const char *string) {
+	fputc('"', file);
+	for (; *string != '\0'; string++)
+		if (*string == '"' || *string == '\\')
+			fprintf(file, "\\%c", *string);
+		else if ((unsigned char) *string < ' ')
+			fprintf(file, "\\u%04x", (unsigned char) *string);
+		else
+			fputc(*string, file);
+	fputc('"', file);
+}
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: trace.h
+//
+// Description: This file contains the timeline trace, which records when
+//              things happened rather than how long they took on average:
+//              every frame, calculation and stage (see profile.h), every
+//              robot's orders function, every weapon fired and every
+//              explosion.  StopTrace() writes them as Chrome trace-event JSON,
+//              which Perfetto (ui.perfetto.dev) or chrome://tracing show as a
+//              timeline, one track per thread, so a slow calculation in a
+//              burst of catching up can be picked out and opened up.
+//
+//              Each thread records into its own buffer, which only it writes,
+//              so nothing is locked.  The buffers are only read by
+//              StopTrace(), which must be called when no other thread is
+//              recording (EndCompetition() calls it after the job workers
+//              have stopped).  When not tracing each call just returns.
+//
+//              Note: like threads.c, trace.c must not include allegro.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef TRACE_HEADER
+#define TRACE_HEADER 1
+
+#define MAX_TRACE_THREADS  64          //More threads' events are dropped.
+
+int StartTrace(char *fileName);
+int StopTrace(void);
+void TraceSpan(const char *name, long long start, long long end,
+		const char *argName, int arg);
+void TraceRobotSpan(const char *name, long long start, long long end,
+		const char *robotName);
+void TraceInstant(const char *name, const char *argName, int arg);
+
+#endif
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: arena.c
+//
+// Description: This file implements the canned arenas described in arena.h.
+//
+// Revision History: 18 Oct 2026 - Created
+//                   18 Oct 2026 - Added RunStage() and GetStageName().
+//                   18 Oct 2026 - Lists and bitmaps are counted in the memory
+//                                 accounts (see memstats.h) as the engine's
+//                                 are, since physics.c frees weapons.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "arena.h"
+#include "graphics.h"
+#include "particles.h"
+#include "physics.h"
+#include "memstats.h"
+
+#define RADAR_WIDTH        30        //Arc of every radar.
+#define RADAR_RANGE        RADAR_MAX_RANGE
+#define BANKED_DAMAGE      5         //Enough for ApplyDamage() to work, too
+                                     //little to destroy anyone.
+#define ARENA_ROBOT_NAME   "Arena"   //Shown if the arena is rendered.
+#define PARTICLE_TTL       3600      //Seconds; none expire while timed.
+
+static unsigned int arenaRandom;
+static char *stageNames[NUM_ARENA_STAGES] = {      //The functions' names.
+	"UpdateEnergySystems", "MoveRobots", "DrawRobotBitmaps",
+	"CheckRobotCollisions", "MoveWeapons", "CheckWeaponCollisions",
+	"ApplyDamage", "DrawSensorBitmaps", "UpdateSensorData", "UpdateParticles"
+};
+
+//Internal helper prototypes
+static float ArenaRandom(float upperBound);
+static void MakeWeapon(ARENA *arena, WEAPON *weapon, int id);
+static void FillLists(ARENA *arena);
+static void RedrawRobots(ARENA *arena);
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: BuildArena
+//
+// Description: This function builds an arena to a specification.  The game
+//              must be initialised (InitCompetition()) first, for the
+//              images, and any particles already alive are deleted.
+//
+// Parameters: ARENA *arena - Filled in.
+//             ARENA_SPEC *spec - What to put in it.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void BuildArena(ARENA *arena, ARENA_SPEC *spec) {
+	int i, j, columns, rows;
+	float spacingX, spacingY;
+	ROBOT *robot;
+	SENSOR *sensor;
+
+	memset(arena, 0, sizeof(ARENA));
+	arena->spec = *spec;
+	arenaRandom = spec->seed != 0 ? spec->seed : 1;
+	arena->robots = ConsLL();
+	arena->deadRobots = ConsLL();
+	arena->weapons = ConsLL();
+	AccountLL(arena->robots, MA_ROBOT_NODES);
+	AccountLL(arena->deadRobots, MA_ROBOT_NODES);
+	AccountLL(arena->weapons, MA_WEAPON_NODES);
+	arena->savedRobots = calloc(spec->numRobots + 1, sizeof(ROBOT));
+	arena->savedWeapons = calloc(spec->numWeapons + 1, sizeof(WEAPON));
+	if (arena->savedRobots == NULL || arena->savedWeapons == NULL)
+		AbortOnError("BuildArena() could not allocate the arena.\n"
+				"Program will end.");
+
+	columns = ceil(sqrt(spec->numRobots));
+	rows = columns > 0 ? (spec->numRobots + columns - 1) / columns : 0;
+	spacingX = columns > 0 ? (float) ARENA_WIDTH_CM / columns : 0;
+	spacingY = rows > 0 ? (float) ARENA_HEIGHT_CM / rows : 0;
+	for (i = 0; i < spec->numRobots; i++) {
+		robot = &arena->savedRobots[i];
+		InitRobotState(robot);
+		robot->number = i;
+		robot->name = ARENA_ROBOT_NAME;
+		robot->color = makecol(ArenaRandom(256), ArenaRandom(256),
+				ArenaRandom(256));
+		robot->x = spacingX * (i % columns + 0.5) + ArenaRandom(spacingX / 4)
+				- spacingX / 8;
+		robot->y = spacingY * (i / columns + 0.5) + ArenaRandom(spacingY / 4)
+				- spacingY / 8;
+		robot->heading = ArenaRandom(360);
+		robot->shieldChargeRate = MAX_SHIELD_CHARGE_RATE / 2;
+		robot->weaponArray[LASER_PORT].chargeRate = MAX_LASER_CHARGE_RATE / 2;
+		robot->weaponArray[MISSILE_PORT].chargeRate = MAX_MISSILE_CHARGE_RATE
+				/ 2;
+		robot->damageBank = BANKED_DAMAGE;
+		robot->image = CreateBitmap(MA_SHIELD_BITMAPS, SHIELD_BMP_SZ,
+				SHIELD_BMP_SZ);
+		if (robot->image == NULL)
+			AbortOnError("BuildArena() could not create a robot image.\n"
+					"Program will end.");
+
+		for (j = 0; j < spec->numSensors; j++) {
+			sensor = &robot->sensorArray[j];
+			sensor->type = spec->sensors[j];
+			sensor->angle = 360 * j / spec->numSensors;
+			sensor->on = 1;
+			sensor->powered = 1;
+			if (sensor->type == SENSOR_RADAR) {
+				sensor->width = RADAR_WIDTH;
+				sensor->range = RADAR_RANGE;
+				sensor->image = CreateBitmap(MA_RADAR_BITMAPS, RADAR_IMAGE_PX,
+						RADAR_IMAGE_PX);
+				if (sensor->image == NULL)
+					AbortOnError("BuildArena() could not create a sensor "
+							"image.\nProgram will end.");
+			} else if (sensor->type == SENSOR_RANGE)
+				sensor->range = RANGE_MAX_RANGE;
+		}
+		UpdateHeadingTrig(robot);
+		InsLastLL(arena->robots, *robot);
+	}
+	RedrawRobots(arena);
+	i = 0;
+	ForeachLL_M(arena->robots, robot)         //Keep the drawn sensors' places.
+		arena->savedRobots[i++] = *robot;
+
+	for (i = 0; i < spec->numWeapons; i++)
+		MakeWeapon(arena, &arena->savedWeapons[i], i);
+	FillLists(arena);
+
+	ClearParticles();
+	for (i = 0; i < spec->numParticles; i++)
+		AddParticle(ArenaRandom(ARENA_WIDTH_PX), ArenaRandom(ARENA_HEIGHT_PX),
+				makecol(255, ArenaRandom(256), 0), ArenaRandom(360),
+				ArenaRandom(100), PARTICLE_TTL);
+	InitSnapshot(&arena->savedParticles);
+	SaveParticles(&arena->savedParticles);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ResetArena
+//
+// Description: This function puts an arena back as it was built.  Robots and
+//              weapons are put back in their original order, weapons that
+//              hit something get a new image, and if a robot was destroyed
+//              (which clears its images) every robot is redrawn.
+//
+// Parameters: ARENA *arena - The arena.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void ResetArena(ARENA *arena) {
+	WEAPON *weapon;
+	char *flying;
+	int i, size, redraw = !IsEmptyLL(arena->deadRobots);
+
+	flying = calloc(arena->spec.numWeapons + 1, 1);
+	if (flying == NULL)
+		AbortOnError("ResetArena() could not allocate its scratch space.\n"
+				"Program will end.");
+	ForeachLL_M(arena->weapons, weapon)       //Those that hit something had
+		flying[weapon->id] = 1;               //their image destroyed.
+	for (i = 0; i < arena->spec.numWeapons; i++)
+		if (!flying[i]) {
+			weapon = &arena->savedWeapons[i];
+			size = weapon->type == WEAPON_LASER ? LASER_BMP_SZ :
+					MISSILE_BMP_SZ;
+			weapon->image = CreateBitmap(MA_WEAPON_BITMAPS, size, size);
+			if (weapon->image == NULL)
+				AbortOnError("ResetArena() could not create a weapon image.\n"
+						"Program will end.");
+			DrawWeaponBitmap(weapon);
+		}
+	free(flying);
+
+	EmptyLL(arena->robots);
+	EmptyLL(arena->deadRobots);
+	EmptyLL(arena->weapons);
+	FillLists(arena);
+	arena->savedParticles.position = 0;
+	RestoreParticles(&arena->savedParticles);
+	memset(arena->game.playSound, 0, sizeof(arena->game.playSound));
+	if (redraw)
+		RedrawRobots(arena);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FreeArena
+//
+// Description: This function frees an arena and its images.
+//
+// Parameters: ARENA *arena - The arena.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void FreeArena(ARENA *arena) {
+	WEAPON *weapon;
+	int i, j;
+
+	for (i = 0; i < arena->spec.numRobots; i++) {
+		DestroyBitmap(MA_SHIELD_BITMAPS, arena->savedRobots[i].image);
+		for (j = 0; j < MAX_SENSORS; j++)
+			if (arena->savedRobots[i].sensorArray[j].image != NULL)
+				DestroyBitmap(MA_RADAR_BITMAPS,
+						arena->savedRobots[i].sensorArray[j].image);
+	}
+	ForeachLL_M(arena->weapons, weapon)
+		DestroyBitmap(MA_WEAPON_BITMAPS, weapon->image);
+	DestLL(arena->robots);
+	DestLL(arena->deadRobots);
+	DestLL(arena->weapons);
+	free(arena->savedRobots);
+	free(arena->savedWeapons);
+	FreeSnapshot(&arena->savedParticles);
+	ClearParticles();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ParseSensors
+//
+// Description: This function reads the sensors for an arena's robots from a
+//              comma separated list, eg: "radar,radar,range".
+//
+// Parameters: ARENA_SPEC *spec - Its numSensors and sensors are set.
+//             char *sensors - The list.  An empty list means no sensors.
+//
+// Returns: int - 1 if successful, 0 if the list is wrong.
+//
+////////////////////////////////////////////////////////////////////////////////
+int ParseSensors(ARENA_SPEC *spec, char *sensors) {
+	char *end;
+	int length;
+
+	spec->numSensors = 0;
+	while (*sensors != '\0') {
+		end = strchr(sensors, ',');
+		length = end != NULL ? end - sensors : (int) strlen(sensors);
+		if (spec->numSensors == MAX_SENSORS)
+			return 0;
+		if (length == 5 && strncmp(sensors, "radar", 5) == 0)
+			spec->sensors[spec->numSensors++] = SENSOR_RADAR;
+		else if (length == 5 && strncmp(sensors, "range", 5) == 0)
+			spec->sensors[spec->numSensors++] = SENSOR_RANGE;
+		else
+			return 0;
+		sensors += end != NULL ? length + 1 : length;
+	}
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunStage
+//
+// Description: This function runs one stage of a calculation on an arena,
+//              with the arguments RunCalculation() gives it.
+//
+// Parameters: ARENA *arena - The arena.
+//             ARENA_STAGE stage - The stage.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+void RunStage(ARENA *arena, ARENA_STAGE stage) {
+	switch (stage) {
+	case STAGE_ENERGY:
+		UpdateEnergySystems(arena->robots);
+		break;
+	case STAGE_MOVE_ROBOTS:
+		MoveRobots(arena->robots);
+		break;
+	case STAGE_DRAW_ROBOTS:
+		DrawRobotBitmaps(arena->robots);
+		break;
+	case STAGE_ROBOT_COLLISIONS:
+		CheckRobotCollisions(&arena->game, arena->robots);
+		break;
+	case STAGE_MOVE_WEAPONS:
+		MoveWeapons(arena->weapons);
+		break;
+	case STAGE_WEAPON_COLLISIONS:
+		CheckWeaponCollisions(&arena->game, arena->robots, arena->weapons);
+		break;
+	case STAGE_DAMAGE:
+		ApplyDamage(&arena->game, arena->robots, arena->deadRobots);
+		break;
+	case STAGE_DRAW_SENSORS:
+		DrawSensorBitmaps(arena->robots);
+		break;
+	case STAGE_SENSOR_DATA:
+		UpdateSensorData(arena->robots);
+		break;
+	case STAGE_PARTICLES:
+		UpdateParticles();
+		break;
+	default:
+		break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: GetStageName
+//
+// Description: This function names a stage after the function it runs.
+//
+// Parameters: ARENA_STAGE stage - The stage.
+//
+// Returns: char* - The name.
+//
+////////////////////////////////////////////////////////////////////////////////
+char *GetStageName(ARENA_STAGE stage) {
+	return stageNames[stage];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ArenaRandom
+//
+// Description: This function gives the arena's own random numbers, so
+//              building one doesn't disturb the game's stream.
+//
+// Parameters: float upperBound - The numbers are in [0, upperBound).
+//
+// Returns: float - The number.
+//
+////////////////////////////////////////////////////////////////////////////////
+static float ArenaRandom(float upperBound) {
+	arenaRandom ^= arenaRandom << 13;
+	arenaRandom ^= arenaRandom >> 17;
+	arenaRandom ^= arenaRandom << 5;
+	return upperBound * (arenaRandom >> 8) / 16777216.0f;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MakeWeapon
+//
+// Description: This function makes a weapon in flight, as if fired by robot
+//              id % numRobots from a random place in the arena.  Lasers and
+//              missiles alternate.
+//
+// Parameters: ARENA *arena - The arena, with its robots.
+//             WEAPON *weapon - Filled in.
+//             int id - The weapon's id.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void MakeWeapon(ARENA *arena, WEAPON *weapon, int id) {
+	ROBOT *owner = &arena->savedRobots[id % arena->spec.numRobots];
+	WEAPON_SYSTEM *weaponSys;
+
+	weaponSys = &owner->weaponArray[id % 2 == 0 ? LASER_PORT : MISSILE_PORT];
+	memset(weapon, 0, sizeof(WEAPON));
+	weapon->id = id;
+	weapon->type = weaponSys->type;
+	weapon->x = ArenaRandom(ARENA_WIDTH_CM - 2 * SHIELD_RAD_CM)
+			+ SHIELD_RAD_CM;
+	weapon->y = ArenaRandom(ARENA_HEIGHT_CM - 2 * SHIELD_RAD_CM)
+			+ SHIELD_RAD_CM;
+	weapon->heading = ArenaRandom(360);
+	weapon->cosHeading = cos(weapon->heading * DEG_PER_RAD);
+	weapon->sinHeading = sin(weapon->heading * DEG_PER_RAD);
+	weapon->speed = weaponSys->speed;
+	weapon->energy = weaponSys->maxEnergy;
+	weapon->splashRange = weaponSys->splashRange;
+	weapon->splashDamage = weaponSys->splashDamage;
+	weapon->bumpValue = weaponSys->bumpValue;
+	weapon->impactSound = weaponSys->impactSound;
+	weapon->image = weapon->type == WEAPON_LASER ?
+			CreateBitmap(MA_WEAPON_BITMAPS, LASER_BMP_SZ, LASER_BMP_SZ) :
+			CreateBitmap(MA_WEAPON_BITMAPS, MISSILE_BMP_SZ,
+					MISSILE_BMP_SZ);
+	if (weapon->image == NULL)
+		AbortOnError("MakeWeapon() could not create a weapon image.\n"
+				"Program will end.");
+	DrawWeaponBitmap(weapon);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: FillLists
+//
+// Description: This function puts copies of the saved robots and weapons in
+//              the arena's (empty) lists, and points each weapon at its
+//              owner's copy.
+//
+// Parameters: ARENA *arena - The arena.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void FillLists(ARENA *arena) {
+	ROBOT **byNumber;
+	WEAPON *weapon;
+	int i;
+
+	byNumber = malloc((arena->spec.numRobots + 1) * sizeof(ROBOT *));
+	if (byNumber == NULL)
+		AbortOnError("FillLists() could not allocate its scratch space.\n"
+				"Program will end.");
+	for (i = 0; i < arena->spec.numRobots; i++)
+		byNumber[i] = InsLastLL(arena->robots, arena->savedRobots[i]);
+	for (i = 0; i < arena->spec.numWeapons; i++) {
+		weapon = InsLastLL(arena->weapons, arena->savedWeapons[i]);
+		weapon->owner = byNumber[i % arena->spec.numRobots];
+	}
+	free(byNumber);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RedrawRobots
+//
+// Description: This function draws every robot and its sensors, as the
+//              previous calculation would have.
+//
+// Parameters: ARENA *arena - The arena.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RedrawRobots(ARENA *arena) {
+	DrawRobotBitmaps(arena->robots);
+	DrawSensorBitmaps(arena->robots);
+}
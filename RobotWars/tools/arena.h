@@ -0,0 +1,76 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: arena.h
+//
+// Description: This file contains the canned arenas the benchmark tools run
+//              the physics stages on.  An arena is any number of robots
+//              (not limited to MAX_ROBOTS, as they are never registered) with
+//              the same sensors, weapons in flight and live particles, all
+//              placed from a seed so a given ARENA_SPEC is always the same
+//              arena.
+//
+//              Robots are spread over a grid with a little jitter, so with
+//              many robots they crowd each other as they would in a big
+//              melee.  Weapons and particles are scattered over the whole
+//              arena.  Every robot has its shields, lasers and missiles
+//              charging and a little damage banked so the energy and damage
+//              stages have work to do.
+//
+//              The stages change the arena (robots move, weapons hit,
+//              particles burst), so ResetArena() puts it back as it was
+//              built before each run of a stage.  RunStage() runs a stage
+//              on the arena as RunCalculation() in competition.c would, and
+//              running them all in ARENA_STAGE order is a whole calculation.
+//
+// Revision History: 18 Oct 2026 - Created
+//                   18 Oct 2026 - Added RunStage() and GetStageName().
+//
+////////////////////////////////////////////////////////////////////////////////
+#ifndef ARENA_HEADER
+#define ARENA_HEADER 1
+
+#include "competition.h"
+#include "snapshot.h"
+
+typedef struct {
+	int numRobots;
+	int numSensors;                      //Ports used on each robot,
+	SENSORTYPE sensors[MAX_SENSORS];     //and what is on them.
+	int numWeapons;
+	int numParticles;
+	unsigned int seed;
+} ARENA_SPEC;
+
+typedef enum {                   //The stages of a calculation, in the order
+	STAGE_ENERGY,                //RunCalculation() runs them.
+	STAGE_MOVE_ROBOTS,
+	STAGE_DRAW_ROBOTS,
+	STAGE_ROBOT_COLLISIONS,
+	STAGE_MOVE_WEAPONS,
+	STAGE_WEAPON_COLLISIONS,
+	STAGE_DAMAGE,
+	STAGE_DRAW_SENSORS,
+	STAGE_SENSOR_DATA,
+	STAGE_PARTICLES,
+	NUM_ARENA_STAGES
+} ARENA_STAGE;
+
+typedef struct {
+	ARENA_SPEC spec;
+	GAME game;                   //For the stages' sound requests.
+	t_LL robots;
+	t_LL deadRobots;
+	t_LL weapons;
+	ROBOT *savedRobots;          //As built, by robot number.
+	WEAPON *savedWeapons;        //As built, by weapon id.
+	SNAPSHOT savedParticles;
+} ARENA;
+
+void BuildArena(ARENA *arena, ARENA_SPEC *spec);
+void ResetArena(ARENA *arena);
+void FreeArena(ARENA *arena);
+int ParseSensors(ARENA_SPEC *spec, char *sensors);
+void RunStage(ARENA *arena, ARENA_STAGE stage);
+char *GetStageName(ARENA_STAGE stage);
+
+#endif
@@ -0,0 +1,182 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: hashdiff.c
+//
+// Description: This tool compares two checksum files written by
+//              ChecksumMatch() (see checksum.h) for runs of the same match,
+//              and reports the first calculation where the runs went
+//              different ways and which parts of the state differed there:
+//
+//                  hashdiff before.rwc after.rwc
+//
+//              Every calculation is hashed, so the first difference is found
+//              by reading both files through once; there is nothing to
+//              search.  Everything after it usually differs too, so only the
+//              first is reported, with the last calculation that was still
+//              the same.
+//
+//              The exit status is 0 if the runs are the same, 1 if they
+//              differ and 2 if a file can't be read.
+//
+// Revision History: 18 Oct 2026 - Created
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "checksum.h"
+
+typedef struct {
+	char *fileName;
+	FILE *file;
+	CHECKSUM_FILE_HEADER header;
+	char *names;                 //CHECKSUM_NAME_LEN bytes each.
+	CHECKSUM_RECORD record;      //The last read,
+	uint64_t *fields;            //and its parts.
+} RUN;
+
+static char *robotFieldNames[CHECKSUM_ROBOT_FIELDS] = { "pose", "motion",
+		"energy", "damage", "sensors" };
+static char *gameFieldNames[CHECKSUM_GAME_FIELDS] = { "weapons",
+		"random numbers" };
+
+static int OpenRun(RUN *run, char *fileName);
+static int ReadRecord(RUN *run);
+static void ReportDifference(RUN *a, RUN *b);
+
+int main(int argc, char *argv[]) {
+	RUN a, b;
+	int haveA, haveB, lastSame = -1, count = 0;
+
+	if (argc != 3) {
+		fprintf(stderr, "usage: hashdiff first.rwc second.rwc\n");
+		return 2;
+	}
+	if (!OpenRun(&a, argv[1]) || !OpenRun(&b, argv[2]))
+		return 2;
+	if (a.header.numRobots != b.header.numRobots) {
+		printf("The runs have different robots (%d and %d).\n",
+				a.header.numRobots, b.header.numRobots);
+		return 1;
+	}
+
+	for (;;) {
+		haveA = ReadRecord(&a);
+		haveB = ReadRecord(&b);
+		if (!haveA || !haveB)
+			break;
+		if (a.record.tick != b.record.tick) {
+			printf("The runs are at different calculations (%d and %d) "
+					"after %d the same.\n", a.record.tick, b.record.tick,
+					count);
+			return 1;
+		}
+		if (a.record.hash != b.record.hash) {
+			printf("First difference at calculation %d", a.record.tick);
+			if (lastSame >= 0)
+				printf(" (calculation %d was the same)", lastSame);
+			printf(":\n");
+			ReportDifference(&a, &b);
+			return 1;
+		}
+		lastSame = a.record.tick;
+		count++;
+	}
+
+	if (haveA != haveB) {
+		printf("The same for %d calculations, up to %d, then %s ends.\n",
+				count, lastSame, haveA ? b.fileName : a.fileName);
+		return 1;
+	}
+	printf("The same for all %d calculations.\n", count);
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: OpenRun
+//
+// Description: This function opens a checksum file and reads its header and
+//              the robots' names.
+//
+// Parameters: RUN *run - Filled in.
+//             char *fileName - The file.
+//
+// Returns: int - 1 if successful, 0 (with a message) if not.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int OpenRun(RUN *run, char *fileName) {
+	run->fileName = fileName;
+	run->file = fopen(fileName, "rb");
+	if (run->file == NULL) {
+		fprintf(stderr, "hashdiff: can't open %s\n", fileName);
+		return 0;
+	}
+	if (fread(&run->header, sizeof(run->header), 1, run->file) != 1
+			|| run->header.magic != CHECKSUM_MAGIC
+			|| run->header.version != CHECKSUM_VERSION
+			|| run->header.numRobots < 1 || run->header.numRobots > 64
+			|| run->header.numFields
+					!= CHECKSUM_FIELDS(run->header.numRobots)) {
+		fprintf(stderr, "hashdiff: %s is not a checksum file\n", fileName);
+		return 0;
+	}
+
+	run->names = calloc(run->header.numRobots, CHECKSUM_NAME_LEN);
+	run->fields = calloc(run->header.numFields, sizeof(uint64_t));
+	if (run->names == NULL || run->fields == NULL
+			|| fread(run->names, CHECKSUM_NAME_LEN, run->header.numRobots,
+					run->file) != (size_t) run->header.numRobots) {
+		fprintf(stderr, "hashdiff: can't read %s\n", fileName);
+		return 0;
+	}
+	run->names[run->header.numRobots * CHECKSUM_NAME_LEN - 1] = '\0';
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReadRecord
+//
+// Description: This function reads the next calculation's hashes.
+//
+// Parameters: RUN *run - The run.
+//
+// Returns: int - 1 if read, 0 at the end of the file.  A record cut short
+//                counts as the end.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ReadRecord(RUN *run) {
+	return fread(&run->record, sizeof(run->record), 1, run->file) == 1
+			&& fread(run->fields, sizeof(uint64_t), run->header.numFields,
+					run->file) == (size_t) run->header.numFields;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ReportDifference
+//
+// Description: This function lists the parts of the state that differ
+//              between two records.
+//
+// Parameters: RUN *a, *b - The runs, at the same calculation.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void ReportDifference(RUN *a, RUN *b) {
+	int robot, field, index, game = a->header.numRobots
+			* CHECKSUM_ROBOT_FIELDS;
+
+	for (robot = 0; robot < a->header.numRobots; robot++)
+		for (field = 0; field < CHECKSUM_ROBOT_FIELDS; field++) {
+			index = robot * CHECKSUM_ROBOT_FIELDS + field;
+			if (a->fields[index] != b->fields[index])
+				printf("    robot %d (%s): %s\n", robot,
+						a->names + robot * CHECKSUM_NAME_LEN,
+						robotFieldNames[field]);
+		}
+	for (field = 0; field < CHECKSUM_GAME_FIELDS; field++)
+		if (a->fields[game + field] != b->fields[game + field])
+			printf("    %s\n", gameFieldNames[field]);
+}
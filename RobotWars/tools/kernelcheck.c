@@ -0,0 +1,1034 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: kernelcheck.c
+//
+// Description: This tool checks faster collision and sensor kernels against
+//              the Allegro bitmap code in physics.c, which stays the
+//              reference, and times both:
+//
+//                  kernelcheck [trials [seed]]
+//
+//              Each trial places MAX_ROBOTS robots close together at random
+//              positions and headings, with random radar arcs and ranges on
+//              half their ports and range sensors on the rest, and throws a
+//              laser or missile at random near the first robot.  The robots
+//              and sensors are drawn by graphics.c exactly as in a match, then
+//              every query is answered by the reference and each candidate:
+//
+//                  weapon/bitmask   ImagesCollide() on robot and weapon
+//                  weapon/geometric images, as in CheckWeaponCollisions()
+//                  radar/bitmask    DrawSensorBitmaps() + UpdateSensorData()
+//                  radar/analytic   for radars
+//                  range/analytic   UpdateSensorData() (do_line() and
+//                                   CheckPixel()) for range sensors
+//
+//              The bitmask kernels test 1-bit masks of the drawn images 64
+//              pixels at a time and should agree exactly.  The geometric and
+//              analytic ones don't look at the images at all: a robot is its
+//              shield circle, a weapon the circle around its image, a radar a
+//              circular sector and a range sensor a ray.  They are expected to
+//              differ where the pixels round differently, so each mismatch is
+//              put down as "near the edge" if the shapes are within a pixel of
+//              touching, and range readings count as the same to within
+//              RANGE_TOLERANCE_CM.  The first few mismatches of each kernel are
+//              printed so they can be reproduced.
+//
+//              Times are in nanoseconds per query, on one thread (the job
+//              system is restarted without workers).  Reference queries are
+//              timed one at a time; candidates are timed over a block of
+//              trials.  Building the masks is timed on its own and is not in
+//              the bitmask times, as a real kernel would keep masks alongside
+//              the images.
+//
+//              The candidates live here until they have earned a place in
+//              physics.c.  Run it from the game's directory, as it loads the
+//              game's images.  The exit status is 1 if a bitmask kernel, which
+//              must be exact, ever disagrees with the reference.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - END_OF_MAIN(), so it links with Allegro on
+//                                Windows.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include "competition.h"
+#include "graphics.h"
+#include "physics.h"
+#include "jobs.h"
+#include "timing.h"
+
+#define DEFAULT_TRIALS      100000
+#define BLOCK                   64     //Trials per candidate timing block.
+#define NUM_RADARS   (MAX_SENSORS / 2) //Ports [0, NUM_RADARS) are radars, the
+                                       //rest range sensors.
+#define RANGE_TOLERANCE_CM       1
+#define EDGE_PX                1.0     //Mismatches this close are edge cases.
+#define MAX_EXAMPLES             3
+#define EXAMPLE_LEN            200
+
+typedef struct {             //A 1-bit mask of an image's solid pixels.  Rows
+	int w;                   //have a spare word so 64 bits can be read from
+	int h;                   //any column.
+	int stride;              //Words per row.
+	uint64_t *bits;
+} MASK;
+
+typedef struct {             //A radar's arc in arena pixels, y up.
+	double x, y;             //Where the robot is.
+	double startX, startY;   //Leading edge, to the end of the arc.
+	double endX, endY;       //Trailing edge.
+	double radius;
+} SECTOR;
+
+typedef struct {
+	int robX, robY;          //Top left of each image, as in
+	int weaponX, weaponY;    //CheckWeaponRange().
+	double robotCX, robotCY;     //Centres, for the geometric kernel.
+	double weaponCX, weaponCY;
+	double weaponRadius;
+	MASK robotMask;
+	MASK weaponMask;
+	int reference;
+	int bitmask;
+	int geometric;
+	char pose[EXAMPLE_LEN];
+} WEAPON_TRIAL;
+
+typedef struct {
+	int robX[MAX_ROBOTS], robY[MAX_ROBOTS];     //Top left of robot images.
+	double cx[MAX_ROBOTS], cy[MAX_ROBOTS];      //Shield centres, y up.
+	MASK robotMasks[MAX_ROBOTS];
+	MASK radarMasks[MAX_ROBOTS][NUM_RADARS];
+	int sensX[MAX_ROBOTS][NUM_RADARS];          //Top left of radar images.
+	int sensY[MAX_ROBOTS][NUM_RADARS];
+	SECTOR sectors[MAX_ROBOTS][NUM_RADARS];
+	int lineX1[MAX_ROBOTS][MAX_SENSORS];        //Range sensor lines, in
+	int lineY1[MAX_ROBOTS][MAX_SENSORS];        //screen pixels as given to
+	int lineX2[MAX_ROBOTS][MAX_SENSORS];        //do_line().
+	int lineY2[MAX_ROBOTS][MAX_SENSORS];
+	int range[MAX_ROBOTS][MAX_SENSORS];
+	int reference[MAX_ROBOTS][MAX_SENSORS];     //Sensor data.
+	int bitmask[MAX_ROBOTS][NUM_RADARS];
+	int analytic[MAX_ROBOTS][MAX_SENSORS];
+	char pose[MAX_ROBOTS][MAX_SENSORS][EXAMPLE_LEN];
+} SENSOR_TRIAL;
+
+typedef struct {
+	char *name;
+	long long queries;
+	long long mismatches;
+	long long falseHits;     //Candidate saw something the reference didn't.
+	long long misses;        //And the other way round.
+	long long nearEdge;      //Of the mismatches.
+	int maxError;            //Range sensors, in cm.
+	double refNs;
+	double newNs;
+	int numExamples;
+	char examples[MAX_EXAMPLES][EXAMPLE_LEN * 2];
+} KERNEL_STATS;
+
+static t_LL robots;
+static ROBOT *robotArray[MAX_ROBOTS];
+static WEAPON weapons[2];                  //A laser and a missile.
+static double weaponRadius[2];
+static uint64_t randomState;
+static double robotMaskNs = 0, radarMaskNs = 0;
+static long long robotMasks = 0, radarMasks = 0;
+
+static KERNEL_STATS weaponBitmask = { "weapon/bitmask" };
+static KERNEL_STATS weaponGeometric = { "weapon/geometric" };
+static KERNEL_STATS radarBitmask = { "radar/bitmask" };
+static KERNEL_STATS radarAnalytic = { "radar/analytic" };
+static KERNEL_STATS rangeAnalytic = { "range/analytic" };
+
+static double Uniform(double low, double high);
+static void SetUpArena(void);
+static void FreeArena(void);
+static void PlaceRobots(void);
+static double MeasureWeaponRadius(WEAPON *weapon);
+static void CheckWeaponKernels(int trials);
+static void CheckSensorKernels(int trials);
+static void SetSensorsOn(SENSORTYPE type, int on);
+static char *Tally(KERNEL_STATS *stats, int reference, int candidate,
+		int same, double margin);
+static void PrintStats(KERNEL_STATS *stats);
+static void PrintExamples(KERNEL_STATS *stats);
+
+static void AllocMask(MASK *mask, int w, int h);
+static void BuildMask(MASK *mask, BITMAP *image);
+static int MasksCollide(MASK *a, int xA, int yA, MASK *b, int xB, int yB);
+static int CirclesCollide(double x1, double y1, double r1, double x2,
+		double y2, double r2);
+static double SectorDistance(SECTOR *sector, double x, double y);
+static int RadarSees(SECTOR *sector, double x, double y);
+static double RangeToHit(SENSOR_TRIAL *trial, int robot, int port);
+static double RangeMargin(SENSOR_TRIAL *trial, int robot, int port);
+
+int main(int argc, char *argv[]) {
+	int trials = argc > 1 ? atoi(argv[1]) : DEFAULT_TRIALS;
+
+	randomState = argc > 2 ? strtoul(argv[2], NULL, 10) : 1;
+	if (trials <= 0 || randomState == 0) {
+		fprintf(stderr, "usage: kernelcheck [trials [seed]]\n");
+		return 2;
+	}
+
+	SetHeadless();
+	InitCompetition();
+	DeInitJobSystem();                //Time every kernel on one thread.
+	InitJobSystem(0);
+	SetUpArena();
+
+	CheckWeaponKernels(trials);
+	CheckSensorKernels(trials);
+
+	printf("%-17s %9s %9s %8s %7s %7s %9s %8s %8s %8s\n", "kernel", "queries",
+			"mismatch", "rate", "false+", "false-", "near edge", "ref ns",
+			"new ns", "speedup");
+	PrintStats(&weaponBitmask);
+	PrintStats(&weaponGeometric);
+	PrintStats(&radarBitmask);
+	PrintStats(&radarAnalytic);
+	PrintStats(&rangeAnalytic);
+	printf("\nMasks take %.0f ns per robot image and %.0f ns per radar image."
+			"\nRange readings within %d cm are counted as the same; the "
+			"largest difference was %d cm.\n", robotMaskNs / robotMasks,
+			radarMaskNs / radarMasks, RANGE_TOLERANCE_CM,
+			rangeAnalytic.maxError);
+	PrintExamples(&weaponBitmask);
+	PrintExamples(&weaponGeometric);
+	PrintExamples(&radarBitmask);
+	PrintExamples(&radarAnalytic);
+	PrintExamples(&rangeAnalytic);
+
+	FreeArena();
+	EndCompetition();
+	return weaponBitmask.mismatches + radarBitmask.mismatches > 0;
+}
+END_OF_MAIN()          //Macro required for Allegro graphics library in Windows.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Uniform
+//
+// Description: This function returns a random number from the tool's own
+//              stream (xorshift64), so the game's stream is left alone and
+//              a seed always gives the same trials.
+//
+// Parameters: double low, high - The range.
+//
+// Returns: double - A number in [low, high).
+//
+////////////////////////////////////////////////////////////////////////////////
+static double Uniform(double low, double high) {
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 7;
+	randomState ^= randomState << 17;
+	return low + (high - low) * (randomState >> 11) / 9007199254740992.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetUpArena / FreeArena
+//
+// Description: These functions make and free the robots and weapons the
+//              trials use.  Only what graphics.c and physics.c look at is
+//              filled in.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SetUpArena(void) {
+	ROBOT robot;
+	int i, j;
+
+	robots = ConsLL();
+	for (i = 0; i < MAX_ROBOTS; i++) {
+		memset(&robot, 0, sizeof(robot));
+		robot.number = i;
+		robot.color = makecol(255 * (i != 1), 255 * (i % 2), 255 * (i == 2));
+		robot.image = create_bitmap(SHIELD_BMP_SZ, SHIELD_BMP_SZ);
+		for (j = 0; j < MAX_SENSORS; j++) {
+			robot.sensorArray[j].type = j < NUM_RADARS ? SENSOR_RADAR :
+					SENSOR_RANGE;
+			robot.sensorArray[j].on = 1;
+			robot.sensorArray[j].powered = 1;
+			if (j < NUM_RADARS)
+				robot.sensorArray[j].image = create_bitmap(RADAR_IMAGE_PX,
+						RADAR_IMAGE_PX);
+		}
+		robotArray[i] = InsLastLL(robots, robot);
+		if (robotArray[i] == NULL || robot.image == NULL
+				|| robot.sensorArray[0].image == NULL)
+			AbortOnError("SetUpArena() could not make a robot.\n"
+					"Program will end.");
+	}
+
+	for (i = 0; i < 2; i++) {
+		memset(&weapons[i], 0, sizeof(WEAPON));
+		weapons[i].type = i == 0 ? WEAPON_LASER : WEAPON_MISSILE;
+		weapons[i].owner = NULL;
+		weapons[i].image = i == 0 ?
+				create_bitmap(LASER_BMP_SZ, LASER_BMP_SZ) :
+				create_bitmap(MISSILE_BMP_SZ, MISSILE_BMP_SZ);
+		if (weapons[i].image == NULL)
+			AbortOnError("SetUpArena() could not make a weapon.\n"
+					"Program will end.");
+		weaponRadius[i] = MeasureWeaponRadius(&weapons[i]);
+	}
+}
+
+static void FreeArena(void) {
+	ROBOT *robot;
+	int i;
+
+	ForeachLL_M(robots, robot)
+	{
+		destroy_bitmap(robot->image);
+		for (i = 0; i < NUM_RADARS; i++)
+			destroy_bitmap(robot->sensorArray[i].image);
+	}
+	DestLL(robots);
+	destroy_bitmap(weapons[0].image);
+	destroy_bitmap(weapons[1].image);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PlaceRobots
+//
+// Description: This function puts the robots at random near the first one,
+//              close enough that radars see something about half the time,
+//              gives them random headings, shields and sensors, and draws
+//              them.  Sensor angles, arcs and ranges are within the limits
+//              AddSensor() allows.
+//
+// Parameters: None.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PlaceRobots(void) {
+	double angle, distance;
+	ROBOT *robot;
+	SENSOR *sensor;
+	int i, j;
+
+	for (i = 0; i < MAX_ROBOTS; i++) {
+		robot = robotArray[i];
+		if (i == 0) {
+			robot->x = Uniform(SHIELD_RAD_CM, ARENA_WIDTH_CM - SHIELD_RAD_CM);
+			robot->y = Uniform(SHIELD_RAD_CM, ARENA_HEIGHT_CM - SHIELD_RAD_CM);
+		} else {
+			angle = Uniform(0, 2 * PI);
+			distance = Uniform(SHIELD_RAD_CM, RADAR_MAX_RANGE + SHIELD_RAD_CM);
+			robot->x = robotArray[0]->x + distance * cos(angle);
+			robot->y = robotArray[0]->y + distance * sin(angle);
+			if (robot->x < SHIELD_RAD_CM)
+				robot->x = SHIELD_RAD_CM;
+			else if (robot->x > ARENA_WIDTH_CM - SHIELD_RAD_CM)
+				robot->x = ARENA_WIDTH_CM - SHIELD_RAD_CM;
+			if (robot->y < SHIELD_RAD_CM)
+				robot->y = SHIELD_RAD_CM;
+			else if (robot->y > ARENA_HEIGHT_CM - SHIELD_RAD_CM)
+				robot->y = ARENA_HEIGHT_CM - SHIELD_RAD_CM;
+		}
+		robot->heading = Uniform(0, 360);
+		robot->shields = Uniform(0, MAX_SHIELD_ENERGY);
+		for (j = 0; j < MAX_SENSORS; j++) {
+			sensor = &robot->sensorArray[j];
+			sensor->angle = (int) Uniform(0, 360);
+			if (sensor->type == SENSOR_RADAR) {
+				sensor->width = (int) Uniform(MIN_RADAR_ARC, MAX_RADAR_ARC + 1);
+				sensor->range = (int) Uniform(RADAR_MIN_RANGE,
+						RADAR_MAX_RANGE + 1);
+			} else
+				sensor->range = RANGE_MAX_RANGE;
+		}
+		UpdateHeadingTrig(robot);
+	}
+	DrawRobotBitmaps(robots);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MeasureWeaponRadius
+//
+// Description: This function finds the circle the geometric kernel uses for
+//              a weapon: the furthest solid pixel from the centre of its
+//              image over every heading.
+//
+// Parameters: WEAPON *weapon - The weapon, with its image.
+//
+// Returns: double - The radius, in pixels.
+//
+////////////////////////////////////////////////////////////////////////////////
+static double MeasureWeaponRadius(WEAPON *weapon) {
+	double radius = 0, dx, dy, centre = (weapon->image->w - 1) / 2.0;
+	int heading, x, y;
+
+	for (heading = 0; heading < 360; heading += 5) {
+		weapon->heading = heading;
+		DrawWeaponBitmap(weapon);
+		for (y = 0; y < weapon->image->h; y++)
+			for (x = 0; x < weapon->image->w; x++)
+				if (getpixel(weapon->image, x, y) != COLOR_TRANS) {
+					dx = x - centre;
+					dy = y - centre;
+					if (sqrt(dx * dx + dy * dy) > radius)
+						radius = sqrt(dx * dx + dy * dy);
+				}
+	}
+	return radius;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckWeaponKernels
+//
+// Description: This function runs the weapon trials: a laser or missile at a
+//              random heading within a few centimetres of the edge of the
+//              first robot's shield, tested as CheckWeaponRange() does.
+//              Weapons aren't put further in, as one coming from outside
+//              hits the shield before it gets there.
+//
+// Parameters: int trials - How many.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void CheckWeaponKernels(int trials) {
+	WEAPON_TRIAL *block, *trial;
+	ROBOT *robot = robotArray[0];
+	WEAPON *weapon;
+	long long start;
+	double angle, distance, margin;
+	char *example;
+	int done, count, i, type;
+
+	block = calloc(BLOCK, sizeof(WEAPON_TRIAL));
+	if (block == NULL)
+		AbortOnError("CheckWeaponKernels() could not allocate its trials.\n"
+				"Program will end.");
+	for (i = 0; i < BLOCK; i++) {
+		AllocMask(&block[i].robotMask, SHIELD_BMP_SZ, SHIELD_BMP_SZ);
+		AllocMask(&block[i].weaponMask, MISSILE_BMP_SZ, MISSILE_BMP_SZ);
+	}
+
+	for (done = 0; done < trials; done += count) {
+		count = trials - done < BLOCK ? trials - done : BLOCK;
+		for (i = 0; i < count; i++) {
+			trial = &block[i];
+			PlaceRobots();
+			type = (done + i) % 2;
+			weapon = &weapons[type];
+			angle = Uniform(0, 2 * PI);
+			distance = Uniform(SHIELD_RAD_CM - SHIELD_THICK_PX / PX_PER_CM,
+					SHIELD_RAD_CM + MISSILE_BMP_SZ / PX_PER_CM);
+			weapon->x = robot->x + distance * cos(angle);
+			weapon->y = robot->y + distance * sin(angle);
+			weapon->heading = Uniform(0, 360);
+			DrawWeaponBitmap(weapon);
+
+			trial->robX = robot->x * PX_PER_CM - SHIELD_BMP_SZ / 2;
+			trial->robY = ARENA_HEIGHT_PX - robot->y * PX_PER_CM
+					- SHIELD_BMP_SZ / 2;
+			trial->weaponX = weapon->x * PX_PER_CM - weapon->image->w / 2;
+			trial->weaponY = ARENA_HEIGHT_PX - weapon->y * PX_PER_CM
+					- weapon->image->h / 2;
+			trial->robotCX = trial->robX + SHIELD_BMP_SZ / 2;
+			trial->robotCY = trial->robY + SHIELD_BMP_SZ / 2;
+			trial->weaponCX = trial->weaponX + (weapon->image->w - 1) / 2.0;
+			trial->weaponCY = trial->weaponY + (weapon->image->h - 1) / 2.0;
+			trial->weaponRadius = weaponRadius[type];
+			sprintf(trial->pose, "robot (%.3f, %.3f) heading %.3f, %s "
+					"(%.3f, %.3f) heading %.3f", robot->x, robot->y,
+					robot->heading, type == 0 ? "laser" : "missile", weapon->x,
+					weapon->y, weapon->heading);
+
+			start = ReadTimer();
+			trial->reference = ImagesCollide(robot->image, trial->robX,
+					trial->robY, weapon->image, trial->weaponX,
+					trial->weaponY);
+			weaponBitmask.refNs += ReadTimer() - start;
+
+			start = ReadTimer();
+			BuildMask(&trial->robotMask, robot->image);
+			robotMaskNs += ReadTimer() - start;
+			robotMasks++;
+			BuildMask(&trial->weaponMask, weapon->image);
+		}
+
+		start = ReadTimer();
+		for (i = 0; i < count; i++)
+			block[i].bitmask = MasksCollide(&block[i].robotMask, block[i].robX,
+					block[i].robY, &block[i].weaponMask, block[i].weaponX,
+					block[i].weaponY);
+		weaponBitmask.newNs += ReadTimer() - start;
+
+		start = ReadTimer();
+		for (i = 0; i < count; i++)
+			block[i].geometric = CirclesCollide(block[i].robotCX,
+					block[i].robotCY, SHIELD_RAD_PX, block[i].weaponCX,
+					block[i].weaponCY, block[i].weaponRadius);
+		weaponGeometric.newNs += ReadTimer() - start;
+
+		for (i = 0; i < count; i++) {
+			trial = &block[i];
+			margin = fabs(hypot(trial->robotCX - trial->weaponCX,
+					trial->robotCY - trial->weaponCY) - SHIELD_RAD_PX
+					- trial->weaponRadius);
+			example = Tally(&weaponBitmask, trial->reference, trial->bitmask,
+					trial->reference == trial->bitmask, margin);
+			if (example != NULL)
+				sprintf(example, "%s: reference %d", trial->pose,
+						trial->reference);
+			example = Tally(&weaponGeometric, trial->reference,
+					trial->geometric, trial->reference == trial->geometric,
+					margin);
+			if (example != NULL)
+				sprintf(example, "%s: reference %d", trial->pose,
+						trial->reference);
+		}
+	}
+	weaponGeometric.refNs = weaponBitmask.refNs;
+
+	for (i = 0; i < BLOCK; i++) {
+		free(block[i].robotMask.bits);
+		free(block[i].weaponMask.bits);
+	}
+	free(block);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CheckSensorKernels
+//
+// Description: This function runs the sensor trials.  The reference radars
+//              are read with the range sensors off and the other way round,
+//              so each kind is timed on its own.
+//
+// Parameters: int trials - How many.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void CheckSensorKernels(int trials) {
+	SENSOR_TRIAL *block, *trial;
+	ROBOT *robot;
+	SENSOR *sensor;
+	long long start;
+	double margin, distance;
+	char *example;
+	int done, count, i, r, o, s, hit, error;
+
+	block = calloc(BLOCK, sizeof(SENSOR_TRIAL));
+	if (block == NULL)
+		AbortOnError("CheckSensorKernels() could not allocate its trials.\n"
+				"Program will end.");
+	for (i = 0; i < BLOCK; i++)
+		for (r = 0; r < MAX_ROBOTS; r++) {
+			AllocMask(&block[i].robotMasks[r], SHIELD_BMP_SZ, SHIELD_BMP_SZ);
+			for (s = 0; s < NUM_RADARS; s++)
+				AllocMask(&block[i].radarMasks[r][s], RADAR_IMAGE_PX,
+						RADAR_IMAGE_PX);
+		}
+
+	for (done = 0; done < trials; done += count) {
+		count = trials - done < BLOCK ? trials - done : BLOCK;
+		for (i = 0; i < count; i++) {
+			trial = &block[i];
+			PlaceRobots();
+
+			SetSensorsOn(SENSOR_RANGE, 0);
+			start = ReadTimer();
+			DrawSensorBitmaps(robots);
+			UpdateSensorData(robots);
+			radarBitmask.refNs += ReadTimer() - start;
+			for (r = 0; r < MAX_ROBOTS; r++)
+				for (s = 0; s < NUM_RADARS; s++)
+					trial->reference[r][s] = robotArray[r]->sensorArray[s].data;
+			SetSensorsOn(SENSOR_RANGE, 1);
+			SetSensorsOn(SENSOR_RADAR, 0);
+			start = ReadTimer();
+			UpdateSensorData(robots);
+			rangeAnalytic.refNs += ReadTimer() - start;
+			for (r = 0; r < MAX_ROBOTS; r++)
+				for (s = NUM_RADARS; s < MAX_SENSORS; s++)
+					trial->reference[r][s] = robotArray[r]->sensorArray[s].data;
+			SetSensorsOn(SENSOR_RADAR, 1);
+
+			for (r = 0; r < MAX_ROBOTS; r++) {
+				robot = robotArray[r];
+				trial->robX[r] = robot->x * PX_PER_CM - SHIELD_BMP_SZ / 2;
+				trial->robY[r] = ARENA_HEIGHT_PX - robot->y * PX_PER_CM
+						- SHIELD_BMP_SZ / 2;
+				trial->cx[r] = trial->robX[r] + SHIELD_BMP_SZ / 2;
+				trial->cy[r] = ARENA_HEIGHT_PX - trial->robY[r]
+						- SHIELD_BMP_SZ / 2;
+				start = ReadTimer();
+				BuildMask(&trial->robotMasks[r], robot->image);
+				robotMaskNs += ReadTimer() - start;
+				robotMasks++;
+
+				for (s = 0; s < MAX_SENSORS; s++) {
+					sensor = &robot->sensorArray[s];
+					trial->range[r][s] = sensor->range;
+					sprintf(trial->pose[r][s], "robot %d (%.3f, %.3f) "
+							"heading %.3f, %s angle %d width %d range %d",
+							r, robot->x, robot->y, robot->heading,
+							s < NUM_RADARS ? "radar" : "range sensor",
+							sensor->angle, sensor->width, sensor->range);
+					if (s >= NUM_RADARS) {      //As in UpdateSensorRange().
+						trial->lineX1[r][s] = robot->x * PX_PER_CM;
+						trial->lineY1[r][s] = ARENA_HEIGHT_PX
+								- robot->y * PX_PER_CM;
+						trial->lineX2[r][s] = trial->lineX1[r][s]
+								+ sensor->startCos * sensor->range * PX_PER_CM;
+						trial->lineY2[r][s] = trial->lineY1[r][s]
+								- sensor->startSin * sensor->range * PX_PER_CM;
+						continue;
+					}
+
+					trial->sensX[r][s] = robot->x * PX_PER_CM - sensor->drawX;
+					trial->sensY[r][s] = ARENA_HEIGHT_PX - robot->y * PX_PER_CM
+							- sensor->drawY;
+					start = ReadTimer();
+					BuildMask(&trial->radarMasks[r][s], sensor->image);
+					radarMaskNs += ReadTimer() - start;
+					radarMasks++;
+
+					trial->sectors[r][s].x = robot->x * PX_PER_CM;
+					trial->sectors[r][s].y = robot->y * PX_PER_CM;
+					trial->sectors[r][s].radius = sensor->range * PX_PER_CM;
+					trial->sectors[r][s].startX = sensor->startCos
+							* trial->sectors[r][s].radius;
+					trial->sectors[r][s].startY = sensor->startSin
+							* trial->sectors[r][s].radius;
+					trial->sectors[r][s].endX = sensor->endCos
+							* trial->sectors[r][s].radius;
+					trial->sectors[r][s].endY = sensor->endSin
+							* trial->sectors[r][s].radius;
+				}
+			}
+		}
+
+		start = ReadTimer();
+		for (i = 0; i < count; i++)
+			for (r = 0; r < MAX_ROBOTS; r++)
+				for (s = 0; s < NUM_RADARS; s++) {
+					trial = &block[i];
+					for (hit = 0, o = 0; o < MAX_ROBOTS && !hit; o++)
+						hit = o != r && MasksCollide(&trial->robotMasks[o],
+								trial->robX[o], trial->robY[o],
+								&trial->radarMasks[r][s], trial->sensX[r][s],
+								trial->sensY[r][s]);
+					trial->bitmask[r][s] = hit;
+				}
+		radarBitmask.newNs += ReadTimer() - start;
+
+		start = ReadTimer();
+		for (i = 0; i < count; i++)
+			for (r = 0; r < MAX_ROBOTS; r++)
+				for (s = 0; s < NUM_RADARS; s++) {
+					trial = &block[i];
+					for (hit = 0, o = 0; o < MAX_ROBOTS && !hit; o++)
+						hit = o != r && RadarSees(&trial->sectors[r][s],
+								trial->cx[o], trial->cy[o]);
+					trial->analytic[r][s] = hit;
+				}
+		radarAnalytic.newNs += ReadTimer() - start;
+
+		start = ReadTimer();
+		for (i = 0; i < count; i++)
+			for (r = 0; r < MAX_ROBOTS; r++)
+				for (s = NUM_RADARS; s < MAX_SENSORS; s++) {
+					trial = &block[i];
+					distance = RangeToHit(trial, r, s);
+					trial->analytic[r][s] = distance < 0 ? trial->range[r][s] :
+							(int) (distance / PX_PER_CM);
+				}
+		rangeAnalytic.newNs += ReadTimer() - start;
+
+		for (i = 0; i < count; i++)
+			for (r = 0; r < MAX_ROBOTS; r++) {
+				trial = &block[i];
+				for (s = 0; s < NUM_RADARS; s++) {
+					margin = -1;       //Nearest other shield to the arc edge.
+					for (o = 0; o < MAX_ROBOTS; o++)
+						if (o != r) {
+							distance = fabs(SectorDistance(&trial->sectors[r][s],
+									trial->cx[o], trial->cy[o]) - SHIELD_RAD_PX);
+							if (margin < 0 || distance < margin)
+								margin = distance;
+						}
+					example = Tally(&radarBitmask, trial->reference[r][s],
+							trial->bitmask[r][s],
+							trial->reference[r][s] == trial->bitmask[r][s],
+							margin);
+					if (example != NULL)
+						sprintf(example, "%s: reference %d",
+								trial->pose[r][s], trial->reference[r][s]);
+					example = Tally(&radarAnalytic, trial->reference[r][s],
+							trial->analytic[r][s],
+							trial->reference[r][s] == trial->analytic[r][s],
+							margin);
+					if (example != NULL)
+						sprintf(example, "%s: reference %d",
+								trial->pose[r][s], trial->reference[r][s]);
+				}
+
+				for (s = NUM_RADARS; s < MAX_SENSORS; s++) {
+					error = abs(trial->analytic[r][s] - trial->reference[r][s]);
+					if (error > rangeAnalytic.maxError)
+						rangeAnalytic.maxError = error;
+					example = Tally(&rangeAnalytic,
+							trial->reference[r][s] < trial->range[r][s],
+							trial->analytic[r][s] < trial->range[r][s],
+							error <= RANGE_TOLERANCE_CM, RangeMargin(trial, r, s));
+					if (example != NULL)
+						sprintf(example, "%s: reference %d cm, analytic %d cm",
+								trial->pose[r][s], trial->reference[r][s],
+								trial->analytic[r][s]);
+				}
+			}
+	}
+	radarAnalytic.refNs = radarBitmask.refNs;
+
+	for (i = 0; i < BLOCK; i++)
+		for (r = 0; r < MAX_ROBOTS; r++) {
+			free(block[i].robotMasks[r].bits);
+			for (s = 0; s < NUM_RADARS; s++)
+				free(block[i].radarMasks[r][s].bits);
+		}
+	free(block);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SetSensorsOn
+//
+// Description: This function turns every sensor of one type on or off.
+//
+// Parameters: SENSORTYPE type - The type.
+//             int on - 1 for on, 0 for off.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void SetSensorsOn(SENSORTYPE type, int on) {
+	int r, s;
+
+	for (r = 0; r < MAX_ROBOTS; r++)
+		for (s = 0; s < MAX_SENSORS; s++)
+			if (robotArray[r]->sensorArray[s].type == type)
+				robotArray[r]->sensorArray[s].on = on;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Tally
+//
+// Description: This function counts one query for a kernel.
+//
+// Parameters: KERNEL_STATS *stats - The kernel.
+//             int reference - 1 if the reference saw something, else 0.
+//             int candidate - The same for the kernel.
+//             int same - 1 if the answers agree.
+//             double margin - How far the shapes are from touching, in
+//                             pixels, or <0 if not known.
+//
+// Returns: char* - Somewhere to describe the query if it was a mismatch and
+//                  there is still room for examples, otherwise NULL.
+//
+////////////////////////////////////////////////////////////////////////////////
+static char *Tally(KERNEL_STATS *stats, int reference, int candidate,
+		int same, double margin) {
+	stats->queries++;
+	if (same)
+		return NULL;
+	stats->mismatches++;
+	if (candidate && !reference)
+		stats->falseHits++;
+	else if (reference && !candidate)
+		stats->misses++;
+	if (margin >= 0 && margin <= EDGE_PX)
+		stats->nearEdge++;
+	if (stats->numExamples == MAX_EXAMPLES)
+		return NULL;
+	return stats->examples[stats->numExamples++];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: PrintStats / PrintExamples
+//
+// Description: These functions print a kernel's line of the table and its
+//              mismatches.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void PrintStats(KERNEL_STATS *stats) {
+	double refNs = stats->refNs / stats->queries;
+	double newNs = stats->newNs / stats->queries;
+
+	printf("%-17s %9lld %9lld %7.3f%% %7lld %7lld %9lld %8.0f %8.1f %7.1fx\n",
+			stats->name, stats->queries, stats->mismatches,
+			100.0 * stats->mismatches / stats->queries, stats->falseHits,
+			stats->misses, stats->nearEdge, refNs, newNs,
+			newNs > 0 ? refNs / newNs : 0);
+}
+
+static void PrintExamples(KERNEL_STATS *stats) {
+	int i;
+
+	if (stats->numExamples > 0)
+		printf("\n%s mismatches:\n", stats->name);
+	for (i = 0; i < stats->numExamples; i++)
+		printf("    %s\n", stats->examples[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: AllocMask / BuildMask
+//
+// Description: These functions make a mask big enough for an image, and fill
+//              it from the image's solid (not COLOR_TRANS) pixels.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void AllocMask(MASK *mask, int w, int h) {
+	mask->stride = (w + 63) / 64 + 1;
+	mask->bits = calloc(mask->stride * h, sizeof(uint64_t));
+	if (mask->bits == NULL)
+		AbortOnError("AllocMask() could not allocate a mask.\n"
+				"Program will end.");
+}
+
+static void BuildMask(MASK *mask, BITMAP *image) {
+	int transClr = COLOR_TRANS;
+	uint64_t *row;
+	int x, y;
+
+	mask->w = image->w;
+	mask->h = image->h;
+	memset(mask->bits, 0, mask->stride * image->h * sizeof(uint64_t));
+	for (y = 0; y < image->h; y++) {
+		row = mask->bits + y * mask->stride;
+		for (x = 0; x < image->w; x++)
+			if (getpixel(image, x, y) != transClr)
+				row[x >> 6] |= (uint64_t) 1 << (x & 63);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: MasksCollide
+//
+// Description: This is the bitmask kernel, the equivalent of ImagesCollide()
+//              on masks.  Over the rows the images share, 64 columns of each
+//              are lined up with a shift and ANDed at a time.
+//
+// Parameters: MASK *a - The first mask.
+//             int xA, yA - The top left pixel of the first image.
+//             MASK *b, int xB, yB - The same for the second.
+//
+// Returns: int - 1 if any solid pixels overlap, otherwise 0.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int MasksCollide(MASK *a, int xA, int yA, MASK *b, int xB, int yB) {
+	int x1 = xA > xB ? xA : xB, x2 = xA + a->w < xB + b->w ? xA + a->w :
+			xB + b->w;
+	int y1 = yA > yB ? yA : yB, y2 = yA + a->h < yB + b->h ? yA + a->h :
+			yB + b->h;
+	int x, y, n, startA, startB;
+	uint64_t *rowA, *rowB, bitsA, bitsB, keep;
+
+	if (x1 >= x2 || y1 >= y2)          //Bounding boxes don't overlap.
+		return 0;
+	for (y = y1; y < y2; y++) {
+		rowA = a->bits + (y - yA) * a->stride;
+		rowB = b->bits + (y - yB) * b->stride;
+		for (x = x1; x < x2; x += 64) {
+			startA = x - xA;
+			startB = x - xB;
+			bitsA = rowA[startA >> 6] >> (startA & 63);
+			if (startA & 63)
+				bitsA |= rowA[(startA >> 6) + 1] << (64 - (startA & 63));
+			bitsB = rowB[startB >> 6] >> (startB & 63);
+			if (startB & 63)
+				bitsB |= rowB[(startB >> 6) + 1] << (64 - (startB & 63));
+			n = x2 - x;
+			keep = n >= 64 ? ~(uint64_t) 0 : ((uint64_t) 1 << n) - 1;
+			if (bitsA & bitsB & keep)
+				return 1;
+		}
+	}
+	return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CirclesCollide
+//
+// Description: This is the geometric weapon kernel.
+//
+// Parameters: double x1, y1, r1 - The first circle.
+//             double x2, y2, r2 - The second.
+//
+// Returns: int - 1 if they touch, otherwise 0.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CirclesCollide(double x1, double y1, double r1, double x2,
+		double y2, double r2) {
+	double dx = x1 - x2, dy = y1 - y2;
+
+	return dx * dx + dy * dy <= (r1 + r2) * (r1 + r2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: SectorDistance / RadarSees
+//
+// Description: These are the analytic radar kernel.  SectorDistance() is how
+//              far a point is from a radar's arc (0 inside it), and a radar
+//              sees a robot if that is within the shield's radius.  The arc
+//              runs anticlockwise from the trailing edge to the leading edge
+//              and is never wider than MAX_RADAR_ARC.
+//
+// Parameters: SECTOR *sector - The arc.
+//             double x, y - The point (a robot's centre), in arena pixels
+//                           with y up.
+//
+// Returns: double - The distance, or for RadarSees() 1 if the robot is seen.
+//
+////////////////////////////////////////////////////////////////////////////////
+static double SectorDistance(SECTOR *sector, double x, double y) {
+	double vx = x - sector->x, vy = y - sector->y, length, t, toStart, toEnd;
+
+	if (sector->endX * vy - sector->endY * vx >= 0
+			&& vx * sector->startY - vy * sector->startX >= 0) {
+		length = sqrt(vx * vx + vy * vy);        //Between the edges.
+		return length > sector->radius ? length - sector->radius : 0;
+	}
+
+	t = (vx * sector->startX + vy * sector->startY)      //Otherwise, to the
+			/ (sector->radius * sector->radius);         //nearer edge.
+	t = t < 0 ? 0 : t > 1 ? 1 : t;
+	toStart = hypot(vx - t * sector->startX, vy - t * sector->startY);
+	t = (vx * sector->endX + vy * sector->endY)
+			/ (sector->radius * sector->radius);
+	t = t < 0 ? 0 : t > 1 ? 1 : t;
+	toEnd = hypot(vx - t * sector->endX, vy - t * sector->endY);
+	return toStart < toEnd ? toStart : toEnd;
+}
+
+static int RadarSees(SECTOR *sector, double x, double y) {
+	double vx = x - sector->x, vy = y - sector->y;
+	double reach = sector->radius + SHIELD_RAD_PX;
+
+	if (vx * vx + vy * vy > reach * reach)             //Out of range.
+		return 0;
+	return SectorDistance(sector, x, y) <= SHIELD_RAD_PX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RangeToHit
+//
+// Description: This is the analytic range sensor kernel.  It follows the
+//              same line as UpdateSensorRange() gives do_line() and finds the
+//              nearest point where it meets another robot's shield circle or
+//              leaves the arena.  A line that starts inside another shield
+//              (the robots are crossing shields) hits it on the way out, as
+//              inside the ring the image is clear.
+//
+// Parameters: SENSOR_TRIAL *trial - The trial.
+//             int robot - The robot the sensor is on.
+//             int port - The sensor.
+//
+// Returns: double - The distance to the hit, in pixels, or -1 if the line
+//                   reaches its end without one.
+//
+////////////////////////////////////////////////////////////////////////////////
+static double RangeToHit(SENSOR_TRIAL *trial, int robot, int port) {
+	double x = trial->lineX1[robot][port], y = trial->lineY1[robot][port];
+	double dx = trial->lineX2[robot][port] - x;
+	double dy = trial->lineY2[robot][port] - y;
+	double length = sqrt(dx * dx + dy * dy), best, wall, hit;
+	double cx, cy, along, across, radius2 = SHIELD_RAD_PX * SHIELD_RAD_PX;
+	int o;
+
+	if (length == 0)
+		return -1;
+	dx /= length;
+	dy /= length;
+	best = length + 1;
+
+	if (dx < 0 && (wall = (x + 1) / -dx) < best)           //The first pixel
+		best = wall;                                       //off the arena.
+	else if (dx > 0 && (wall = (ARENA_WIDTH_PX - x) / dx) < best)
+		best = wall;
+	if (dy < 0 && (wall = (y + 1) / -dy) < best)
+		best = wall;
+	else if (dy > 0 && (wall = (ARENA_HEIGHT_PX - y) / dy) < best)
+		best = wall;
+
+	for (o = 0; o < MAX_ROBOTS; o++) {            //Screen pixels, y down.
+		if (o == robot)
+			continue;
+		cx = trial->robX[o] + SHIELD_BMP_SZ / 2 - x;
+		cy = trial->robY[o] + SHIELD_BMP_SZ / 2 - y;
+		along = cx * dx + cy * dy;
+		across = cx * cx + cy * cy - along * along;
+		if (across > radius2)                           //Passes by.
+			continue;
+		if (cx * cx + cy * cy <= radius2)               //Starts inside it.
+			hit = along + sqrt(radius2 - across);
+		else if (along > 0)
+			hit = along - sqrt(radius2 - across);
+		else
+			continue;                                   //Behind.
+		if (hit < best)
+			best = hit;
+	}
+	return best <= length ? best : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RangeMargin
+//
+// Description: This function finds how close a range sensor's line comes to
+//              grazing another robot's shield, for deciding whether a
+//              mismatch is an edge case.
+//
+// Parameters: As for RangeToHit().
+//
+// Returns: double - The distance, in pixels, or a large number if the line
+//                   points away from every other robot.
+//
+////////////////////////////////////////////////////////////////////////////////
+static double RangeMargin(SENSOR_TRIAL *trial, int robot, int port) {
+	double x = trial->lineX1[robot][port], y = trial->lineY1[robot][port];
+	double dx = trial->lineX2[robot][port] - x;
+	double dy = trial->lineY2[robot][port] - y;
+	double length = sqrt(dx * dx + dy * dy), margin = ARENA_WIDTH_PX;
+	double cx, cy, along, across;
+	int o;
+
+	if (length == 0)
+		return margin;
+	for (o = 0; o < MAX_ROBOTS; o++)
+		if (o != robot) {
+			cx = trial->robX[o] + SHIELD_BMP_SZ / 2 - x;
+			cy = trial->robY[o] + SHIELD_BMP_SZ / 2 - y;
+			along = (cx * dx + cy * dy) / length;
+			if (along <= 0)
+				continue;
+			across = sqrt(fabs(cx * cx + cy * cy - along * along));
+			if (fabs(across - SHIELD_RAD_PX) < margin)
+				margin = fabs(across - SHIELD_RAD_PX);
+		}
+	return margin;
+}
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: scalebench.c
+//
+// Description: This tool measures how a whole calculation scales with the
+//              number of robots, weapons in flight and live particles:
+//
+//                  scalebench [--robots list] [--weapons list]
+//                             [--particles list] [--sensors list]
+//                             [--ticks n] [--budget seconds] [--workers n]
+//                             [--seed n]
+//
+//              eg: scalebench --robots 4,16,64,256,1000
+//                  scalebench --robots 32 --weapons 0,100,1000,10000
+//                  scalebench --robots 32 --particles 0,10000,100000,1000000
+//
+//              Each list is comma separated, and every combination of them
+//              is a configuration.  For each configuration a canned arena is
+//              built (see arena.h) and whole calculations (every stage, in
+//              RunCalculation() order, headless) are timed.  The arena is put
+//              back as it was built before each calculation, so every one
+//              has the same load.  A configuration runs --ticks calculations,
+//              or fewer (but at least MIN_TICKS) once --budget seconds have
+//              gone by, so the biggest arenas don't take all day.
+//
+//              Results are CSV, one line per configuration, ready to plot:
+//              the median and 99th percentile calculation time, calculations
+//              a second (from the median), the resident memory with the
+//              arena built and the peak so far, and the median time of each
+//              stage.  A stage whose time grows with the square of its
+//              entities (eg: CheckRobotCollisions(), or the splash damage
+//              loop in CheckWeaponCollisions()) shows up as a curve that
+//              bends upwards.  The peak memory is over the whole run, so put
+//              lists in increasing order.  Run it from the game's directory,
+//              as it loads the game's images.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - END_OF_MAIN(), so it links with Allegro on
+//                                Windows.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "competition.h"
+#include "jobs.h"
+#include "timing.h"
+#include "arena.h"
+
+#define DEFAULT_ROBOTS     "4,8,16,32,64,128,256,512,1000"
+#define DEFAULT_WEAPONS    "0"
+#define DEFAULT_PARTICLES  "0"
+#define DEFAULT_SENSORS    "radar,radar,range,range"
+#define DEFAULT_TICKS      50
+#define DEFAULT_BUDGET     10          //Seconds for each configuration.
+#define MIN_TICKS          3
+#define MAX_SWEEP          32          //Values in each list.
+
+typedef struct {
+	int values[MAX_SWEEP];
+	int count;
+} SWEEP;
+
+//Internal helper prototypes
+static void RunConfiguration(ARENA_SPEC *spec, int ticks, long long budget,
+		int workers);
+static long long Median(long long *samples, int count);
+static int ParseSweep(SWEEP *sweep, char *list);
+static int CompareSamples(const void *a, const void *b);
+static int Usage(void);
+
+int main(int argc, char *argv[]) {
+	SWEEP robots, weapons, particles;
+	ARENA_SPEC spec;
+	int i, r, w, p, ticks = DEFAULT_TICKS, workers = NUM_JOB_WORKERS;
+	double budget = DEFAULT_BUDGET;
+
+	memset(&spec, 0, sizeof(spec));
+	spec.seed = 1;
+	ParseSweep(&robots, DEFAULT_ROBOTS);
+	ParseSweep(&weapons, DEFAULT_WEAPONS);
+	ParseSweep(&particles, DEFAULT_PARTICLES);
+	ParseSensors(&spec, DEFAULT_SENSORS);
+	for (i = 1; i < argc; i++) {
+		if (i + 1 == argc)
+			return Usage();
+		else if (strcmp(argv[i], "--robots") == 0) {
+			if (!ParseSweep(&robots, argv[++i]))
+				return Usage();
+		} else if (strcmp(argv[i], "--weapons") == 0) {
+			if (!ParseSweep(&weapons, argv[++i]))
+				return Usage();
+		} else if (strcmp(argv[i], "--particles") == 0) {
+			if (!ParseSweep(&particles, argv[++i]))
+				return Usage();
+		} else if (strcmp(argv[i], "--sensors") == 0) {
+			if (!ParseSensors(&spec, argv[++i]))
+				return Usage();
+		} else if (strcmp(argv[i], "--ticks") == 0)
+			ticks = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--budget") == 0)
+			budget = atof(argv[++i]);
+		else if (strcmp(argv[i], "--workers") == 0)
+			workers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			spec.seed = strtoul(argv[++i], NULL, 10);
+		else
+			return Usage();
+	}
+	for (i = 0; i < robots.count; i++)
+		if (robots.values[i] == 0)
+			return Usage();
+	if (ticks < MIN_TICKS || budget <= 0 || workers < 0 || spec.seed == 0)
+		return Usage();
+
+	SetHeadless();
+	InitCompetition();
+	if (workers != NUM_JOB_WORKERS) {
+		DeInitJobSystem();
+		InitJobSystem(workers);
+	}
+
+	printf("robots,sensors,weapons,particles,workers,ticks,tick_median_ns,"
+			"tick_p99_ns,ticks_per_sec,rss_kb,peak_rss_kb");
+	for (i = 0; i < NUM_ARENA_STAGES; i++)
+		printf(",%s_ns", GetStageName(i));
+	printf("\n");
+	for (r = 0; r < robots.count; r++)
+		for (w = 0; w < weapons.count; w++)
+			for (p = 0; p < particles.count; p++) {
+				spec.numRobots = robots.values[r];
+				spec.numWeapons = weapons.values[w];
+				spec.numParticles = particles.values[p];
+				RunConfiguration(&spec, ticks, budget * 1e9, workers);
+			}
+
+	EndCompetition();
+	return 0;
+}
+END_OF_MAIN()          //Macro required for Allegro graphics library in Windows.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: RunConfiguration
+//
+// Description: This function builds an arena, times calculations on it and
+//              writes its CSV line.
+//
+// Parameters: ARENA_SPEC *spec - The arena.
+//             int ticks - The most calculations to time.
+//             long long budget - Nanoseconds after which to stop early.
+//             int workers - The job workers, for the CSV line.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void RunConfiguration(ARENA_SPEC *spec, int ticks, long long budget,
+		int workers) {
+	ARENA arena;
+	long long *tickTimes, *stageTimes[NUM_ARENA_STAGES];
+	long long start, stageStart, finish, median, resident, peak;
+	int stage, done;
+
+	tickTimes = malloc((NUM_ARENA_STAGES + 1) * ticks * sizeof(long long));
+	if (tickTimes == NULL)
+		AbortOnError("RunConfiguration() could not allocate the samples.\n"
+				"Program will end.");
+	for (stage = 0; stage < NUM_ARENA_STAGES; stage++)
+		stageTimes[stage] = tickTimes + (stage + 1) * ticks;
+
+	BuildArena(&arena, spec);
+	start = ReadTimer();
+	for (done = 0; done < ticks; done++) {
+		if (done >= MIN_TICKS && ReadTimer() - start > budget)
+			break;
+		ResetArena(&arena);
+		finish = ReadTimer();
+		for (stage = 0; stage < NUM_ARENA_STAGES; stage++) {
+			stageStart = finish;
+			RunStage(&arena, stage);
+			finish = ReadTimer();
+			stageTimes[stage][done] = finish - stageStart;
+		}
+		tickTimes[done] = 0;
+		for (stage = 0; stage < NUM_ARENA_STAGES; stage++)
+			tickTimes[done] += stageTimes[stage][done];
+	}
+	ReadMemoryUse(&resident, &peak);
+
+	median = Median(tickTimes, done);
+	printf("%d,%d,%d,%d,%d,%d,%lld,%lld,%.2f,%lld,%lld", spec->numRobots,
+			spec->numSensors, spec->numWeapons, spec->numParticles, workers,
+			done, median, tickTimes[(done * 99 + 99) / 100 - 1],
+			median > 0 ? 1e9 / median : 0, resident / 1024, peak / 1024);
+	for (stage = 0; stage < NUM_ARENA_STAGES; stage++)
+		printf(",%lld", Median(stageTimes[stage], done));
+	printf("\n");
+	fflush(stdout);
+
+	FreeArena(&arena);
+	free(tickTimes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Median
+//
+// Description: This function sorts times and finds their median.
+//
+// Parameters: long long *samples - The times.  They are sorted.
+//             int count - How many.
+//
+// Returns: long long - The median.
+//
+////////////////////////////////////////////////////////////////////////////////
+static long long Median(long long *samples, int count) {
+	qsort(samples, count, sizeof(long long), CompareSamples);
+	return samples[(count - 1) / 2];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: ParseSweep
+//
+// Description: This function reads a comma separated list of counts.
+//
+// Parameters: SWEEP *sweep - Filled in.
+//             char *list - The list, eg: "4,16,64".
+//
+// Returns: int - 1 if successful, 0 if the list is wrong.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int ParseSweep(SWEEP *sweep, char *list) {
+	char *end;
+	long value;
+
+	sweep->count = 0;
+	do {
+		value = strtol(list, &end, 10);
+		if (end == list || value < 0 || sweep->count == MAX_SWEEP
+				|| (*end != ',' && *end != '\0'))
+			return 0;
+		sweep->values[sweep->count++] = value;
+		list = end + 1;
+	} while (*end == ',');
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CompareSamples
+//
+// Description: This function orders times for qsort().
+//
+// Parameters: const void *a, *b - The times.
+//
+// Returns: int - <0, 0 or >0 as a is less, the same or more than b.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CompareSamples(const void *a, const void *b) {
+	long long first = *(const long long *) a, second = *(const long long *) b;
+
+	return (first > second) - (first < second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Usage
+//
+// Description: This function explains the command line.
+//
+// Parameters: None.
+//
+// Returns: int - The exit status for a bad command line.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int Usage(void) {
+	fprintf(stderr, "usage: scalebench [--robots list] [--weapons list] "
+			"[--particles list]\n"
+			"                  [--sensors list] [--ticks n] "
+			"[--budget seconds] [--workers n]\n"
+			"                  [--seed n]\n"
+			"       the counts are comma separated, eg: %s, and robots must "
+			"be more than 0\n"
+			"       sensors are up to %d of radar and range, eg: %s\n"
+			"       --ticks must be at least %d\n", DEFAULT_ROBOTS,
+			MAX_SENSORS, DEFAULT_SENSORS, MIN_TICKS);
+	return 2;
+}
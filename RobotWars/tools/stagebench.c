@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// File: stagebench.c
+//
+// Description: This tool times each stage of a calculation (see
+//              RunCalculation() in competition.c) on its own, on a canned
+//              arena (see arena.h):
+//
+//                  stagebench [--robots n] [--sensors list] [--weapons n]
+//                             [--particles n] [--iterations n]
+//                             [--workers n] [--seed n] [--render]
+//
+//              eg: stagebench --robots 40 --sensors radar,radar,range
+//                             --weapons 200 --particles 5000
+//
+//              The arena is put back as it was built before every call, so
+//              each call does the same work, and only the call is timed.
+//              Once every stage has been timed the calls are sorted and the
+//              median and 99th percentile written as CSV, one line per
+//              stage, both per call and per entity the stage works on:
+//
+//                  robots     UpdateEnergySystems, MoveRobots,
+//                             DrawRobotBitmaps, CheckRobotCollisions,
+//                             ApplyDamage
+//                  weapons    MoveWeapons, CheckWeaponCollisions
+//                  sensors    DrawSensorBitmaps, UpdateSensorData (every
+//                             robot's)
+//                  particles  UpdateParticles
+//                  all three  RenderScene
+//
+//              RenderScene() needs a window, so it is only timed with
+//              --render; without it the game is headless as in RunMatch().
+//              The stages run on --workers job workers as in a match
+//              (NUM_JOB_WORKERS unless given).  Run it from the game's
+//              directory, as it loads the game's images.
+//
+// Revision History: 18 Oct 2026 - Created
+//                  18 Oct 2026 - END_OF_MAIN(), so it links with Allegro on
+//                                Windows.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "competition.h"
+#include "graphics.h"
+#include "jobs.h"
+#include "timing.h"
+#include "arena.h"
+
+#define DEFAULT_ROBOTS       MAX_ROBOTS
+#define DEFAULT_SENSORS      "radar,radar,range,range"
+#define DEFAULT_WEAPONS      20
+#define DEFAULT_PARTICLES    1000
+#define DEFAULT_ITERATIONS   1000
+#define RENDER_STAGE         NUM_ARENA_STAGES   //After the physics stages.
+
+typedef enum {
+	ENTITY_ROBOTS, ENTITY_WEAPONS, ENTITY_SENSORS, ENTITY_PARTICLES,
+	ENTITY_ALL
+} ENTITY;
+
+//Internal helper prototypes
+static void TimeStage(ARENA *arena, int stage, long long *samples,
+		int iterations, int workers);
+static int CountEntities(ARENA_SPEC *spec, ENTITY entity);
+static int CompareSamples(const void *a, const void *b);
+static int Usage(void);
+
+static ENTITY stageEntities[NUM_ARENA_STAGES + 1] = {  //By stage.
+	ENTITY_ROBOTS, ENTITY_ROBOTS, ENTITY_ROBOTS, ENTITY_ROBOTS,
+	ENTITY_WEAPONS, ENTITY_WEAPONS, ENTITY_ROBOTS, ENTITY_SENSORS,
+	ENTITY_SENSORS, ENTITY_PARTICLES, ENTITY_ALL
+};
+
+int main(int argc, char *argv[]) {
+	ARENA_SPEC spec;
+	ARENA arena;
+	long long *samples;
+	int i, iterations = DEFAULT_ITERATIONS, workers = NUM_JOB_WORKERS;
+	int render = 0;
+
+	memset(&spec, 0, sizeof(spec));
+	spec.numRobots = DEFAULT_ROBOTS;
+	spec.numWeapons = DEFAULT_WEAPONS;
+	spec.numParticles = DEFAULT_PARTICLES;
+	spec.seed = 1;
+	ParseSensors(&spec, DEFAULT_SENSORS);
+	for (i = 1; i < argc; i++) {
+		if (strcmp(argv[i], "--render") == 0)
+			render = 1;
+		else if (i + 1 == argc)
+			return Usage();
+		else if (strcmp(argv[i], "--robots") == 0)
+			spec.numRobots = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--sensors") == 0) {
+			if (!ParseSensors(&spec, argv[++i]))
+				return Usage();
+		} else if (strcmp(argv[i], "--weapons") == 0)
+			spec.numWeapons = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--particles") == 0)
+			spec.numParticles = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--iterations") == 0)
+			iterations = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--workers") == 0)
+			workers = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			spec.seed = strtoul(argv[++i], NULL, 10);
+		else
+			return Usage();
+	}
+	if (spec.numRobots <= 0 || spec.numWeapons < 0 || spec.numParticles < 0
+			|| iterations <= 0 || workers < 0 || spec.seed == 0)
+		return Usage();
+
+	samples = malloc(iterations * sizeof(long long));
+	if (samples == NULL) {
+		fprintf(stderr, "stagebench: too many iterations.\n");
+		return 2;
+	}
+	if (!render)
+		SetHeadless();
+	InitCompetition();
+	if (workers != NUM_JOB_WORKERS) {
+		DeInitJobSystem();
+		InitJobSystem(workers);
+	}
+	BuildArena(&arena, &spec);
+
+	printf("stage,robots,sensors,weapons,particles,workers,iterations,"
+			"entities,median_ns,p99_ns,median_ns_per_entity,"
+			"p99_ns_per_entity\n");
+	for (i = 0; i < NUM_ARENA_STAGES; i++)
+		TimeStage(&arena, i, samples, iterations, workers);
+	if (render)
+		TimeStage(&arena, RENDER_STAGE, samples, iterations, workers);
+
+	FreeArena(&arena);
+	EndCompetition();
+	free(samples);
+	return 0;
+}
+END_OF_MAIN()          //Macro required for Allegro graphics library in Windows.
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: TimeStage
+//
+// Description: This function times a stage and writes its CSV line.
+//
+// Parameters: ARENA *arena - The arena, reset before every call.
+//             int stage - An ARENA_STAGE, or RENDER_STAGE.
+//             long long *samples - Room for a time for each call.
+//             int iterations - How many calls.
+//             int workers - The job workers, for the CSV line.
+//
+// Returns: Nothing.
+//
+////////////////////////////////////////////////////////////////////////////////
+static void TimeStage(ARENA *arena, int stage, long long *samples,
+		int iterations, int workers) {
+	ARENA_SPEC *spec = &arena->spec;
+	long long start, median, p99;
+	int i, entities;
+
+	for (i = 0; i < iterations; i++) {
+		ResetArena(arena);
+		start = ReadTimer();
+		if (stage == RENDER_STAGE)
+			RenderScene(arena->robots, arena->deadRobots, arena->weapons, "");
+		else
+			RunStage(arena, stage);
+		samples[i] = ReadTimer() - start;
+	}
+	qsort(samples, iterations, sizeof(long long), CompareSamples);
+	median = samples[(iterations - 1) / 2];
+	p99 = samples[(iterations * 99 + 99) / 100 - 1];  //Nearest rank.
+
+	entities = CountEntities(spec, stageEntities[stage]);
+	printf("%s,%d,%d,%d,%d,%d,%d,%d,%lld,%lld",
+			stage == RENDER_STAGE ? "RenderScene" : GetStageName(stage),
+			spec->numRobots, spec->numSensors, spec->numWeapons,
+			spec->numParticles, workers, iterations, entities, median, p99);
+	if (entities > 0)
+		printf(",%.2f,%.2f\n", (double) median / entities,
+				(double) p99 / entities);
+	else
+		printf(",,\n");                    //Nothing to divide by.
+	fflush(stdout);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CountEntities
+//
+// Description: This function counts the entities a stage works on.
+//
+// Parameters: ARENA_SPEC *spec - The arena.
+//             ENTITY entity - Which.
+//
+// Returns: int - How many.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CountEntities(ARENA_SPEC *spec, ENTITY entity) {
+	switch (entity) {
+	case ENTITY_ROBOTS:
+		return spec->numRobots;
+	case ENTITY_WEAPONS:
+		return spec->numWeapons;
+	case ENTITY_SENSORS:
+		return spec->numRobots * spec->numSensors;
+	case ENTITY_PARTICLES:
+		return spec->numParticles;
+	default:
+		return spec->numRobots + spec->numWeapons + spec->numParticles;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: CompareSamples
+//
+// Description: This function orders times for qsort().
+//
+// Parameters: const void *a, *b - The times.
+//
+// Returns: int - <0, 0 or >0 as a is less, the same or more than b.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int CompareSamples(const void *a, const void *b) {
+	long long first = *(const long long *) a, second = *(const long long *) b;
+
+	return (first > second) - (first < second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Function: Usage
+//
+// Description: This function explains the command line.
+//
+// Parameters: None.
+//
+// Returns: int - The exit status for a bad command line.
+//
+////////////////////////////////////////////////////////////////////////////////
+static int Usage(void) {
+	fprintf(stderr, "usage: stagebench [--robots n] [--sensors list] "
+			"[--weapons n] [--particles n]\n"
+			"                  [--iterations n] [--workers n] [--seed n] "
+			"[--render]\n"
+			"       list is up to %d of radar and range, comma separated, "
+			"eg: %s\n", MAX_SENSORS, DEFAULT_SENSORS);
+	return 2;
+}